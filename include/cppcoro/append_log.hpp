@@ -0,0 +1,119 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_APPEND_LOG_HPP_INCLUDED
+#define CPPCORO_APPEND_LOG_HPP_INCLUDED
+
+#include <cppcoro/write_only_file.hpp>
+#include <cppcoro/task.hpp>
+#include <cppcoro/filesystem.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace cppcoro
+{
+	class io_service;
+
+	/// \brief
+	/// A durable, append-only log that uses group commit.
+	///
+	/// Concurrent calls to append() are gathered into batches. Each batch is
+	/// written to the file with a single gathering write straight from the
+	/// appenders' buffers (one write per record on Windows), followed by a
+	/// single writable_file::sync_data(), after which every append in the
+	/// batch is resumed.
+	/// Appends that arrive while a batch is being written are queued up and
+	/// form the next batch, so the cost of making the data durable is shared
+	/// between all of the writers in a batch rather than paid by each one.
+	///
+	/// The first writer to arrive when no batch is in progress becomes the
+	/// leader and writes the batch. Once the batch is durable, leadership is
+	/// handed to the first writer queued behind it.
+	class append_log
+	{
+	public:
+
+		/// Open a log segment for appending.
+		///
+		/// \param ioService
+		/// The I/O service used to dispatch completion of writes to the log.
+		///
+		/// \param path
+		/// Path of the log segment. It is created if it does not exist.
+		///
+		/// \param writeOffset
+		/// The offset at which to append the first record. Use this when
+		/// reopening an existing segment to continue after the last valid record.
+		///
+		/// \param preallocateSize
+		/// If larger than the current size of the segment then the segment is
+		/// extended to this size up-front using writable_file::set_size() so
+		/// that appends do not need to grow the file.
+		///
+		/// \throw std::system_error
+		/// If the file could not be opened or preallocated.
+		[[nodiscard]]
+		static append_log open(
+			io_service& ioService,
+			const cppcoro::filesystem::path& path,
+			std::uint64_t writeOffset = 0,
+			std::uint64_t preallocateSize = 0);
+
+		append_log(const append_log&) = delete;
+		append_log& operator=(const append_log&) = delete;
+
+		/// The log must not be destroyed while there are appends outstanding.
+		~append_log();
+
+		/// Append a record to the log.
+		///
+		/// \param data
+		/// Pointer to the record contents. Must remain valid until the returned
+		/// task completes.
+		///
+		/// \param size
+		/// Size of the record in bytes.
+		///
+		/// \return
+		/// A task that completes once the record is durable, producing the
+		/// offset in the file at which the record was written.
+		/// If the write for the batch containing this record fails then all of
+		/// the appends in that batch complete with the exception.
+		[[nodiscard]]
+		task<std::uint64_t> append(const void* data, std::size_t size);
+
+		/// The offset at which the next batch will be written.
+		///
+		/// Once all outstanding appends have completed this is the end of the
+		/// durable contents of the log.
+		std::uint64_t write_offset() const;
+
+	private:
+
+		struct append_waiter;
+
+		append_log(write_only_file&& file, std::uint64_t writeOffset) noexcept;
+
+		task<> write_batch(append_waiter& leader);
+
+		write_only_file m_file;
+
+		mutable std::mutex m_mutex;
+
+		// Queue of appends waiting for the next batch. Protected by m_mutex.
+		append_waiter* m_queueHead;
+		append_waiter* m_queueTail;
+		bool m_batchInProgress;
+
+		// Only accessed by the current leader.
+		std::uint64_t m_writeOffset;
+		std::vector<file_write_buffer> m_batchBuffers;
+
+	};
+}
+
+#endif
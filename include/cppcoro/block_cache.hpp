@@ -0,0 +1,129 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_BLOCK_CACHE_HPP_INCLUDED
+#define CPPCORO_BLOCK_CACHE_HPP_INCLUDED
+
+#include <cppcoro/readable_file.hpp>
+#include <cppcoro/shared_task.hpp>
+#include <cppcoro/task.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace cppcoro
+{
+	/// \brief
+	/// A cache of fixed-size blocks of a readable_file.
+	///
+	/// Reads through the cache are served from cached blocks where possible
+	/// and otherwise read whole blocks from the file and cache them.
+	///
+	/// Concurrent reads that need the same uncached block share a single read
+	/// of that block from the file rather than each reading it themselves.
+	///
+	/// The cache is split into shards, each with its own lock, to reduce
+	/// contention between threads. Each shard evicts blocks using the CLOCK
+	/// algorithm, an approximation of LRU that doesn't need to reorder a list
+	/// on every hit.
+	///
+	/// The cache assumes the contents of the file do not change while it
+	/// is in use.
+	class block_cache
+	{
+	public:
+
+		struct statistics
+		{
+			/// Number of block lookups that found the block already loaded.
+			std::uint64_t hits;
+
+			/// Number of block lookups that had to read the block from the file.
+			std::uint64_t misses;
+
+			/// Number of block lookups that found the block being read for
+			/// another lookup and waited for that read instead of issuing one.
+			std::uint64_t coalesced;
+		};
+
+		/// Construct a cache for the specified file.
+		///
+		/// \param file
+		/// The file to cache. Must outlive the cache.
+		///
+		/// \param blockSize
+		/// The size of each block in bytes. If the file has been opened using
+		/// file_buffering_mode::unbuffered then this must be a multiple of
+		/// the file-system's sector size.
+		///
+		/// \param capacity
+		/// The maximum number of blocks to cache. This is divided evenly
+		/// between the shards, rounding up.
+		///
+		/// \param shardCount
+		/// The number of independently locked shards to split the cache into.
+		block_cache(
+			const readable_file& file,
+			std::size_t blockSize,
+			std::size_t capacity,
+			std::size_t shardCount = 16);
+
+		/// All reads through the cache must have completed before it is destroyed.
+		~block_cache();
+
+		block_cache(const block_cache&) = delete;
+		block_cache& operator=(const block_cache&) = delete;
+
+		/// Read some data from the file through the cache.
+		///
+		/// \param offset
+		/// The offset within the file to start reading from. Unlike
+		/// readable_file::read(), this need not be aligned for files opened
+		/// using file_buffering_mode::unbuffered.
+		///
+		/// \param buffer
+		/// The buffer to copy the data into.
+		///
+		/// \param byteCount
+		/// The number of bytes to read.
+		///
+		/// \return
+		/// A task that produces the number of bytes read. This is less than
+		/// \a byteCount only if the end of the file was reached.
+		///
+		/// \throw std::system_error
+		/// If reading a block from the file failed. All of the reads waiting
+		/// for that block fail and the block is not cached.
+		[[nodiscard]]
+		task<std::size_t> read(std::uint64_t offset, void* buffer, std::size_t byteCount);
+
+		/// The size of each block in bytes.
+		std::size_t block_size() const noexcept { return m_blockSize; }
+
+		/// Get a snapshot of the counters, summed over all shards.
+		statistics stats() const;
+
+	private:
+
+		struct block;
+		struct shard;
+
+		using block_ptr = std::shared_ptr<const block>;
+
+		shard& shard_for_block(std::uint64_t blockIndex) const noexcept;
+
+		task<block_ptr> get_block(std::uint64_t blockIndex);
+
+		shared_task<block_ptr> load_block(std::uint64_t blockIndex);
+
+		const readable_file& m_file;
+		const std::size_t m_blockSize;
+		const std::size_t m_shardCount;
+		std::unique_ptr<shard[]> m_shards;
+
+	};
+}
+
+#endif
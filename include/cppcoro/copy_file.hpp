@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_COPY_FILE_HPP_INCLUDED
+#define CPPCORO_COPY_FILE_HPP_INCLUDED
+
+#include <cppcoro/readable_file.hpp>
+#include <cppcoro/writable_file.hpp>
+#include <cppcoro/async_generator.hpp>
+#include <cppcoro/cancellation_token.hpp>
+#include <cppcoro/task.hpp>
+
+#include <cstdint>
+
+namespace cppcoro
+{
+	class io_service;
+	class static_thread_pool;
+
+	/// Copy a range of one file to the same range of another file.
+	///
+	/// The range is copied in chunks of at most 1MB. Cancellation is checked
+	/// before each chunk, so a cancelled copy leaves a prefix of the range
+	/// copied.
+	///
+	/// On Linux each chunk is copied with copy_file_range() so that the data
+	/// does not pass through a user-space buffer. The kernel may copy on the
+	/// storage server (NFS) or share the extents (reflink on btrfs and XFS)
+	/// instead of copying the data. Each chunk is a blocking call, so it is
+	/// made on a thread of \a blockingPool rather than tying up an I/O
+	/// thread, after which the copy resumes on \a ioService. If the files
+	/// don't support it, eg. because
+	/// they are on different file systems on an older kernel, the copy falls
+	/// back to reading each chunk into a buffer and writing it out.
+	/// On other platforms the buffered copy is always used.
+	///
+	/// \param ioService
+	/// The I/O service used to run the copy.
+	///
+	/// \param blockingPool
+	/// The thread pool on which to make the blocking copy_file_range() calls.
+	/// Unused on platforms without copy_file_range().
+	///
+	/// \param source
+	/// The file to copy from.
+	///
+	/// \param destination
+	/// The file to copy to. The destination is extended if the range extends
+	/// past its current end.
+	///
+	/// \param offset
+	/// The offset of the start of the range in both files.
+	/// If either file has been opened using file_buffering_mode::unbuffered
+	/// then the offset must be a multiple of the file-system's sector size.
+	///
+	/// \param length
+	/// The number of bytes to copy.
+	/// If the destination has been opened using file_buffering_mode::unbuffered
+	/// and the range ends before the end of the destination then the length
+	/// must be a multiple of the file-system's sector size. A range that
+	/// reaches the end of the destination can be any length.
+	///
+	/// \param ct
+	/// A cancellation token that can be used to stop the copy between chunks.
+	/// If cancellation is requested the copy completes with operation_cancelled.
+	///
+	/// \return
+	/// A task that produces the number of bytes copied. This is less than
+	/// \a length only if the end of \a source was reached first.
+	/// Both files must remain open until the task completes.
+	///
+	/// \throw std::system_error
+	/// If reading or writing one of the files failed.
+	[[nodiscard]]
+	task<std::uint64_t> copy_file(
+		io_service& ioService,
+		static_thread_pool& blockingPool,
+		readable_file& source,
+		writable_file& destination,
+		std::uint64_t offset,
+		std::uint64_t length,
+		cancellation_token ct = {});
+
+	/// Copy a range of one file to another, reporting progress as it goes.
+	///
+	/// Performs the same copy as copy_file() but yields the total number
+	/// of bytes copied so far after each chunk has been copied.
+	///
+	/// Destroying the generator before it completes abandons the rest of
+	/// the copy.
+	[[nodiscard]]
+	async_generator<std::uint64_t> copy_file_with_progress(
+		io_service& ioService,
+		static_thread_pool& blockingPool,
+		readable_file& source,
+		writable_file& destination,
+		std::uint64_t offset,
+		std::uint64_t length,
+		cancellation_token ct = {});
+}
+
+#endif
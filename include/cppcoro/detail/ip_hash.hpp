@@ -0,0 +1,102 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_DETAIL_IP_HASH_HPP_INCLUDED
+#define CPPCORO_DETAIL_IP_HASH_HPP_INCLUDED
+
+#include <cppcoro/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+#if CPPCORO_COMPILER_MSVC && CPPCORO_CPU_X64
+# include <intrin.h>
+#endif
+
+namespace cppcoro
+{
+	namespace detail
+	{
+		/// Multiply two 64-bit values and fold the 128-bit product down to 64
+		/// bits, so that every bit of the result depends on every input bit.
+		inline std::uint64_t fold_multiply(std::uint64_t a, std::uint64_t b) noexcept
+		{
+#if defined(__SIZEOF_INT128__)
+			const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+			return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#elif CPPCORO_COMPILER_MSVC && CPPCORO_CPU_X64
+			std::uint64_t high;
+			const std::uint64_t low = _umul128(a, b, &high);
+			return low ^ high;
+#else
+			const std::uint64_t aLow = a & 0xFFFFFFFFu;
+			const std::uint64_t aHigh = a >> 32;
+			const std::uint64_t bLow = b & 0xFFFFFFFFu;
+			const std::uint64_t bHigh = b >> 32;
+
+			const std::uint64_t lowLow = aLow * bLow;
+			const std::uint64_t lowHigh = aLow * bHigh;
+			const std::uint64_t highLow = aHigh * bLow;
+			const std::uint64_t highHigh = aHigh * bHigh;
+
+			const std::uint64_t middle = (lowLow >> 32) + (lowHigh & 0xFFFFFFFFu) + (highLow & 0xFFFFFFFFu);
+			const std::uint64_t low = (middle << 32) | (lowLow & 0xFFFFFFFFu);
+			const std::uint64_t high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+			return low ^ high;
+#endif
+		}
+
+		/// Identifies the address family in the hashed representation of an
+		/// address, so that an IPv4 address doesn't hash the same as the
+		/// IPv4-mapped IPv6 address.
+		enum class ip_hash_family : std::uint32_t
+		{
+			ipv4 = 1,
+			ipv6 = 2
+		};
+
+		/// Hash an address and port.
+		///
+		/// The address is given as 128 bits, with IPv4 addresses in their
+		/// IPv4-mapped IPv6 form, and \a tail holds the port and the family.
+		/// The keys are fixed, so hashes are the same from run to run.
+		inline std::size_t hash_ip_words(
+			std::uint64_t high,
+			std::uint64_t low,
+			std::uint32_t tail,
+			std::uint64_t seed = 0) noexcept
+		{
+			constexpr std::uint64_t k0 = 0x243f6a8885a308d3u;
+			constexpr std::uint64_t k1 = 0x13198a2e03707344u;
+			constexpr std::uint64_t k2 = 0xa4093822299f31d0u;
+			constexpr std::uint64_t k3 = 0x082efa98ec4e6c89u;
+
+			// Mixing the inputs back in stops one of the multiplicands
+			// being zero from discarding the other input.
+			const std::uint64_t h =
+				fold_multiply(high ^ k0 ^ seed, low ^ k1) ^ ((high << 32) | (high >> 32)) ^ low;
+			return static_cast<std::size_t>(fold_multiply(h ^ k2, tail ^ k3));
+		}
+
+		inline std::uint32_t ip_hash_tail(ip_hash_family family, std::uint16_t port) noexcept
+		{
+			return static_cast<std::uint32_t>(family) << 16 | port;
+		}
+
+		inline std::size_t hash_ipv4(std::uint32_t address, std::uint16_t port) noexcept
+		{
+			return hash_ip_words(
+				0,
+				0x0000FFFF00000000u | address,
+				ip_hash_tail(ip_hash_family::ipv4, port));
+		}
+
+		inline std::size_t hash_ipv6(std::uint64_t high, std::uint64_t low, std::uint16_t port) noexcept
+		{
+			return hash_ip_words(high, low, ip_hash_tail(ip_hash_family::ipv6, port));
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_DETAIL_IP_PREFIX_TRIE_HPP_INCLUDED
+#define CPPCORO_DETAIL_IP_PREFIX_TRIE_HPP_INCLUDED
+
+#include <cppcoro/net/ip_address.hpp>
+#include <cppcoro/net/ip_prefix.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace cppcoro
+{
+	namespace detail
+	{
+		/// A path-compressed binary trie mapping IP prefixes to integer values,
+		/// used for longest-prefix-match lookups by ip_prefix_table.
+		///
+		/// Nodes are stored in a flat array and refer to their children by
+		/// index. A node only exists where a prefix ends or where two prefixes
+		/// diverge, so a lookup visits at most one node per stored prefix
+		/// length rather than one node per bit.
+		///
+		/// IPv4 and IPv6 prefixes are kept in separate tries.
+		class ip_prefix_trie
+		{
+		public:
+
+			static constexpr std::uint32_t no_value = 0xFFFFFFFFu;
+
+			ip_prefix_trie();
+
+			/// Map \a prefix to \a value, replacing any existing value.
+			void insert(const net::ip_prefix& prefix, std::uint32_t value);
+
+			/// Look up the value of the longest prefix that contains \a address.
+			///
+			/// \return
+			/// The value, or no_value if no prefix contains the address.
+			std::uint32_t longest_match(const net::ip_address& address) const noexcept;
+
+		private:
+
+			/// An address, left-aligned in 128 bits.
+			struct key
+			{
+				std::uint64_t m_high;
+				std::uint64_t m_low;
+			};
+
+			struct node
+			{
+				key m_prefix;
+				std::uint32_t m_children[2];
+				std::uint32_t m_value;
+				std::uint8_t m_length;
+			};
+
+			static key to_key(const net::ip_address& address) noexcept;
+
+			std::vector<node> m_ipv4Nodes;
+			std::vector<node> m_ipv6Nodes;
+
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,327 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_DETAIL_LINUX_HPP_INCLUDED
+#define CPPCORO_DETAIL_LINUX_HPP_INCLUDED
+
+#include <cppcoro/config.hpp>
+
+#if !CPPCORO_OS_LINUX
+# error <cppcoro/detail/linux.hpp> is only supported on the Linux platform.
+#endif
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace cppcoro
+{
+	namespace detail
+	{
+		// NOTE: Not named 'linux' as that is a predefined macro under GCC
+		// when compiling in GNU mode.
+		namespace lnx
+		{
+			using fd_t = int;
+
+			/// Base class for the state of an operation submitted to an io_uring.
+			///
+			/// The address of the io_state is used as the user_data of the
+			/// submission and the callback is invoked by the io_service event
+			/// loop when the corresponding completion is reaped.
+			struct io_state
+			{
+				using callback_type = void(
+					io_state* state,
+					std::int32_t result,
+					std::uint32_t flags);
+
+				io_state(callback_type* callback = nullptr) noexcept
+					: m_callback(callback)
+				{}
+
+				callback_type* m_callback;
+			};
+
+			class safe_fd
+			{
+			public:
+
+				safe_fd()
+					: m_fd(-1)
+				{}
+
+				explicit safe_fd(fd_t fd)
+					: m_fd(fd)
+				{}
+
+				safe_fd(const safe_fd& other) = delete;
+
+				safe_fd(safe_fd&& other) noexcept
+					: m_fd(other.m_fd)
+				{
+					other.m_fd = -1;
+				}
+
+				~safe_fd()
+				{
+					close();
+				}
+
+				safe_fd& operator=(safe_fd fd) noexcept
+				{
+					swap(fd);
+					return *this;
+				}
+
+				constexpr fd_t fd() const { return m_fd; }
+
+				/// Calls close() and sets the fd to -1.
+				void close() noexcept;
+
+				void swap(safe_fd& other) noexcept
+				{
+					std::swap(m_fd, other.m_fd);
+				}
+
+				bool operator==(const safe_fd& other) const
+				{
+					return m_fd == other.m_fd;
+				}
+
+				bool operator!=(const safe_fd& other) const
+				{
+					return m_fd != other.m_fd;
+				}
+
+				bool operator==(fd_t fd) const
+				{
+					return m_fd == fd;
+				}
+
+				bool operator!=(fd_t fd) const
+				{
+					return m_fd != fd;
+				}
+
+			private:
+
+				fd_t m_fd;
+
+			};
+
+			// The following mirror the layout of the equivalent socket types
+			// so that public headers needn't include <sys/socket.h>, which
+			// declares ::socket() and friends in the global namespace.
+
+			/// Layout-compatible with 'struct iovec'.
+			struct iovec_t
+			{
+				void* iov_base;
+				std::size_t iov_len;
+			};
+
+			/// Layout-compatible with 'struct msghdr'.
+			struct msghdr_t
+			{
+				void* msg_name;
+				std::uint32_t msg_namelen;
+				iovec_t* msg_iov;
+				std::size_t msg_iovlen;
+				void* msg_control;
+				std::size_t msg_controllen;
+				int msg_flags;
+			};
+
+			/// Layout-compatible with 'struct mmsghdr'.
+			struct mmsghdr_t
+			{
+				msghdr_t msg_hdr;
+				std::uint32_t msg_len;
+			};
+
+			/// Large enough and sufficiently aligned to hold any socket
+			/// address, the same as 'struct sockaddr_storage'.
+			struct sockaddr_storage_t
+			{
+				alignas(8) std::uint8_t m_data[128];
+			};
+
+			/// A thin wrapper around the submission and completion queues of
+			/// an io_uring instance that allows them to be shared by multiple
+			/// threads.
+			///
+			/// Submissions are serialised by a mutex, as is reaping of completions.
+			///
+			/// The user_data of each submission identifies what to do with its
+			/// completion. It is either one of the reserved values below or
+			/// the address of the io_state of the operation.
+			class io_uring_queue
+			{
+			public:
+
+				/// user_data of an empty event posted to wake up a thread
+				/// blocked waiting for completions.
+				static constexpr std::uint64_t wake_up_user_data = 0;
+
+				/// user_data of submissions whose completions carry no
+				/// information we need, eg. requests to cancel another operation.
+				static constexpr std::uint64_t ignored_user_data = 2;
+
+				struct completion
+				{
+					std::uint64_t user_data;
+					std::int32_t result;
+					std::uint32_t flags;
+				};
+
+				/// Create an io_uring with at least \a entries submission queue entries.
+				///
+				/// \throw std::system_error
+				/// If the io_uring could not be created, eg. because the kernel
+				/// does not support it or is too old.
+				explicit io_uring_queue(std::uint32_t entries);
+
+				~io_uring_queue();
+
+				io_uring_queue(const io_uring_queue& other) = delete;
+				io_uring_queue& operator=(const io_uring_queue& other) = delete;
+
+				fd_t native_handle() const noexcept { return m_ringFd.fd(); }
+
+				/// Prepare and submit a single submission queue entry.
+				///
+				/// \param prepare
+				/// Invoked with a zero-initialised io_uring_sqe to populate.
+				///
+				/// \return
+				/// Zero on success, otherwise a negative errno value indicating
+				/// why the entry could not be submitted.
+				template<typename PREPARE>
+				int submit(PREPARE&& prepare) noexcept
+				{
+					std::lock_guard lock{ m_submissionMutex };
+					io_uring_sqe* sqe = get_sqe();
+					if (sqe == nullptr)
+					{
+						return -EBUSY;
+					}
+
+					prepare(*sqe);
+					submit_pending();
+
+					return 0;
+				}
+
+				/// The mutex that must be held while calling get_sqe() and
+				/// submit_pending() to prepare several entries as a batch.
+				std::mutex& submission_mutex() noexcept { return m_submissionMutex; }
+
+				/// Get the next free, zero-initialised submission queue entry.
+				///
+				/// Submits pending entries to make room if the queue is full.
+				///
+				/// \return
+				/// The entry, or nullptr if there is no room in the queue.
+				io_uring_sqe* get_sqe() noexcept;
+
+				/// Submit all entries prepared since the last submission.
+				///
+				/// Once prepared, an entry is always submitted. Entries that the
+				/// kernel cannot accept right away (eg. because the completion
+				/// queue has overflowed) stay queued and are submitted by the next
+				/// call to submit_pending() or wait_for_completion().
+				void submit_pending() noexcept;
+
+				/// Submit a request to cancel the operation with the specified user_data.
+				///
+				/// Cancellation is best-effort. The operation completes with
+				/// -ECANCELED if it was cancelled before it could complete.
+				void cancel(std::uint64_t userData) noexcept;
+
+				/// Post an empty event that wakes up one thread waiting for completions.
+				///
+				/// \return
+				/// Zero on success, otherwise a negative errno value.
+				int post(std::uint64_t userData) noexcept;
+
+				/// Register a ring of provided buffers that submissions can select
+				/// a buffer from by setting IOSQE_BUFFER_SELECT and \a groupId.
+				///
+				/// \param ring
+				/// Page-aligned memory for \a entries io_uring_buf entries.
+				///
+				/// \return
+				/// Zero on success, otherwise a negative errno value.
+				int register_buffer_ring(
+					void* ring,
+					std::uint32_t entries,
+					std::uint16_t groupId) noexcept;
+
+				/// Unregister a ring registered by register_buffer_ring().
+				///
+				/// \return
+				/// Zero on success, otherwise a negative errno value.
+				int unregister_buffer_ring(std::uint16_t groupId) noexcept;
+
+				/// Dequeue the next completion, if there is one.
+				///
+				/// \return
+				/// true if a completion was dequeued, false if the completion queue was empty.
+				bool try_get_completion(completion& result) noexcept;
+
+				/// Block until at least one completion is available.
+				///
+				/// May return spuriously, eg. if interrupted by a signal.
+				///
+				/// \throw std::system_error
+				/// If the wait failed.
+				void wait_for_completion();
+
+			private:
+
+				void unmap() noexcept;
+
+				int enter(
+					std::uint32_t toSubmit,
+					std::uint32_t minComplete,
+					std::uint32_t flags) noexcept;
+
+				safe_fd m_ringFd;
+
+				void* m_sqRing;
+				std::size_t m_sqRingSize;
+				void* m_cqRing;
+				std::size_t m_cqRingSize;
+				io_uring_sqe* m_sqes;
+				std::size_t m_sqesSize;
+
+				std::uint32_t* m_sqHead;
+				std::uint32_t* m_sqTail;
+				std::uint32_t m_sqMask;
+				std::uint32_t m_sqEntries;
+
+				std::uint32_t* m_cqHead;
+				std::uint32_t* m_cqTail;
+				std::uint32_t m_cqMask;
+				io_uring_cqe* m_cqes;
+
+				// Tail of the entries that have been prepared but not yet
+				// published to the kernel. Protected by m_submissionMutex.
+				std::uint32_t m_sqLocalTail;
+
+				std::mutex m_submissionMutex;
+				std::mutex m_completionMutex;
+
+			};
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,314 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_DETAIL_LINUX_IO_URING_OPERATION_HPP_INCLUDED
+#define CPPCORO_DETAIL_LINUX_IO_URING_OPERATION_HPP_INCLUDED
+
+#include <cppcoro/cancellation_registration.hpp>
+#include <cppcoro/cancellation_token.hpp>
+#include <cppcoro/operation_cancelled.hpp>
+
+#include <cppcoro/detail/linux.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <optional>
+#include <system_error>
+#include <cppcoro/coroutine.hpp>
+#include <cassert>
+
+namespace cppcoro
+{
+	namespace detail
+	{
+		class io_uring_operation_base
+			: protected detail::lnx::io_state
+		{
+		public:
+
+			io_uring_operation_base(
+				detail::lnx::io_state::callback_type* callback) noexcept
+				: detail::lnx::io_state(callback)
+				, m_result(0)
+				, m_flags(0)
+			{}
+
+			/// The value to use as the user_data of the operation's submission.
+			std::uint64_t get_user_data() noexcept
+			{
+				return reinterpret_cast<std::uintptr_t>(
+					static_cast<detail::lnx::io_state*>(this));
+			}
+
+			/// Complete the operation as if its completion had been reaped
+			/// from the io_uring.
+			///
+			/// For operations that take more than one submission to complete,
+			/// called by the completion handler of an earlier submission.
+			void complete(std::int32_t result, std::uint32_t flags) noexcept
+			{
+				m_callback(this, result, flags);
+			}
+
+			std::size_t get_result()
+			{
+				if (m_result < 0)
+				{
+					throw std::system_error{
+						-m_result,
+						std::system_category()
+					};
+				}
+
+				return static_cast<std::size_t>(m_result);
+			}
+
+			// The 'res' field of the completion. Negative errno on failure.
+			std::int32_t m_result;
+
+			// The 'flags' field of the completion.
+			std::uint32_t m_flags;
+
+		};
+
+		template<typename OPERATION>
+		class io_uring_operation
+			: protected io_uring_operation_base
+		{
+		protected:
+
+			io_uring_operation() noexcept
+				: io_uring_operation_base(
+					&io_uring_operation::on_operation_completed)
+			{}
+
+		public:
+
+			bool await_ready() const noexcept { return false; }
+
+			CPPCORO_NOINLINE
+			bool await_suspend(cppcoro::coroutine_handle<> awaitingCoroutine)
+			{
+				static_assert(std::is_base_of_v<io_uring_operation, OPERATION>);
+
+				m_awaitingCoroutine = awaitingCoroutine;
+				return static_cast<OPERATION*>(this)->try_start();
+			}
+
+			decltype(auto) await_resume()
+			{
+				return static_cast<OPERATION*>(this)->get_result();
+			}
+
+		private:
+
+			static void on_operation_completed(
+				detail::lnx::io_state* ioState,
+				std::int32_t result,
+				std::uint32_t flags) noexcept
+			{
+				auto* operation = static_cast<io_uring_operation*>(ioState);
+				operation->m_result = result;
+				operation->m_flags = flags;
+				operation->m_awaitingCoroutine.resume();
+			}
+
+			cppcoro::coroutine_handle<> m_awaitingCoroutine;
+
+		};
+
+		template<typename OPERATION>
+		class io_uring_operation_cancellable
+			: protected io_uring_operation_base
+		{
+		protected:
+
+			io_uring_operation_cancellable(cancellation_token&& ct) noexcept
+				: io_uring_operation_base(&io_uring_operation_cancellable::on_operation_completed)
+				, m_state(ct.is_cancellation_requested() ? state::completed : state::not_started)
+				, m_cancellationToken(std::move(ct))
+			{
+				m_result = -ECANCELED;
+			}
+
+			io_uring_operation_cancellable(
+				io_uring_operation_cancellable&& other) noexcept
+				: io_uring_operation_base(std::move(other))
+				, m_state(other.m_state.load(std::memory_order_relaxed))
+				, m_cancellationToken(std::move(other.m_cancellationToken))
+			{
+				assert(m_result == other.m_result);
+			}
+
+		public:
+
+			bool await_ready() const noexcept
+			{
+				return m_state.load(std::memory_order_relaxed) == state::completed;
+			}
+
+			CPPCORO_NOINLINE
+			bool await_suspend(cppcoro::coroutine_handle<> awaitingCoroutine)
+			{
+				static_assert(std::is_base_of_v<io_uring_operation_cancellable, OPERATION>);
+
+				m_awaitingCoroutine = awaitingCoroutine;
+
+				// TRICKY: Register the cancellation callback before starting the
+				// operation so that everything after starting it is noexcept.
+				// See win32_overlapped_operation_cancellable::await_suspend() for
+				// the details of the state transitions.
+				const bool canBeCancelled = m_cancellationToken.can_be_cancelled();
+				if (canBeCancelled)
+				{
+					m_cancellationCallback.emplace(
+						std::move(m_cancellationToken),
+						[this] { this->on_cancellation_requested(); });
+				}
+				else
+				{
+					m_state.store(state::started, std::memory_order_relaxed);
+				}
+
+				// Now start the operation.
+				const bool willCompleteAsynchronously = static_cast<OPERATION*>(this)->try_start();
+				if (!willCompleteAsynchronously)
+				{
+					// Operation failed to start, resume awaiting coroutine immediately.
+					return false;
+				}
+
+				if (canBeCancelled)
+				{
+					// The operation may have completed concurrently on an I/O
+					// thread, or the cancellation callback may have run, before
+					// we get to mark the operation as started.
+					state oldState = state::not_started;
+					if (!m_state.compare_exchange_strong(
+						oldState,
+						state::started,
+						std::memory_order_release,
+						std::memory_order_acquire))
+					{
+						if (oldState == state::cancellation_requested)
+						{
+							static_cast<OPERATION*>(this)->cancel();
+
+							if (!m_state.compare_exchange_strong(
+								oldState,
+								state::started,
+								std::memory_order_release,
+								std::memory_order_acquire))
+							{
+								assert(oldState == state::completed);
+								return false;
+							}
+						}
+						else
+						{
+							assert(oldState == state::completed);
+							return false;
+						}
+					}
+				}
+
+				return true;
+			}
+
+			decltype(auto) await_resume()
+			{
+				// Free memory used by the cancellation callback now that the operation
+				// has completed rather than waiting until the operation object destructs.
+				m_cancellationCallback.reset();
+
+				// Operations that were blocked in an io-wq worker when they were
+				// cancelled complete with -EINTR rather than -ECANCELED.
+				if (m_result == -ECANCELED ||
+					(m_result == -EINTR && m_cancellationRequested.load(std::memory_order_relaxed)))
+				{
+					throw operation_cancelled{};
+				}
+
+				return static_cast<OPERATION*>(this)->get_result();
+			}
+
+		private:
+
+			enum class state
+			{
+				not_started,
+				started,
+				cancellation_requested,
+				completed
+			};
+
+			void on_cancellation_requested() noexcept
+			{
+				m_cancellationRequested.store(true, std::memory_order_relaxed);
+
+				auto oldState = m_state.load(std::memory_order_acquire);
+				if (oldState == state::not_started)
+				{
+					// Let the await_suspend() thread request cancellation once
+					// it has finished starting the operation.
+					const bool transferredCancelResponsibility =
+						m_state.compare_exchange_strong(
+							oldState,
+							state::cancellation_requested,
+							std::memory_order_release,
+							std::memory_order_acquire);
+					if (transferredCancelResponsibility)
+					{
+						return;
+					}
+				}
+
+				// No point requesting cancellation if the operation has already completed.
+				if (oldState != state::completed)
+				{
+					static_cast<OPERATION*>(this)->cancel();
+				}
+			}
+
+			static void on_operation_completed(
+				detail::lnx::io_state* ioState,
+				std::int32_t result,
+				std::uint32_t flags) noexcept
+			{
+				auto* operation = static_cast<io_uring_operation_cancellable*>(ioState);
+
+				operation->m_result = result;
+				operation->m_flags = flags;
+
+				auto state = operation->m_state.load(std::memory_order_acquire);
+				if (state == state::started)
+				{
+					operation->m_state.store(state::completed, std::memory_order_relaxed);
+					operation->m_awaitingCoroutine.resume();
+				}
+				else
+				{
+					// We are racing with await_suspend() call suspending.
+					// See win32_overlapped_operation_cancellable::on_operation_completed().
+					state = operation->m_state.exchange(
+						state::completed,
+						std::memory_order_acq_rel);
+					if (state == state::started)
+					{
+						operation->m_awaitingCoroutine.resume();
+					}
+				}
+			}
+
+			std::atomic<state> m_state;
+			std::atomic<bool> m_cancellationRequested{ false };
+			cppcoro::cancellation_token m_cancellationToken;
+			std::optional<cppcoro::cancellation_registration> m_cancellationCallback;
+			cppcoro::coroutine_handle<> m_awaitingCoroutine;
+
+		};
+	}
+}
+
+#endif
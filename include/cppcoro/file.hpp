@@ -13,6 +13,8 @@
 
 #if CPPCORO_OS_WINNT
 # include <cppcoro/detail/win32.hpp>
+#elif CPPCORO_OS_LINUX
+# include <cppcoro/detail/linux.hpp>
 #endif
 
 #include <cppcoro/filesystem.hpp>
@@ -32,6 +34,14 @@ namespace cppcoro
 		/// Get the size of the file in bytes.
 		std::uint64_t size() const;
 
+#if CPPCORO_OS_WINNT
+		/// Get the Win32 file handle associated with this file.
+		detail::win32::handle_t native_handle() const noexcept { return m_fileHandle.handle(); }
+#elif CPPCORO_OS_LINUX
+		/// Get the file descriptor associated with this file.
+		detail::lnx::fd_t native_handle() const noexcept { return m_fileDescriptor.fd(); }
+#endif
+
 	protected:
 
 #if CPPCORO_OS_WINNT
@@ -46,6 +56,23 @@ namespace cppcoro
 			file_buffering_mode bufferingMode);
 
 		detail::win32::safe_handle m_fileHandle;
+#elif CPPCORO_OS_LINUX
+		file(detail::lnx::safe_fd&& fileDescriptor, io_service* ioService) noexcept;
+
+		/// \param fileAccess
+		/// One of O_RDONLY, O_WRONLY or O_RDWR.
+		static detail::lnx::safe_fd open(
+			int fileAccess,
+			io_service& ioService,
+			const cppcoro::filesystem::path& path,
+			file_open_mode openMode,
+			file_share_mode shareMode,
+			file_buffering_mode bufferingMode);
+
+		detail::lnx::safe_fd m_fileDescriptor;
+
+		// The io_service that I/O operations on the file are submitted to.
+		io_service* m_ioService;
 #endif
 
 	};
@@ -0,0 +1,123 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_FILE_READ_MANY_OPERATION_HPP_INCLUDED
+#define CPPCORO_FILE_READ_MANY_OPERATION_HPP_INCLUDED
+
+#include <cppcoro/config.hpp>
+#include <cppcoro/cancellation_registration.hpp>
+#include <cppcoro/cancellation_token.hpp>
+#include <cppcoro/coroutine.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <system_error>
+
+#if CPPCORO_OS_WINNT
+# include <cppcoro/detail/win32.hpp>
+#elif CPPCORO_OS_LINUX
+# include <cppcoro/detail/linux.hpp>
+#endif
+
+namespace cppcoro
+{
+	/// A single read within a batch submitted by readable_file::read_many().
+	///
+	/// The caller fills in the 'offset', 'buffer' and 'byteCount' fields.
+	/// The 'bytesRead' and 'error' fields are written when that particular
+	/// read completes, independently of the other reads in the batch.
+	struct file_read_request
+	{
+		std::uint64_t offset = 0;
+		void* buffer = nullptr;
+		std::size_t byteCount = 0;
+
+		std::size_t bytesRead = 0;
+		std::error_code error;
+	};
+
+#if CPPCORO_OS_WINNT || CPPCORO_OS_LINUX
+	class file_read_many_operation
+	{
+	public:
+
+#if CPPCORO_OS_WINNT
+		file_read_many_operation(
+			detail::win32::handle_t fileHandle,
+			std::span<file_read_request> requests,
+			cancellation_token ct) noexcept;
+#elif CPPCORO_OS_LINUX
+		file_read_many_operation(
+			detail::lnx::io_uring_queue& ioQueue,
+			detail::lnx::fd_t fileDescriptor,
+			std::span<file_read_request> requests,
+			cancellation_token ct) noexcept;
+#endif
+
+		file_read_many_operation(file_read_many_operation&& other) noexcept;
+
+		file_read_many_operation(const file_read_many_operation&) = delete;
+		file_read_many_operation& operator=(const file_read_many_operation&) = delete;
+		file_read_many_operation& operator=(file_read_many_operation&&) = delete;
+
+		~file_read_many_operation();
+
+		bool await_ready() const noexcept { return m_requests.empty(); }
+
+		bool await_suspend(cppcoro::coroutine_handle<> awaitingCoroutine);
+
+		/// Throws operation_cancelled if cancellation was requested and at
+		/// least one of the reads did not complete successfully. Otherwise
+		/// the outcome of each read is reported through its request.
+		void await_resume();
+
+	private:
+
+		struct read_state;
+
+#if CPPCORO_OS_WINNT
+		static void on_read_completed(
+			detail::win32::io_state* ioState,
+			detail::win32::dword_t errorCode,
+			detail::win32::dword_t numberOfBytesTransferred,
+			detail::win32::ulongptr_t completionKey) noexcept;
+#elif CPPCORO_OS_LINUX
+		static void on_read_completed(
+			detail::lnx::io_state* ioState,
+			std::int32_t result,
+			std::uint32_t flags) noexcept;
+#endif
+
+		void on_cancellation_requested() noexcept;
+		void cancel_outstanding_reads() noexcept;
+		void on_request_finished() noexcept;
+
+#if CPPCORO_OS_WINNT
+		detail::win32::handle_t m_fileHandle;
+#elif CPPCORO_OS_LINUX
+		detail::lnx::io_uring_queue& m_ioQueue;
+		detail::lnx::fd_t m_fileDescriptor;
+#endif
+		std::span<file_read_request> m_requests;
+		std::unique_ptr<read_state[]> m_states;
+		std::size_t m_submittedCount;
+
+		// One count per request plus one held by await_suspend() while
+		// the reads are being submitted.
+		std::atomic<std::size_t> m_remainingCount;
+
+		std::atomic<bool> m_cancellationRequested;
+		std::atomic<bool> m_submissionCompleted;
+		cppcoro::cancellation_token m_cancellationToken;
+		std::optional<cppcoro::cancellation_registration> m_cancellationRegistration;
+		cppcoro::coroutine_handle<> m_awaitingCoroutine;
+
+	};
+#endif
+}
+
+#endif
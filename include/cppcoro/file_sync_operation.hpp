@@ -0,0 +1,221 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_FILE_SYNC_OPERATION_HPP_INCLUDED
+#define CPPCORO_FILE_SYNC_OPERATION_HPP_INCLUDED
+
+#include <cppcoro/config.hpp>
+
+#include <cstdint>
+
+#if CPPCORO_OS_WINNT
+# include <cppcoro/detail/win32.hpp>
+# include <cppcoro/detail/win32_overlapped_operation.hpp>
+#elif CPPCORO_OS_LINUX
+# include <cppcoro/detail/linux.hpp>
+# include <cppcoro/detail/linux_io_uring_operation.hpp>
+#endif
+
+namespace cppcoro
+{
+#if CPPCORO_OS_WINNT
+	class file_sync_operation_impl
+	{
+	public:
+
+		file_sync_operation_impl(
+			detail::win32::handle_t fileHandle,
+			bool dataOnly) noexcept
+			: m_fileHandle(fileHandle)
+			, m_dataOnly(dataOnly)
+		{}
+
+		bool try_start(cppcoro::detail::win32_overlapped_operation_base& operation) noexcept;
+
+	private:
+
+		detail::win32::handle_t m_fileHandle;
+		bool m_dataOnly;
+
+	};
+
+	class file_sync_operation
+		: public cppcoro::detail::win32_overlapped_operation<file_sync_operation>
+	{
+	public:
+
+		file_sync_operation(
+			detail::win32::handle_t fileHandle,
+			bool dataOnly) noexcept
+			: m_impl(fileHandle, dataOnly)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::win32_overlapped_operation<file_sync_operation>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+
+		void get_result() { (void)win32_overlapped_operation_base::get_result(); }
+
+		file_sync_operation_impl m_impl;
+
+	};
+
+	class file_allocate_operation_impl
+	{
+	public:
+
+		file_allocate_operation_impl(
+			detail::win32::handle_t fileHandle,
+			std::uint64_t offset,
+			std::uint64_t length,
+			bool punchHole) noexcept
+			: m_fileHandle(fileHandle)
+			, m_offset(offset)
+			, m_length(length)
+			, m_punchHole(punchHole)
+		{}
+
+		bool try_start(cppcoro::detail::win32_overlapped_operation_base& operation) noexcept;
+
+	private:
+
+		detail::win32::handle_t m_fileHandle;
+		std::uint64_t m_offset;
+		std::uint64_t m_length;
+		bool m_punchHole;
+
+	};
+
+	class file_allocate_operation
+		: public cppcoro::detail::win32_overlapped_operation<file_allocate_operation>
+	{
+	public:
+
+		file_allocate_operation(
+			detail::win32::handle_t fileHandle,
+			std::uint64_t offset,
+			std::uint64_t length,
+			bool punchHole) noexcept
+			: m_impl(fileHandle, offset, length, punchHole)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::win32_overlapped_operation<file_allocate_operation>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+
+		void get_result() { (void)win32_overlapped_operation_base::get_result(); }
+
+		file_allocate_operation_impl m_impl;
+
+	};
+#elif CPPCORO_OS_LINUX
+	class file_sync_operation_impl
+	{
+	public:
+
+		file_sync_operation_impl(
+			detail::lnx::io_uring_queue& ioQueue,
+			detail::lnx::fd_t fileDescriptor,
+			bool dataOnly) noexcept
+			: m_ioQueue(ioQueue)
+			, m_fileDescriptor(fileDescriptor)
+			, m_dataOnly(dataOnly)
+		{}
+
+		bool try_start(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+
+	private:
+
+		detail::lnx::io_uring_queue& m_ioQueue;
+		detail::lnx::fd_t m_fileDescriptor;
+		bool m_dataOnly;
+
+	};
+
+	class file_sync_operation
+		: public cppcoro::detail::io_uring_operation<file_sync_operation>
+	{
+	public:
+
+		file_sync_operation(
+			detail::lnx::io_uring_queue& ioQueue,
+			detail::lnx::fd_t fileDescriptor,
+			bool dataOnly) noexcept
+			: m_impl(ioQueue, fileDescriptor, dataOnly)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation<file_sync_operation>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+
+		void get_result() { (void)io_uring_operation_base::get_result(); }
+
+		file_sync_operation_impl m_impl;
+
+	};
+
+	class file_allocate_operation_impl
+	{
+	public:
+
+		file_allocate_operation_impl(
+			detail::lnx::io_uring_queue& ioQueue,
+			detail::lnx::fd_t fileDescriptor,
+			std::uint64_t offset,
+			std::uint64_t length,
+			bool punchHole) noexcept
+			: m_ioQueue(ioQueue)
+			, m_fileDescriptor(fileDescriptor)
+			, m_offset(offset)
+			, m_length(length)
+			, m_punchHole(punchHole)
+		{}
+
+		bool try_start(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+
+	private:
+
+		detail::lnx::io_uring_queue& m_ioQueue;
+		detail::lnx::fd_t m_fileDescriptor;
+		std::uint64_t m_offset;
+		std::uint64_t m_length;
+		bool m_punchHole;
+
+	};
+
+	class file_allocate_operation
+		: public cppcoro::detail::io_uring_operation<file_allocate_operation>
+	{
+	public:
+
+		file_allocate_operation(
+			detail::lnx::io_uring_queue& ioQueue,
+			detail::lnx::fd_t fileDescriptor,
+			std::uint64_t offset,
+			std::uint64_t length,
+			bool punchHole) noexcept
+			: m_impl(ioQueue, fileDescriptor, offset, length, punchHole)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation<file_allocate_operation>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+
+		void get_result() { (void)io_uring_operation_base::get_result(); }
+
+		file_allocate_operation_impl m_impl;
+
+	};
+#endif
+}
+
+#endif
@@ -15,9 +15,14 @@
 #if CPPCORO_OS_WINNT
 # include <cppcoro/detail/win32.hpp>
 # include <cppcoro/detail/win32_overlapped_operation.hpp>
+#elif CPPCORO_OS_LINUX
+# include <cppcoro/detail/linux.hpp>
+# include <cppcoro/detail/linux_io_uring_operation.hpp>
+#endif
 
 namespace cppcoro
 {
+#if CPPCORO_OS_WINNT
 	class file_write_operation_impl
 	{
 	public:
@@ -91,8 +96,89 @@ namespace cppcoro
 		file_write_operation_impl m_impl;
 
 	};
-}
+#elif CPPCORO_OS_LINUX
+	class file_write_operation_impl
+	{
+	public:
+
+		file_write_operation_impl(
+			detail::lnx::io_uring_queue& ioQueue,
+			detail::lnx::fd_t fileDescriptor,
+			std::uint64_t fileOffset,
+			const void* buffer,
+			std::size_t byteCount) noexcept
+			: m_ioQueue(ioQueue)
+			, m_fileDescriptor(fileDescriptor)
+			, m_fileOffset(fileOffset)
+			, m_buffer(buffer)
+			, m_byteCount(byteCount)
+		{}
+
+		bool try_start(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+		void cancel(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+
+	private:
+
+		detail::lnx::io_uring_queue& m_ioQueue;
+		detail::lnx::fd_t m_fileDescriptor;
+		std::uint64_t m_fileOffset;
+		const void* m_buffer;
+		std::size_t m_byteCount;
+
+	};
+
+	class file_write_operation
+		: public cppcoro::detail::io_uring_operation<file_write_operation>
+	{
+	public:
+
+		file_write_operation(
+			detail::lnx::io_uring_queue& ioQueue,
+			detail::lnx::fd_t fileDescriptor,
+			std::uint64_t fileOffset,
+			const void* buffer,
+			std::size_t byteCount) noexcept
+			: m_impl(ioQueue, fileDescriptor, fileOffset, buffer, byteCount)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation<file_write_operation>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+
+		file_write_operation_impl m_impl;
 
-#endif // CPPCORO_OS_WINNT
+	};
+
+	class file_write_operation_cancellable
+		: public cppcoro::detail::io_uring_operation_cancellable<file_write_operation_cancellable>
+	{
+	public:
+
+		file_write_operation_cancellable(
+			detail::lnx::io_uring_queue& ioQueue,
+			detail::lnx::fd_t fileDescriptor,
+			std::uint64_t fileOffset,
+			const void* buffer,
+			std::size_t byteCount,
+			cancellation_token&& cancellationToken) noexcept
+			: cppcoro::detail::io_uring_operation_cancellable<file_write_operation_cancellable>(
+				std::move(cancellationToken))
+			, m_impl(ioQueue, fileDescriptor, fileOffset, buffer, byteCount)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation_cancellable<file_write_operation_cancellable>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+		void cancel() noexcept { m_impl.cancel(*this); }
+
+		file_write_operation_impl m_impl;
+
+	};
+#endif
+}
 
 #endif
@@ -0,0 +1,192 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_FILE_WRITE_VECTORED_OPERATION_HPP_INCLUDED
+#define CPPCORO_FILE_WRITE_VECTORED_OPERATION_HPP_INCLUDED
+
+#include <cppcoro/config.hpp>
+#include <cppcoro/cancellation_registration.hpp>
+#include <cppcoro/cancellation_token.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+#if CPPCORO_OS_WINNT
+# include <cppcoro/detail/win32.hpp>
+# include <cppcoro/detail/win32_overlapped_operation.hpp>
+#elif CPPCORO_OS_LINUX
+# include <cppcoro/detail/linux.hpp>
+# include <cppcoro/detail/linux_io_uring_operation.hpp>
+#endif
+
+namespace cppcoro
+{
+	/// One of the buffers gathered into a single write by writable_file::write().
+	struct file_write_buffer
+	{
+		const void* buffer = nullptr;
+		std::size_t size = 0;
+	};
+
+#if CPPCORO_OS_WINNT
+	class file_write_vectored_operation_impl
+	{
+	public:
+
+		file_write_vectored_operation_impl(
+			detail::win32::handle_t fileHandle,
+			std::span<const file_write_buffer> buffers) noexcept
+			: m_fileHandle(fileHandle)
+			, m_buffers(buffers)
+		{}
+
+		bool try_start(cppcoro::detail::win32_overlapped_operation_base& operation) noexcept;
+		void cancel(cppcoro::detail::win32_overlapped_operation_base& operation) noexcept;
+
+	private:
+
+		detail::win32::handle_t m_fileHandle;
+		std::span<const file_write_buffer> m_buffers;
+
+		// WriteFileGather() takes a null-terminated array of pointers to the
+		// pages to write, each held in a 64-bit FILE_SEGMENT_ELEMENT.
+		std::unique_ptr<std::uint64_t[]> m_segments;
+
+	};
+
+	class file_write_vectored_operation
+		: public cppcoro::detail::win32_overlapped_operation<file_write_vectored_operation>
+	{
+	public:
+
+		file_write_vectored_operation(
+			detail::win32::handle_t fileHandle,
+			std::uint64_t fileOffset,
+			std::span<const file_write_buffer> buffers) noexcept
+			: cppcoro::detail::win32_overlapped_operation<file_write_vectored_operation>(fileOffset)
+			, m_impl(fileHandle, buffers)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::win32_overlapped_operation<file_write_vectored_operation>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+
+		file_write_vectored_operation_impl m_impl;
+
+	};
+
+	class file_write_vectored_operation_cancellable
+		: public cppcoro::detail::win32_overlapped_operation_cancellable<file_write_vectored_operation_cancellable>
+	{
+	public:
+
+		file_write_vectored_operation_cancellable(
+			detail::win32::handle_t fileHandle,
+			std::uint64_t fileOffset,
+			std::span<const file_write_buffer> buffers,
+			cancellation_token&& ct) noexcept
+			: cppcoro::detail::win32_overlapped_operation_cancellable<file_write_vectored_operation_cancellable>(fileOffset, std::move(ct))
+			, m_impl(fileHandle, buffers)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::win32_overlapped_operation_cancellable<file_write_vectored_operation_cancellable>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+		void cancel() noexcept { m_impl.cancel(*this); }
+
+		file_write_vectored_operation_impl m_impl;
+
+	};
+#elif CPPCORO_OS_LINUX
+	class file_write_vectored_operation_impl
+	{
+	public:
+
+		file_write_vectored_operation_impl(
+			detail::lnx::io_uring_queue& ioQueue,
+			detail::lnx::fd_t fileDescriptor,
+			std::uint64_t fileOffset,
+			std::span<const file_write_buffer> buffers) noexcept
+			: m_ioQueue(ioQueue)
+			, m_fileDescriptor(fileDescriptor)
+			, m_fileOffset(fileOffset)
+			, m_buffers(buffers)
+		{}
+
+		bool try_start(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+		void cancel(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+
+	private:
+
+		detail::lnx::io_uring_queue& m_ioQueue;
+		detail::lnx::fd_t m_fileDescriptor;
+		std::uint64_t m_fileOffset;
+		std::span<const file_write_buffer> m_buffers;
+
+		// Most writes gather only a few buffers so only allocate an array of
+		// iovecs when there are more than this.
+		cppcoro::detail::lnx::iovec_t m_inlineIovecs[8];
+		std::unique_ptr<cppcoro::detail::lnx::iovec_t[]> m_iovecs;
+
+	};
+
+	class file_write_vectored_operation
+		: public cppcoro::detail::io_uring_operation<file_write_vectored_operation>
+	{
+	public:
+
+		file_write_vectored_operation(
+			detail::lnx::io_uring_queue& ioQueue,
+			detail::lnx::fd_t fileDescriptor,
+			std::uint64_t fileOffset,
+			std::span<const file_write_buffer> buffers) noexcept
+			: m_impl(ioQueue, fileDescriptor, fileOffset, buffers)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation<file_write_vectored_operation>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+
+		file_write_vectored_operation_impl m_impl;
+
+	};
+
+	class file_write_vectored_operation_cancellable
+		: public cppcoro::detail::io_uring_operation_cancellable<file_write_vectored_operation_cancellable>
+	{
+	public:
+
+		file_write_vectored_operation_cancellable(
+			detail::lnx::io_uring_queue& ioQueue,
+			detail::lnx::fd_t fileDescriptor,
+			std::uint64_t fileOffset,
+			std::span<const file_write_buffer> buffers,
+			cancellation_token&& cancellationToken) noexcept
+			: cppcoro::detail::io_uring_operation_cancellable<file_write_vectored_operation_cancellable>(
+				std::move(cancellationToken))
+			, m_impl(ioQueue, fileDescriptor, fileOffset, buffers)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation_cancellable<file_write_vectored_operation_cancellable>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+		void cancel() noexcept { m_impl.cancel(*this); }
+
+		file_write_vectored_operation_impl m_impl;
+
+	};
+#endif
+}
+
+#endif
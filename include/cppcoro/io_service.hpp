@@ -11,8 +11,11 @@
 
 #if CPPCORO_OS_WINNT
 # include <cppcoro/detail/win32.hpp>
+#elif CPPCORO_OS_LINUX
+# include <cppcoro/detail/linux.hpp>
 #endif
 
+#include <array>
 #include <optional>
 #include <chrono>
 #include <cstdint>
@@ -23,6 +26,50 @@
 
 namespace cppcoro
 {
+	namespace detail
+	{
+		class io_service_instrumentation;
+	}
+
+	/// A snapshot of the instrumentation recorded by an io_service.
+	///
+	/// Histograms have power-of-two buckets. Bucket 0 counts samples with
+	/// value zero and bucket i counts samples in the range [2^(i-1), 2^i).
+	struct io_service_stats
+	{
+		using histogram = std::array<std::uint64_t, 65>;
+
+		/// Get the index of the histogram bucket that counts \a value.
+		static constexpr std::size_t bucket_index(std::uint64_t value) noexcept
+		{
+			std::size_t index = 0;
+			while (value != 0)
+			{
+				++index;
+				value >>= 1;
+			}
+			return index;
+		}
+
+		/// Time in nanoseconds from a coroutine being scheduled with
+		/// schedule() or by an elapsed timer to it being resumed.
+		histogram schedule_latency_ns;
+
+		/// Time in nanoseconds spent processing each event, ie. running a
+		/// resumed coroutine or I/O completion until it next suspends.
+		histogram event_processing_time_ns;
+
+		/// Number of events a thread processed each time it woke up from
+		/// waiting for events in the kernel.
+		histogram events_per_wake_up;
+
+		/// Number of schedule_after() operations waiting for their timer.
+		std::uint32_t pending_timer_count;
+
+		/// Outstanding work count, see notify_work_started().
+		std::uint32_t work_count;
+	};
+
 	class io_service
 	{
 	public:
@@ -128,6 +175,46 @@ namespace cppcoro
 
 		bool is_stop_requested() const noexcept;
 
+		/// Set how long a thread in the event loop busy-polls for new events
+		/// before blocking in the kernel to wait for one.
+		///
+		/// While busy-polling, the thread repeatedly checks for completions and
+		/// scheduled coroutines without making a system call. This avoids the
+		/// cost of putting the thread to sleep and waking it up again, at the
+		/// cost of burning a CPU while the io_service is idle. It is worth it
+		/// when events arrive at intervals shorter than that cost, eg. for
+		/// low-latency request/response traffic on dedicated cores.
+		///
+		/// \param duration
+		/// The maximum time to spin waiting for an event. Zero, the default,
+		/// disables busy-polling. Takes effect the next time a thread runs out
+		/// of events to process.
+		void set_busy_poll_duration(std::chrono::microseconds duration) noexcept;
+
+		/// The time a thread busy-polls for events before blocking.
+		std::chrono::microseconds busy_poll_duration() const noexcept;
+
+		/// Start or stop recording instrumentation for the event loop.
+		///
+		/// Instrumentation is disabled by default. While enabled, each
+		/// scheduled coroutine and each event costs a couple of clock reads
+		/// and relaxed atomic increments.
+		///
+		/// \throw std::bad_alloc
+		/// If enabling for the first time and the counters could not be allocated.
+		void set_instrumentation_enabled(bool enabled);
+
+		bool is_instrumentation_enabled() const noexcept;
+
+		/// Take a snapshot of the instrumentation recorded so far.
+		///
+		/// This is lock-free and may be called from any thread at any time.
+		/// Each counter is read atomically, but the snapshot as a whole is
+		/// not, so counters may be from slightly different moments while
+		/// events are being processed. Diff two snapshots to get the
+		/// activity between them.
+		io_service_stats instrumentation_snapshot() const noexcept;
+
 		void notify_work_started() noexcept;
 
 		void notify_work_finished() noexcept;
@@ -135,20 +222,38 @@ namespace cppcoro
 #if CPPCORO_OS_WINNT
 		detail::win32::handle_t native_iocp_handle() noexcept;
 		void ensure_winsock_initialised();
+#elif CPPCORO_OS_LINUX
+		detail::lnx::io_uring_queue& native_io_uring_queue() noexcept;
 #endif
 
 	private:
 
 		class timer_thread_state;
 		class timer_queue;
+		class thread_state;
 
 		friend class schedule_operation;
 		friend class timed_schedule_operation;
 
 		void schedule_impl(schedule_operation* operation) noexcept;
 
+		/// The state of the innermost event loop running on the current
+		/// thread, or nullptr if the thread is not running an event loop.
+		static thread_state*& current_thread_state() noexcept;
+
+		schedule_operation* try_dequeue_local_schedule_operation() noexcept;
+
+		/// The instrumentation to record to, or nullptr if disabled.
+		detail::io_service_instrumentation* enabled_instrumentation() const noexcept;
+
+		void resume_scheduled_operation(schedule_operation* operation);
+
 		void try_reschedule_overflow_operations() noexcept;
 
+#if CPPCORO_OS_LINUX
+		schedule_operation* try_dequeue_schedule_operation() noexcept;
+#endif
+
 		bool try_enter_event_loop() noexcept;
 		void exit_event_loop() noexcept;
 
@@ -167,20 +272,42 @@ namespace cppcoro
 
 		std::atomic<std::uint32_t> m_workCount;
 
+		// Busy-poll duration in microseconds. Zero disables busy-polling.
+		std::atomic<std::int64_t> m_busyPollMicroseconds;
+
 #if CPPCORO_OS_WINNT
 		detail::win32::safe_handle m_iocpHandle;
 
 		std::atomic<bool> m_winsockInitialised;
 		std::mutex m_winsockInitialisationMutex;
+#elif CPPCORO_OS_LINUX
+		detail::lnx::io_uring_queue m_ioQueue;
 #endif
 
 		// Head of a linked-list of schedule operations that are
 		// ready to run but that failed to be queued to the I/O
 		// completion port (eg. due to low memory).
+		//
+		// On Linux every schedule operation is queued here and
+		// a wake-up event is only posted to the io_uring when the
+		// list goes from empty to non-empty.
 		std::atomic<schedule_operation*> m_scheduleOperations;
 
+#if CPPCORO_OS_LINUX
+		// Operations taken from m_scheduleOperations, in the order
+		// they were scheduled, that have not yet been resumed.
+		std::mutex m_readyOperationsMutex;
+		schedule_operation* m_readyOperations;
+#endif
+
 		std::atomic<timer_thread_state*> m_timerState;
 
+		// Allocated on first enabling instrumentation and kept until the
+		// io_service is destroyed so that threads may keep recording to it
+		// after it is disabled.
+		std::atomic<bool> m_instrumentationEnabled;
+		std::atomic<detail::io_service_instrumentation*> m_instrumentation;
+
 	};
 
 	class io_service::schedule_operation
@@ -189,6 +316,7 @@ namespace cppcoro
 
 		schedule_operation(io_service& service) noexcept
 			: m_service(service)
+			, m_scheduleTime()
 		{}
 
 		bool await_ready() const noexcept { return false; }
@@ -204,6 +332,9 @@ namespace cppcoro
 		cppcoro::coroutine_handle<> m_awaiter;
 		schedule_operation* m_next;
 
+		// When the operation was scheduled, if instrumentation was enabled.
+		std::chrono::steady_clock::time_point m_scheduleTime;
+
 	};
 
 	class io_service::timed_schedule_operation
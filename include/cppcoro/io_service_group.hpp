@@ -0,0 +1,110 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_IO_SERVICE_GROUP_HPP_INCLUDED
+#define CPPCORO_IO_SERVICE_GROUP_HPP_INCLUDED
+
+#include <cppcoro/config.hpp>
+#include <cppcoro/io_service.hpp>
+#include <cppcoro/net/ip_endpoint.hpp>
+#include <cppcoro/net/socket.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace cppcoro
+{
+	/// A group of io_services, or shards, that each have their own event
+	/// loop thread pinned to its own CPU.
+	///
+	/// Work started on a shard stays on that shard's thread, so there is no
+	/// contention between shards for a completion queue and no bouncing of
+	/// a connection's state between CPUs. Use create_listening_sockets() to
+	/// have the kernel spread incoming connections across the shards.
+	class io_service_group
+	{
+	public:
+
+		/// Start one shard for each CPU that the process may run on.
+		io_service_group();
+
+		/// Start the specified number of shards.
+		///
+		/// \param shardCount
+		/// The number of shards. Shards are pinned to the CPUs that the
+		/// process may run on in turn, wrapping around if there are more
+		/// shards than CPUs.
+		explicit io_service_group(std::uint32_t shardCount);
+
+		/// Stops every shard and waits for their threads to exit.
+		~io_service_group();
+
+		io_service_group(const io_service_group& other) = delete;
+		io_service_group& operator=(const io_service_group& other) = delete;
+
+		/// The number of shards in the group.
+		std::uint32_t size() const noexcept { return m_shardCount; }
+
+		/// Get the io_service of a shard.
+		io_service& operator[](std::uint32_t index) noexcept
+		{
+			return m_shards[index].m_ioService;
+		}
+
+		/// Get the CPU that a shard's thread is pinned to, or -1 if pinning
+		/// the thread failed.
+		int cpu(std::uint32_t index) const noexcept { return m_shards[index].m_cpu; }
+
+		/// Create a listening socket for each shard, all bound to the same
+		/// end-point with SO_REUSEPORT so that the kernel distributes incoming
+		/// connections between them.
+		///
+		/// On Linux each socket also asks for connections whose packets are
+		/// processed on its shard's CPU (SO_INCOMING_CPU), so that a connection
+		/// is handled on the same CPU for its whole life where possible.
+		///
+		/// \param localEndPoint
+		/// The end-point to listen on. If the port is zero then a port is
+		/// chosen for the first socket and the others are bound to the same one.
+		///
+		/// \return
+		/// One listening socket per shard, associated with that shard's
+		/// io_service, in shard order.
+		///
+		/// \throws std::system_error
+		/// If any of the sockets could not be created, bound or put into the
+		/// listening state. Windows does not support SO_REUSEPORT.
+		std::vector<net::socket> create_listening_sockets(
+			const net::ip_endpoint& localEndPoint);
+		std::vector<net::socket> create_listening_sockets(
+			const net::ip_endpoint& localEndPoint,
+			std::uint32_t backlog);
+
+		/// Stop the event loop of every shard.
+		///
+		/// Does not wait for the threads to exit; the destructor does that.
+		void stop() noexcept;
+
+	private:
+
+		struct shard
+		{
+			shard() : m_ioService(1), m_cpu(-1) {}
+
+			io_service m_ioService;
+			int m_cpu;
+			std::thread m_thread;
+		};
+
+		void shutdown() noexcept;
+
+		const std::uint32_t m_shardCount;
+		std::unique_ptr<shard[]> m_shards;
+
+	};
+}
+
+#endif
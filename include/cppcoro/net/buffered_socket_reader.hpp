@@ -0,0 +1,155 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_NET_BUFFERED_SOCKET_READER_HPP_INCLUDED
+#define CPPCORO_NET_BUFFERED_SOCKET_READER_HPP_INCLUDED
+
+#include <cppcoro/net/socket.hpp>
+#include <cppcoro/cancellation_token.hpp>
+#include <cppcoro/task.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace cppcoro::net
+{
+	/// \brief
+	/// Reads messages from a stream socket through a receive buffer.
+	///
+	/// Each call to socket::recv() fills as much of the buffer as the data
+	/// available allows, and messages are then parsed out of the buffer
+	/// without further system calls. The read functions return views of
+	/// the message within the buffer rather than copying it out.
+	///
+	/// The buffer is used as a ring that is compacted rather than wrapped:
+	/// when there is no room left at the end, unread data is moved to the
+	/// start. Every message is therefore contiguous, at the cost of copying
+	/// the partial message at the end of the buffer, which is usually small.
+	///
+	/// A view returned by a read function is valid until the next call to
+	/// a read function or until the reader is destroyed. Only one read may
+	/// be outstanding at a time.
+	///
+	/// Read functions throw std::system_error with:
+	/// - std::errc::message_size if the message does not fit in the buffer.
+	/// - std::errc::connection_aborted if the peer closed the connection
+	///   part-way through a message.
+	/// - the error from socket::recv() if receiving failed.
+	class buffered_socket_reader
+	{
+	public:
+
+		/// \param socket
+		/// A connected stream socket. Must outlive the reader.
+		///
+		/// \param capacity
+		/// The size of the receive buffer, which limits the size of the
+		/// largest message that can be read.
+		explicit buffered_socket_reader(socket& socket, std::size_t capacity = 64 * 1024);
+
+		buffered_socket_reader(const buffered_socket_reader& other) = delete;
+		buffered_socket_reader& operator=(const buffered_socket_reader& other) = delete;
+
+		/// Read up to and including the next occurrence of \a delimiter.
+		///
+		/// \param delimiter
+		/// The non-empty sequence of characters that ends the message, eg. "\r\n".
+		///
+		/// \return
+		/// The message including the delimiter, or an empty view if the peer
+		/// closed the connection before sending any more data.
+		[[nodiscard]]
+		task<std::string_view> read_until(std::string_view delimiter, cancellation_token ct = {});
+
+		/// Read exactly \a size bytes.
+		///
+		/// \return
+		/// The next \a size bytes, or an empty view if the peer closed the
+		/// connection before sending any more data.
+		[[nodiscard]]
+		task<std::span<const std::byte>> read_exact(std::size_t size, cancellation_token ct = {});
+
+		/// Read a message that is preceded by its length, encoded as an
+		/// unsigned integer of type \a T in network byte order.
+		///
+		/// \return
+		/// The message, excluding the length prefix. An empty view is returned
+		/// either for a zero-length message or if the peer closed the
+		/// connection before sending any more data.
+		template<typename T>
+		[[nodiscard]]
+		task<std::span<const std::byte>> read_length_prefixed(cancellation_token ct = {});
+
+		/// The number of bytes received but not yet returned by a read.
+		std::size_t buffered_size() const noexcept { return m_end - m_begin; }
+
+		/// The size of the receive buffer.
+		std::size_t capacity() const noexcept { return m_capacity; }
+
+	private:
+
+		/// Receive until at least \a size bytes are buffered.
+		///
+		/// \return
+		/// false if \a eofAllowed and the peer closed the connection while
+		/// nothing was buffered.
+		task<bool> fill(std::size_t size, bool eofAllowed, cancellation_token ct);
+
+		/// Make room at the end of the buffer for at least \a size more bytes
+		/// by moving unread data to the start if needed.
+		void reserve(std::size_t size) noexcept;
+
+		std::byte* consume(std::size_t size) noexcept;
+
+		[[noreturn]] static void throw_message_too_large();
+		[[noreturn]] static void throw_connection_closed();
+
+		socket& m_socket;
+		std::unique_ptr<std::byte[]> m_buffer;
+		std::size_t m_capacity;
+
+		// Unread data is in [m_begin, m_end).
+		std::size_t m_begin;
+		std::size_t m_end;
+
+	};
+
+	template<typename T>
+	task<std::span<const std::byte>> buffered_socket_reader::read_length_prefixed(
+		cancellation_token ct)
+	{
+		static_assert(
+			std::is_integral_v<T> && std::is_unsigned_v<T>,
+			"The length prefix must be an unsigned integer type");
+
+		const bool received = co_await fill(sizeof(T), true, ct);
+		if (!received)
+		{
+			co_return std::span<const std::byte>{};
+		}
+
+		const std::byte* prefix = consume(sizeof(T));
+		std::uint64_t length = 0;
+		for (std::size_t i = 0; i < sizeof(T); ++i)
+		{
+			length = (length << 8) | std::to_integer<std::uint64_t>(prefix[i]);
+		}
+
+		if (length > m_capacity)
+		{
+			throw_message_too_large();
+		}
+
+		const auto size = static_cast<std::size_t>(length);
+		(void)co_await fill(size, false, std::move(ct));
+		co_return std::span<const std::byte>{ consume(size), size };
+	}
+}
+
+#endif
@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_NET_BUFFERED_SOCKET_WRITER_HPP_INCLUDED
+#define CPPCORO_NET_BUFFERED_SOCKET_WRITER_HPP_INCLUDED
+
+#include <cppcoro/net/socket.hpp>
+#include <cppcoro/cancellation_token.hpp>
+#include <cppcoro/task.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+namespace cppcoro::net
+{
+	/// \brief
+	/// Coalesces small writes to a stream socket into fewer, larger sends.
+	///
+	/// Writes are copied into a send buffer. The buffer is sent when it
+	/// reaches the high-water mark or when flush() is called. A write that
+	/// does not fit in the remaining space is sent together with the
+	/// buffered data in a single vectored send, without copying it.
+	///
+	/// Only one write or flush may be outstanding at a time. If a send fails
+	/// then the contents of the buffer are unspecified and the writer should
+	/// not be used again.
+	class buffered_socket_writer
+	{
+	public:
+
+		/// \param socket
+		/// A connected stream socket. Must outlive the writer.
+		///
+		/// \param highWaterMark
+		/// The size of the send buffer. The buffer is sent as soon as it is full.
+		explicit buffered_socket_writer(socket& socket, std::size_t highWaterMark = 16 * 1024);
+
+		buffered_socket_writer(const buffered_socket_writer& other) = delete;
+		buffered_socket_writer& operator=(const buffered_socket_writer& other) = delete;
+
+		/// Write data to the socket, buffering it if there is room.
+		///
+		/// \param data
+		/// The data to write. Must remain valid until the returned task completes.
+		///
+		/// \return
+		/// A task that completes once the data has been buffered or sent.
+		[[nodiscard]]
+		task<> write(const void* data, std::size_t size, cancellation_token ct = {});
+
+		[[nodiscard]]
+		task<> write(std::string_view data, cancellation_token ct = {})
+		{
+			return write(data.data(), data.size(), std::move(ct));
+		}
+
+		/// Send any buffered data.
+		[[nodiscard]]
+		task<> flush(cancellation_token ct = {});
+
+		/// The number of bytes written but not yet sent.
+		std::size_t buffered_size() const noexcept { return m_size; }
+
+		std::size_t high_water_mark() const noexcept { return m_capacity; }
+
+	private:
+
+		/// Send all of the data in \a buffers, however many sends that takes.
+		task<> send_all(const_buffer* buffers, std::size_t count, cancellation_token ct);
+
+		socket& m_socket;
+		std::unique_ptr<std::byte[]> m_buffer;
+		std::size_t m_capacity;
+		std::size_t m_size;
+
+	};
+}
+
+#endif
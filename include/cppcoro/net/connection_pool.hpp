@@ -0,0 +1,225 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_NET_CONNECTION_POOL_HPP_INCLUDED
+#define CPPCORO_NET_CONNECTION_POOL_HPP_INCLUDED
+
+#include <cppcoro/net/ip_endpoint.hpp>
+#include <cppcoro/net/socket.hpp>
+#include <cppcoro/cancellation_token.hpp>
+#include <cppcoro/single_consumer_event.hpp>
+#include <cppcoro/task.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace cppcoro
+{
+	class io_service;
+
+	namespace net
+	{
+		class connection_pool;
+
+		/// A connection acquired from a connection_pool.
+		///
+		/// The connection goes back to the pool when the pooled_connection
+		/// is destroyed or release() is called, ready to be handed out by a
+		/// later acquire(). Call discard() instead if the connection cannot be
+		/// reused, eg. because a request failed part-way through and the state
+		/// of the connection is not known.
+		class pooled_connection
+		{
+		public:
+
+			/// Construct an empty connection.
+			pooled_connection() noexcept
+				: m_pool(nullptr)
+			{}
+
+			pooled_connection(pooled_connection&& other) noexcept;
+
+			/// Releases the connection back to the pool.
+			~pooled_connection();
+
+			pooled_connection& operator=(pooled_connection&& other) noexcept;
+
+			pooled_connection(const pooled_connection& other) = delete;
+			pooled_connection& operator=(const pooled_connection& other) = delete;
+
+			/// Query whether this holds a connection.
+			explicit operator bool() const noexcept { return m_socket.has_value(); }
+
+			socket& get() noexcept { return *m_socket; }
+			socket& operator*() noexcept { return *m_socket; }
+			socket* operator->() noexcept { return &*m_socket; }
+
+			/// The end-point that the connection is connected to.
+			const ip_endpoint& remote_endpoint() const noexcept { return m_remoteEndPoint; }
+
+			/// Return the connection to the pool now.
+			void release() noexcept;
+
+			/// Close the connection rather than returning it to the pool.
+			void discard() noexcept;
+
+		private:
+
+			friend class connection_pool;
+
+			pooled_connection(
+				connection_pool& pool,
+				const ip_endpoint& remoteEndPoint,
+				socket&& connection) noexcept;
+
+			connection_pool* m_pool;
+			ip_endpoint m_remoteEndPoint;
+			std::optional<socket> m_socket;
+
+		};
+
+		/// \brief
+		/// Keeps TCP connections open between requests so that they can be
+		/// reused rather than paying for a handshake, and leaving a socket in
+		/// TIME_WAIT, on every request.
+		///
+		/// Connections are pooled per remote end-point. acquire() hands out an
+		/// idle connection to the end-point if there is one and otherwise
+		/// connects a new one.
+		///
+		/// Idle connections are checked lazily: when an idle connection is
+		/// about to be handed out it is dropped instead if it has been idle for
+		/// longer than the idle timeout, or if it has become readable, which
+		/// means that the peer has closed it or sent something unsolicited.
+		///
+		/// The number of connects in progress to each end-point is limited.
+		/// Once the limit is reached, acquire() waits for either a connection
+		/// to be released or a connect to complete.
+		///
+		/// All member functions may be called concurrently from any thread.
+		/// The pool must outlive the connections acquired from it.
+		class connection_pool
+		{
+		public:
+
+			/// \param ioSvc
+			/// The io_service that new connections are associated with.
+			///
+			/// \param maxIdlePerEndPoint
+			/// The most idle connections to keep open to each end-point. When a
+			/// connection is released while there are already this many, the
+			/// connection that has been idle the longest is closed.
+			///
+			/// \param maxConnectsPerEndPoint
+			/// The most connects that may be in progress to each end-point at once.
+			///
+			/// \param idleTimeout
+			/// How long a connection may be idle before it is no longer reused.
+			explicit connection_pool(
+				io_service& ioSvc,
+				std::size_t maxIdlePerEndPoint = 8,
+				std::size_t maxConnectsPerEndPoint = 4,
+				std::chrono::milliseconds idleTimeout = std::chrono::seconds(60));
+
+			/// Closes all of the idle connections.
+			///
+			/// There must be no acquire() operations outstanding.
+			~connection_pool();
+
+			connection_pool(const connection_pool& other) = delete;
+			connection_pool& operator=(const connection_pool& other) = delete;
+
+			/// Acquire a connection to the specified end-point, reusing an idle
+			/// connection if there is one.
+			///
+			/// \param ct
+			/// A cancellation token that can be used to cancel waiting for a
+			/// connect to be allowed or to complete. If cancelled, the task
+			/// completes by throwing cppcoro::operation_cancelled.
+			///
+			/// \return
+			/// A task that completes with the connection.
+			///
+			/// \throws std::system_error
+			/// If a new connection was needed and could not be made.
+			[[nodiscard]]
+			task<pooled_connection> acquire(ip_endpoint remoteEndPoint, cancellation_token ct = {});
+
+			/// The number of idle connections in the pool, to all end-points.
+			std::size_t idle_count() const noexcept;
+
+			/// Close all of the idle connections.
+			void close_idle() noexcept;
+
+		private:
+
+			friend class pooled_connection;
+
+			using clock = std::chrono::steady_clock;
+
+			struct idle_connection
+			{
+				socket m_socket;
+				clock::time_point m_releaseTime;
+			};
+
+			/// An acquire() that is waiting for a connection or for permission
+			/// to connect.
+			struct waiter
+			{
+				waiter* m_next = nullptr;
+				waiter* m_previous = nullptr;
+				std::optional<socket> m_connection;
+				bool m_mayConnect = false;
+				bool m_cancelled = false;
+				single_consumer_event m_event;
+			};
+
+			struct end_point_state
+			{
+				std::deque<idle_connection> m_idle;
+				std::size_t m_connectCount = 0;
+				waiter* m_waitersHead = nullptr;
+				waiter* m_waitersTail = nullptr;
+			};
+
+			enum class acquire_action { reuse, connect, wait };
+
+			/// Take a healthy idle connection, reserve a connect or queue \a w,
+			/// in that order of preference.
+			acquire_action try_acquire(const ip_endpoint& remoteEndPoint, waiter& w);
+
+			task<pooled_connection> connect(ip_endpoint remoteEndPoint, cancellation_token ct);
+
+			/// Called when a connect completes, successfully or not, to let a
+			/// waiter connect in its place.
+			void connect_finished(const ip_endpoint& remoteEndPoint) noexcept;
+
+			void release(const ip_endpoint& remoteEndPoint, socket&& connection) noexcept;
+
+			void cancel_wait(const ip_endpoint& remoteEndPoint, waiter& w) noexcept;
+
+			static waiter* pop_waiter(end_point_state& state) noexcept;
+
+			/// Query whether an idle connection can be used for another request.
+			static bool is_usable(socket& connection) noexcept;
+
+			io_service& m_ioService;
+			const std::size_t m_maxIdlePerEndPoint;
+			const std::size_t m_maxConnectsPerEndPoint;
+			const clock::duration m_idleTimeout;
+
+			mutable std::mutex m_mutex;
+			std::unordered_map<ip_endpoint, end_point_state> m_endPoints;
+			std::size_t m_idleCount;
+
+		};
+	}
+}
+
+#endif
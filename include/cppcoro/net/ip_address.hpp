@@ -9,6 +9,8 @@
 #include <cppcoro/net/ipv6_address.hpp>
 
 #include <cassert>
+#include <charconv>
+#include <cstddef>
 #include <optional>
 #include <string>
 
@@ -20,6 +22,8 @@ namespace cppcoro
 		{
 		public:
 
+			static constexpr std::size_t max_string_length = ipv6_address::max_string_length;
+
 			// Constructs to IPv4 address 0.0.0.0
 			ip_address() noexcept;
 
@@ -36,6 +40,10 @@ namespace cppcoro
 
 			std::string to_string() const;
 
+			// Write the same string as to_string() to [first, last) without allocating.
+			// Fails with std::errc::value_too_large if the buffer is too small.
+			std::to_chars_result to_chars(char* first, char* last) const noexcept;
+
 			static std::optional<ip_address> from_string(std::string_view string) noexcept;
 
 			bool operator==(const ip_address& rhs) const noexcept;
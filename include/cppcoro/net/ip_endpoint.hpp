@@ -10,6 +10,9 @@
 #include <cppcoro/net/ipv6_endpoint.hpp>
 
 #include <cassert>
+#include <charconv>
+#include <cstddef>
+#include <functional>
 #include <optional>
 #include <string>
 
@@ -21,6 +24,8 @@ namespace cppcoro
 		{
 		public:
 
+			static constexpr std::size_t max_string_length = ipv6_endpoint::max_string_length;
+
 			// Constructs to IPv4 end-point 0.0.0.0:0
 			ip_endpoint() noexcept;
 
@@ -38,6 +43,10 @@ namespace cppcoro
 
 			std::string to_string() const;
 
+			// Write the same string as to_string() to [first, last) without allocating.
+			// Fails with std::errc::value_too_large if the buffer is too small.
+			std::to_chars_result to_chars(char* first, char* last) const noexcept;
+
 			static std::optional<ip_endpoint> from_string(std::string_view string) noexcept;
 
 			bool operator==(const ip_endpoint& rhs) const noexcept;
@@ -158,4 +167,19 @@ namespace cppcoro
 	}
 }
 
+namespace std
+{
+	/// Hashes the same as the std::hash of the ipv4_endpoint or ipv6_endpoint.
+	template<>
+	struct hash<cppcoro::net::ip_endpoint>
+	{
+		std::size_t operator()(const cppcoro::net::ip_endpoint& endpoint) const noexcept
+		{
+			return endpoint.is_ipv4() ?
+				std::hash<cppcoro::net::ipv4_endpoint>{}(endpoint.to_ipv4()) :
+				std::hash<cppcoro::net::ipv6_endpoint>{}(endpoint.to_ipv6());
+		}
+	};
+}
+
 #endif
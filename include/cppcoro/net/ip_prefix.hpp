@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_NET_IP_PREFIX_HPP_INCLUDED
+#define CPPCORO_NET_IP_PREFIX_HPP_INCLUDED
+
+#include <cppcoro/net/ip_address.hpp>
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace cppcoro
+{
+	namespace net
+	{
+		/// An IP address prefix, or CIDR block, eg. "10.0.0.0/8" or "2001:db8::/32".
+		///
+		/// The bits of the address after the prefix length are always zero.
+		class ip_prefix
+		{
+		public:
+
+			// Longest string is an IPv6 address followed by "/128"
+			static constexpr std::size_t max_string_length = ip_address::max_string_length + 4;
+
+			// Constructs to the IPv4 prefix 0.0.0.0/0, which contains every IPv4 address.
+			ip_prefix() noexcept;
+
+			/// Construct the prefix made up of the first \a length bits of \a address.
+			///
+			/// The remaining bits of the address are cleared.
+			///
+			/// \param length
+			/// The prefix length in bits. Must be no more than 32 for an IPv4
+			/// address or 128 for an IPv6 address.
+			ip_prefix(const ip_address& address, std::uint8_t length) noexcept;
+
+			bool is_ipv4() const noexcept { return m_address.is_ipv4(); }
+			bool is_ipv6() const noexcept { return m_address.is_ipv6(); }
+
+			const ip_address& address() const noexcept { return m_address; }
+
+			std::uint8_t length() const noexcept { return m_length; }
+
+			/// Query whether \a address is in this prefix.
+			///
+			/// An IPv4 prefix never contains an IPv6 address and vice versa.
+			bool contains(const ip_address& address) const noexcept;
+
+			std::string to_string() const;
+
+			// Write the same string as to_string() to [first, last) without allocating.
+			// Fails with std::errc::value_too_large if the buffer is too small.
+			std::to_chars_result to_chars(char* first, char* last) const noexcept;
+
+			/// Parse a prefix of the form "address/length".
+			///
+			/// Bits of the address after the prefix length are cleared, so
+			/// "10.1.2.3/8" parses as "10.0.0.0/8".
+			///
+			/// \return
+			/// The prefix if successful, otherwise std::nullopt if the string
+			/// could not be parsed or the length is too long for the address.
+			static std::optional<ip_prefix> from_string(std::string_view string) noexcept;
+
+			bool operator==(const ip_prefix& rhs) const noexcept;
+			bool operator!=(const ip_prefix& rhs) const noexcept;
+
+			//  Sorts by address, then by length, so a prefix sorts before
+			//  the longer prefixes that it contains.
+			bool operator<(const ip_prefix& rhs) const noexcept;
+			bool operator>(const ip_prefix& rhs) const noexcept;
+			bool operator<=(const ip_prefix& rhs) const noexcept;
+			bool operator>=(const ip_prefix& rhs) const noexcept;
+
+		private:
+
+			ip_address m_address;
+			std::uint8_t m_length;
+
+		};
+
+		inline ip_prefix::ip_prefix() noexcept
+			: m_address()
+			, m_length(0)
+		{}
+
+		inline bool ip_prefix::operator==(const ip_prefix& rhs) const noexcept
+		{
+			return m_length == rhs.m_length && m_address == rhs.m_address;
+		}
+
+		inline bool ip_prefix::operator!=(const ip_prefix& rhs) const noexcept
+		{
+			return !(*this == rhs);
+		}
+
+		inline bool ip_prefix::operator<(const ip_prefix& rhs) const noexcept
+		{
+			if (m_address == rhs.m_address)
+			{
+				return m_length < rhs.m_length;
+			}
+
+			return m_address < rhs.m_address;
+		}
+
+		inline bool ip_prefix::operator>(const ip_prefix& rhs) const noexcept
+		{
+			return rhs < *this;
+		}
+
+		inline bool ip_prefix::operator<=(const ip_prefix& rhs) const noexcept
+		{
+			return !(rhs < *this);
+		}
+
+		inline bool ip_prefix::operator>=(const ip_prefix& rhs) const noexcept
+		{
+			return !(*this < rhs);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,337 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_NET_IP_PREFIX_TABLE_HPP_INCLUDED
+#define CPPCORO_NET_IP_PREFIX_TABLE_HPP_INCLUDED
+
+#include <cppcoro/detail/ip_prefix_trie.hpp>
+#include <cppcoro/net/ip_address.hpp>
+#include <cppcoro/net/ip_prefix.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace cppcoro
+{
+	namespace net
+	{
+		/// \brief
+		/// A table mapping IP prefixes to values, for looking up the value of
+		/// the longest prefix that contains an address.
+		///
+		/// eg. for ACLs or for routing by network, where a linear scan over the
+		/// prefixes would be too slow.
+		///
+		/// Lookups are made against an immutable snapshot of the table, so
+		/// they never wait for an update to be built and an update never
+		/// waits for lookups to finish, similar to RCU. Each update builds a
+		/// new snapshot and publishes it with a single atomic store;
+		/// the old snapshot is freed once the last lookup using it has
+		/// finished. This makes updates O(n) in the size of the table, so the
+		/// table suits data that is read far more often than it is written.
+		/// Use assign() or update() to make many changes at once.
+		///
+		/// Loading the current snapshot, as current() and lookup() do, updates
+		/// the reference count of a std::shared_ptr that every thread shares,
+		/// and so does not scale to many threads looking up at a high rate.
+		/// Hot paths should instead use a reader per thread, which holds on to
+		/// a snapshot and only loads a new one when the table has changed.
+		///
+		/// All member functions may be called concurrently from any thread.
+		template<typename VALUE>
+		class ip_prefix_table
+		{
+		public:
+
+			using value_type = std::pair<ip_prefix, VALUE>;
+
+			/// An immutable version of the table.
+			class snapshot
+			{
+			public:
+
+				/// Look up the value of the longest prefix containing \a address.
+				///
+				/// \return
+				/// A pointer to the value, valid for the lifetime of the
+				/// snapshot, or nullptr if no prefix contains the address.
+				const VALUE* lookup(const ip_address& address) const noexcept
+				{
+					const value_type* entry = longest_match(address);
+					return entry != nullptr ? &entry->second : nullptr;
+				}
+
+				/// Look up the longest prefix containing \a address, along with
+				/// its value.
+				const value_type* longest_match(const ip_address& address) const noexcept
+				{
+					const std::uint32_t index = m_trie.longest_match(address);
+					return index != detail::ip_prefix_trie::no_value ? &m_entries[index] : nullptr;
+				}
+
+				/// Find the value of exactly \a prefix.
+				const VALUE* find(const ip_prefix& prefix) const noexcept
+				{
+					auto it = std::lower_bound(
+						m_entries.begin(),
+						m_entries.end(),
+						prefix,
+						[](const value_type& entry, const ip_prefix& p) { return entry.first < p; });
+					return it != m_entries.end() && it->first == prefix ? &it->second : nullptr;
+				}
+
+				/// The entries in the table, sorted by prefix.
+				std::span<const value_type> entries() const noexcept { return m_entries; }
+
+				std::size_t size() const noexcept { return m_entries.size(); }
+
+				bool empty() const noexcept { return m_entries.empty(); }
+
+			private:
+
+				friend class ip_prefix_table;
+
+				/// \param entries
+				/// Must be sorted by prefix, with no duplicate prefixes.
+				explicit snapshot(std::vector<value_type>&& entries)
+					: m_entries(std::move(entries))
+				{
+					for (std::size_t i = 0; i < m_entries.size(); ++i)
+					{
+						m_trie.insert(m_entries[i].first, static_cast<std::uint32_t>(i));
+					}
+				}
+
+				std::vector<value_type> m_entries;
+				detail::ip_prefix_trie m_trie;
+
+			};
+
+			using snapshot_ptr = std::shared_ptr<const snapshot>;
+
+			/// Caches the current snapshot of a table for use by a single
+			/// thread.
+			///
+			/// Checking whether the table has changed only reads a counter
+			/// that is written when the table is updated, so lookups through
+			/// a reader don't contend with lookups on other threads.
+			/// The table must outlive the reader.
+			class reader
+			{
+			public:
+
+				explicit reader(const ip_prefix_table& table) noexcept
+					: m_table(&table)
+					, m_version(table.m_version.load(std::memory_order_acquire))
+					, m_snapshot(table.current())
+				{}
+
+				/// Get the current snapshot of the table, loading it again
+				/// only if the table has been updated since it was last loaded.
+				///
+				/// The snapshot remains valid until the next call to get() or
+				/// lookup() on this reader.
+				const snapshot& get() noexcept
+				{
+					const std::uint64_t version = m_table->m_version.load(std::memory_order_acquire);
+					if (version != m_version)
+					{
+						m_snapshot = m_table->current();
+						m_version = version;
+					}
+
+					return *m_snapshot;
+				}
+
+				/// Look up the value of the longest prefix containing \a address
+				/// in the current snapshot.
+				///
+				/// \return
+				/// A pointer to the value, valid until the next call to get() or
+				/// lookup() on this reader, or nullptr if no prefix contains the
+				/// address.
+				const VALUE* lookup(const ip_address& address) noexcept
+				{
+					return get().lookup(address);
+				}
+
+			private:
+
+				const ip_prefix_table* m_table;
+				std::uint64_t m_version;
+				snapshot_ptr m_snapshot;
+
+			};
+
+			/// Construct an empty table.
+			ip_prefix_table()
+				: m_current(build({}))
+				, m_version(0)
+			{}
+
+			/// Construct a table holding \a entries.
+			///
+			/// If a prefix appears more than once then the last value wins.
+			explicit ip_prefix_table(std::vector<value_type> entries)
+				: m_current(build(std::move(entries)))
+				, m_version(0)
+			{}
+
+			ip_prefix_table(const ip_prefix_table& other) = delete;
+			ip_prefix_table& operator=(const ip_prefix_table& other) = delete;
+
+			/// Get the current snapshot of the table.
+			///
+			/// Holding on to the snapshot keeps it, and any values looked up
+			/// from it, alive, and makes a series of lookups consistent.
+			/// See reader for looking up from many threads at a high rate.
+			snapshot_ptr current() const noexcept
+			{
+				return m_current.load(std::memory_order_acquire);
+			}
+
+			/// Look up the value of the longest prefix containing \a address in
+			/// the current snapshot.
+			///
+			/// This loads the current snapshot for each lookup. Use a reader
+			/// instead on hot paths.
+			///
+			/// \return
+			/// A copy of the value, or std::nullopt if no prefix contains the
+			/// address.
+			std::optional<VALUE> lookup(const ip_address& address) const
+			{
+				const snapshot_ptr s = current();
+				if (const VALUE* value = s->lookup(address); value != nullptr)
+				{
+					return *value;
+				}
+
+				return std::nullopt;
+			}
+
+			/// Replace the contents of the table with \a entries.
+			///
+			/// If a prefix appears more than once then the last value wins.
+			void assign(std::vector<value_type> entries)
+			{
+				std::lock_guard lock{ m_updateMutex };
+				publish(build(std::move(entries)));
+			}
+
+			/// Add \a prefix to the table, or replace its value if it is
+			/// already in the table.
+			void insert_or_assign(const ip_prefix& prefix, VALUE value)
+			{
+				update([&](std::vector<value_type>& entries)
+				{
+					entries.emplace_back(prefix, std::move(value));
+				});
+			}
+
+			/// Remove \a prefix from the table.
+			///
+			/// \return
+			/// true if the prefix was in the table.
+			bool erase(const ip_prefix& prefix)
+			{
+				bool erased = false;
+				update([&](std::vector<value_type>& entries)
+				{
+					const auto newEnd = std::remove_if(
+						entries.begin(),
+						entries.end(),
+						[&](const value_type& entry) { return entry.first == prefix; });
+					erased = newEnd != entries.end();
+					entries.erase(newEnd, entries.end());
+				});
+				return erased;
+			}
+
+			/// Remove all of the entries from the table.
+			void clear()
+			{
+				assign({});
+			}
+
+			/// Make a batch of changes to the table, publishing them as a single
+			/// new snapshot.
+			///
+			/// \param func
+			/// Called with a std::vector<value_type>& holding a copy of the
+			/// current entries, which it may modify in any way. If a prefix
+			/// appears more than once afterwards then the last value wins.
+			/// Calls to update() and the other modifiers are serialised, so
+			/// no changes are lost, but lookups continue against the previous
+			/// snapshot while \a func runs.
+			template<typename FUNC>
+			void update(FUNC&& func)
+			{
+				std::lock_guard lock{ m_updateMutex };
+				const snapshot_ptr s = m_current.load(std::memory_order_relaxed);
+				std::vector<value_type> entries{ s->m_entries.begin(), s->m_entries.end() };
+				func(entries);
+				publish(build(std::move(entries)));
+			}
+
+		private:
+
+			/// Must be called with m_updateMutex held.
+			void publish(snapshot_ptr s) noexcept
+			{
+				m_current.store(std::move(s), std::memory_order_release);
+
+				// Bumped after the store so that a reader that sees the new
+				// version is sure to load the new snapshot, or a later one.
+				m_version.fetch_add(1, std::memory_order_release);
+			}
+
+			static snapshot_ptr build(std::vector<value_type> entries)
+			{
+				// Stable so that, of entries with the same prefix, the last is
+				// the one that was added last.
+				std::stable_sort(
+					entries.begin(),
+					entries.end(),
+					[](const value_type& a, const value_type& b) { return a.first < b.first; });
+
+				std::size_t count = 0;
+				for (std::size_t i = 0; i < entries.size(); ++i)
+				{
+					// Keep only the last of a run of entries with the same prefix.
+					if (i + 1 < entries.size() && entries[i + 1].first == entries[i].first)
+					{
+						continue;
+					}
+
+					if (count != i)
+					{
+						entries[count] = std::move(entries[i]);
+					}
+
+					++count;
+				}
+
+				entries.erase(entries.begin() + count, entries.end());
+
+				return snapshot_ptr{ new snapshot{ std::move(entries) } };
+			}
+
+			std::mutex m_updateMutex;
+			std::atomic<snapshot_ptr> m_current;
+			std::atomic<std::uint64_t> m_version;
+
+		};
+	}
+}
+
+#endif
@@ -5,6 +5,8 @@
 #ifndef CPPCORO_NET_IPV4_ADDRESS_HPP_INCLUDED
 #define CPPCORO_NET_IPV4_ADDRESS_HPP_INCLUDED
 
+#include <charconv>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -18,6 +20,10 @@ namespace cppcoro::net
 
 	public:
 
+		/// The length of the longest string that to_chars() can produce,
+		/// eg. "255.255.255.255".
+		static constexpr std::size_t max_string_length = 15;
+
 		constexpr ipv4_address()
 			: m_bytes{ 0, 0, 0, 0 }
 		{}
@@ -124,6 +130,17 @@ namespace cppcoro::net
 		/// eg. "12.67.190.23"
 		std::string to_string() const;
 
+		/// Write the IP address in dotted decimal notation to the buffer
+		/// [first, last) without allocating.
+		///
+		/// \return
+		/// On success, 'ptr' points one past the last character written and
+		/// 'ec' is value-initialised. If the buffer is too small then 'ptr' is
+		/// 'last', 'ec' is std::errc::value_too_large and the contents of the
+		/// buffer are unspecified. Writing to a buffer of at least
+		/// max_string_length chars always succeeds.
+		std::to_chars_result to_chars(char* first, char* last) const noexcept;
+
 	private:
 
 		alignas(std::uint32_t) std::uint8_t m_bytes[4];
@@ -5,6 +5,8 @@
 #ifndef CPPCORO_NET_IPV6_ADDRESS_HPP_INCLUDED
 #define CPPCORO_NET_IPV6_ADDRESS_HPP_INCLUDED
 
+#include <charconv>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -20,6 +22,10 @@ namespace cppcoro::net
 
 	public:
 
+		/// The length of the longest string that to_chars() can produce,
+		/// ie. eight groups of four hex digits separated by ':'.
+		static constexpr std::size_t max_string_length = 39;
+
 		constexpr ipv6_address();
 
 		explicit constexpr ipv6_address(
@@ -81,6 +87,15 @@ namespace cppcoro::net
 		///   "102:304::3f:c447:ab99:1011"
 		std::string to_string() const;
 
+		/// Write the IP address in contracted string form, as produced by
+		/// to_string(), to the buffer [first, last) without allocating.
+		///
+		/// \return
+		/// On success, 'ptr' points one past the last character written and
+		/// 'ec' is value-initialised. If the buffer is too small then 'ptr' is
+		/// 'last' and 'ec' is std::errc::value_too_large.
+		std::to_chars_result to_chars(char* first, char* last) const noexcept;
+
 		constexpr bool operator==(const ipv6_address& other) const;
 		constexpr bool operator!=(const ipv6_address& other) const;
 		constexpr bool operator<(const ipv6_address& other) const;
@@ -5,8 +5,12 @@
 #ifndef CPPCORO_NET_IPV6_ENDPOINT_HPP_INCLUDED
 #define CPPCORO_NET_IPV6_ENDPOINT_HPP_INCLUDED
 
+#include <cppcoro/detail/ip_hash.hpp>
 #include <cppcoro/net/ipv6_address.hpp>
 
+#include <charconv>
+#include <cstddef>
+#include <functional>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -19,6 +23,9 @@ namespace cppcoro
 		{
 		public:
 
+			// Longest string is "[xxxx:...:xxxx]:ppppp"
+			static constexpr std::size_t max_string_length = ipv6_address::max_string_length + 8;
+
 			// Construct to [::]:0
 			ipv6_endpoint() noexcept
 				: m_address()
@@ -36,6 +43,10 @@ namespace cppcoro
 
 			std::string to_string() const;
 
+			// Write the same string as to_string() to [first, last) without allocating.
+			// Fails with std::errc::value_too_large if the buffer is too small.
+			std::to_chars_result to_chars(char* first, char* last) const noexcept;
+
 			static std::optional<ipv6_endpoint> from_string(std::string_view string) noexcept;
 
 		private:
@@ -79,4 +90,19 @@ namespace cppcoro
 	}
 }
 
+namespace std
+{
+	template<>
+	struct hash<cppcoro::net::ipv6_endpoint>
+	{
+		std::size_t operator()(const cppcoro::net::ipv6_endpoint& endpoint) const noexcept
+		{
+			return cppcoro::detail::hash_ipv6(
+				endpoint.address().subnet_prefix(),
+				endpoint.address().interface_identifier(),
+				endpoint.port());
+		}
+	};
+}
+
 #endif
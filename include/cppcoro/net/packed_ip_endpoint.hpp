@@ -0,0 +1,146 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_NET_PACKED_IP_ENDPOINT_HPP_INCLUDED
+#define CPPCORO_NET_PACKED_IP_ENDPOINT_HPP_INCLUDED
+
+#include <cppcoro/detail/ip_hash.hpp>
+#include <cppcoro/net/ip_endpoint.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+namespace cppcoro
+{
+	namespace net
+	{
+		/// \brief
+		/// A compact, trivially-copyable form of an ip_endpoint, for use as
+		/// the key of open-addressing hash tables.
+		///
+		/// It is 20 bytes with 4-byte alignment, against 32 bytes for an
+		/// ip_endpoint, and has no padding, so two packed end-points are
+		/// equal exactly when their bytes are equal.
+		///
+		/// The address is held in 16 bytes, with IPv4 addresses in their
+		/// IPv4-mapped IPv6 form, followed by the port and the family. The
+		/// family keeps an IPv4 end-point distinct from the IPv6 end-point
+		/// with the IPv4-mapped address.
+		class packed_ip_endpoint
+		{
+		public:
+
+			// Constructs to IPv4 end-point 0.0.0.0:0
+			packed_ip_endpoint() noexcept
+				: packed_ip_endpoint(ipv4_endpoint{})
+			{}
+
+			packed_ip_endpoint(const ipv4_endpoint& endpoint) noexcept
+				: m_words{
+					0,
+					0,
+					0x0000FFFFu,
+					endpoint.address().to_integer(),
+					detail::ip_hash_tail(detail::ip_hash_family::ipv4, endpoint.port()) }
+			{}
+
+			packed_ip_endpoint(const ipv6_endpoint& endpoint) noexcept
+				: m_words{
+					static_cast<std::uint32_t>(endpoint.address().subnet_prefix() >> 32),
+					static_cast<std::uint32_t>(endpoint.address().subnet_prefix()),
+					static_cast<std::uint32_t>(endpoint.address().interface_identifier() >> 32),
+					static_cast<std::uint32_t>(endpoint.address().interface_identifier()),
+					detail::ip_hash_tail(detail::ip_hash_family::ipv6, endpoint.port()) }
+			{}
+
+			packed_ip_endpoint(const ip_endpoint& endpoint) noexcept
+				: packed_ip_endpoint(endpoint.is_ipv4() ?
+					packed_ip_endpoint(endpoint.to_ipv4()) :
+					packed_ip_endpoint(endpoint.to_ipv6()))
+			{}
+
+			bool is_ipv4() const noexcept
+			{
+				return (m_words[4] >> 16) == static_cast<std::uint32_t>(detail::ip_hash_family::ipv4);
+			}
+
+			bool is_ipv6() const noexcept { return !is_ipv4(); }
+
+			std::uint16_t port() const noexcept { return static_cast<std::uint16_t>(m_words[4]); }
+
+			/// Unpack to an ip_endpoint.
+			ip_endpoint to_ip_endpoint() const noexcept
+			{
+				if (is_ipv4())
+				{
+					return ipv4_endpoint{ ipv4_address{ m_words[3] }, port() };
+				}
+
+				return ipv6_endpoint{ ipv6_address{ high(), low() }, port() };
+			}
+
+			/// Hash the end-point.
+			///
+			/// With the default seed this is the same as std::hash of the
+			/// unpacked ip_endpoint. It is cheap but not keyed, so a table
+			/// whose keys are chosen by untrusted peers should pass a seed
+			/// that is chosen at random when the table is created.
+			std::size_t hash(std::uint64_t seed = 0) const noexcept
+			{
+				return detail::hash_ip_words(high(), low(), m_words[4], seed);
+			}
+
+			bool operator==(const packed_ip_endpoint& rhs) const noexcept
+			{
+				return
+					m_words[0] == rhs.m_words[0] &&
+					m_words[1] == rhs.m_words[1] &&
+					m_words[2] == rhs.m_words[2] &&
+					m_words[3] == rhs.m_words[3] &&
+					m_words[4] == rhs.m_words[4];
+			}
+
+			bool operator!=(const packed_ip_endpoint& rhs) const noexcept
+			{
+				return !(*this == rhs);
+			}
+
+		private:
+
+			std::uint64_t high() const noexcept
+			{
+				return std::uint64_t(m_words[0]) << 32 | m_words[1];
+			}
+
+			std::uint64_t low() const noexcept
+			{
+				return std::uint64_t(m_words[2]) << 32 | m_words[3];
+			}
+
+			// The address as four 32-bit words, most-significant first,
+			// then the family in the high 16 bits and the port in the low 16.
+			std::uint32_t m_words[5];
+
+		};
+
+		static_assert(sizeof(packed_ip_endpoint) == 20);
+		static_assert(std::is_trivially_copyable_v<packed_ip_endpoint>);
+	}
+}
+
+namespace std
+{
+	template<>
+	struct hash<cppcoro::net::packed_ip_endpoint>
+	{
+		std::size_t operator()(const cppcoro::net::packed_ip_endpoint& endpoint) const noexcept
+		{
+			return endpoint.hash();
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,149 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_NET_RECV_BUFFER_POOL_HPP_INCLUDED
+#define CPPCORO_NET_RECV_BUFFER_POOL_HPP_INCLUDED
+
+#include <cppcoro/config.hpp>
+
+#if CPPCORO_OS_LINUX
+# include <cppcoro/detail/linux.hpp>
+
+# include <cstddef>
+# include <cstdint>
+# include <mutex>
+
+namespace cppcoro
+{
+	class io_service;
+
+	namespace net
+	{
+		class recv_buffer_pool;
+		class socket_recv_pooled_operation_impl;
+
+		/// A buffer leased from a recv_buffer_pool that holds the data received
+		/// by socket::recv(recv_buffer_pool&).
+		///
+		/// The buffer is given back to the pool when the lease is released or
+		/// destroyed, after which the kernel may receive new data into it.
+		class recv_buffer_lease
+		{
+		public:
+
+			/// Construct an empty lease that does not hold a buffer.
+			recv_buffer_lease() noexcept;
+
+			recv_buffer_lease(recv_buffer_lease&& other) noexcept;
+			recv_buffer_lease& operator=(recv_buffer_lease&& other) noexcept;
+
+			recv_buffer_lease(const recv_buffer_lease& other) = delete;
+			recv_buffer_lease& operator=(const recv_buffer_lease& other) = delete;
+
+			~recv_buffer_lease();
+
+			/// The data that was received, or nullptr if the lease is empty.
+			const std::byte* data() const noexcept;
+
+			/// The number of bytes that were received.
+			///
+			/// Zero if the lease is empty or the peer closed the connection.
+			std::size_t size() const noexcept { return m_size; }
+
+			/// Give the buffer back to the pool, leaving the lease empty.
+			void release() noexcept;
+
+		private:
+
+			friend class socket_recv_pooled_operation_impl;
+
+			recv_buffer_lease(
+				recv_buffer_pool& pool,
+				std::uint16_t bufferId,
+				std::size_t size) noexcept;
+
+			recv_buffer_pool* m_pool;
+			std::uint16_t m_bufferId;
+			std::size_t m_size;
+
+		};
+
+		/// A pool of equally sized buffers that socket receives can select a
+		/// buffer from when data arrives, rather than each pending receive
+		/// tying up a buffer of its own.
+		///
+		/// The buffers are registered with the io_service's io_uring as a ring
+		/// of provided buffers (IORING_REGISTER_PBUF_RING), which requires
+		/// Linux 5.19 or later.
+		///
+		/// A pool may be shared by any number of sockets associated with the
+		/// same io_service. All leases must be released before the pool is
+		/// destroyed.
+		class recv_buffer_pool
+		{
+		public:
+
+			/// Create a pool and register it with an io_service.
+			///
+			/// \param ioService
+			/// The io_service that the sockets receiving into the pool are
+			/// associated with.
+			///
+			/// \param bufferCount
+			/// The number of buffers in the pool. Must be a power of two no
+			/// larger than 32768.
+			///
+			/// \param bufferSize
+			/// The size of each buffer, which limits the number of bytes
+			/// received by a single operation.
+			///
+			/// \throw std::system_error
+			/// If the buffers could not be allocated or registered.
+			recv_buffer_pool(
+				io_service& ioService,
+				std::uint32_t bufferCount,
+				std::size_t bufferSize);
+
+			~recv_buffer_pool();
+
+			recv_buffer_pool(const recv_buffer_pool& other) = delete;
+			recv_buffer_pool& operator=(const recv_buffer_pool& other) = delete;
+
+			std::uint32_t buffer_count() const noexcept { return m_bufferCount; }
+			std::size_t buffer_size() const noexcept { return m_bufferSize; }
+
+		private:
+
+			friend class recv_buffer_lease;
+			friend class socket_recv_pooled_operation_impl;
+
+			std::byte* buffer(std::uint16_t bufferId) const noexcept
+			{
+				return m_buffers + std::size_t(bufferId) * m_bufferSize;
+			}
+
+			/// Add a buffer to the ring so that the kernel can select it.
+			void provide(std::uint16_t bufferId) noexcept;
+
+			detail::lnx::io_uring_queue& m_ioQueue;
+			const std::uint16_t m_groupId;
+			const std::uint32_t m_bufferCount;
+			const std::size_t m_bufferSize;
+
+			void* m_ring;
+			std::size_t m_ringSize;
+			std::byte* m_buffers;
+			std::size_t m_buffersSize;
+
+			// Protects m_ringTail and the ring entries.
+			std::mutex m_mutex;
+			std::uint16_t m_ringTail;
+
+		};
+	}
+}
+
+#endif
+
+#endif
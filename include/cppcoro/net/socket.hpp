@@ -13,18 +13,33 @@
 #include <cppcoro/net/socket_disconnect_operation.hpp>
 #include <cppcoro/net/socket_recv_operation.hpp>
 #include <cppcoro/net/socket_recv_from_operation.hpp>
+#include <cppcoro/net/socket_recv_from_many_operation.hpp>
+#include <cppcoro/net/socket_recv_pooled_operation.hpp>
+#include <cppcoro/net/socket_recv_vectored_operation.hpp>
 #include <cppcoro/net/socket_send_operation.hpp>
+#include <cppcoro/net/socket_send_file_operation.hpp>
 #include <cppcoro/net/socket_send_to_operation.hpp>
+#include <cppcoro/net/socket_send_to_many_operation.hpp>
+#include <cppcoro/net/socket_send_vectored_operation.hpp>
+#include <cppcoro/net/socket_send_fds_operation.hpp>
+#include <cppcoro/net/socket_recv_fds_operation.hpp>
+#include <cppcoro/net/unix_endpoint.hpp>
 
+#include <cppcoro/async_generator.hpp>
 #include <cppcoro/cancellation_token.hpp>
 
+#include <chrono>
+
 #if CPPCORO_OS_WINNT
 # include <cppcoro/detail/win32.hpp>
+#elif CPPCORO_OS_LINUX
+# include <cppcoro/detail/linux.hpp>
 #endif
 
 namespace cppcoro
 {
 	class io_service;
+	class readable_file;
 
 	namespace net
 	{
@@ -80,6 +95,28 @@ namespace cppcoro
 			/// If the socket could not be created for some reason.
 			static socket create_udpv6(io_service& ioSvc);
 
+#if CPPCORO_OS_LINUX
+			/// Create a Unix domain stream socket (AF_UNIX, SOCK_STREAM).
+			///
+			/// \param ioSvc
+			/// The I/O service the socket will use for dispatching I/O completion events.
+			///
+			/// \throws std::system_error
+			/// If the socket could not be created for some reason.
+			static socket create_unix_stream(io_service& ioSvc);
+
+			/// Create a Unix domain datagram socket (AF_UNIX, SOCK_DGRAM).
+			///
+			/// Connect it to the peer's end-point with connect() and then use
+			/// send() and recv() to exchange datagrams.
+			static socket create_unix_datagram(io_service& ioSvc);
+
+			/// Create a Unix domain sequenced-packet socket (AF_UNIX, SOCK_SEQPACKET),
+			/// which is connection-oriented like a stream socket but preserves
+			/// message boundaries like a datagram socket.
+			static socket create_unix_seqpacket(io_service& ioSvc);
+#endif
+
 			socket(socket&& other) noexcept;
 
 			/// Closes the socket, releasing any associated resources.
@@ -104,6 +141,12 @@ namespace cppcoro
 			/// operation completing synchronously or whether it should suspend the coroutine
 			/// and wait until the I/O completion event is dispatched to an I/O thread.
 			bool skip_completion_on_success() noexcept { return m_skipCompletionOnSuccess; }
+#elif CPPCORO_OS_LINUX
+			/// Get the file descriptor associated with this socket.
+			cppcoro::detail::lnx::fd_t native_handle() noexcept { return m_handle; }
+
+			/// Get the io_uring that I/O operations on this socket are submitted to.
+			cppcoro::detail::lnx::io_uring_queue& io_queue() noexcept;
 #endif
 
 			/// Get the address and port of the local end-point.
@@ -129,6 +172,32 @@ namespace cppcoro
 			/// If the socket could not be bound for some reason.
 			void bind(const ip_endpoint& localEndPoint);
 
+#if CPPCORO_OS_LINUX
+			/// Bind a Unix domain socket to the specified local end-point.
+			///
+			/// \param localEndPoint
+			/// The path or abstract name to bind to. Binding to an unnamed
+			/// end-point binds to a unique name in the abstract namespace.
+			/// Binding to a path fails with EADDRINUSE if the path exists.
+			///
+			/// \throws std::system_error
+			/// If the socket could not be bound for some reason.
+			void bind(const unix_endpoint& localEndPoint);
+
+			/// Get the end-point that a Unix domain socket is bound to.
+			///
+			/// \throws std::system_error
+			/// If the end-point could not be queried.
+			unix_endpoint local_unix_endpoint() const;
+
+			/// Get the end-point of the peer of a connected Unix domain socket.
+			/// This is unnamed if the peer has not been bound.
+			///
+			/// \throws std::system_error
+			/// If the end-point could not be queried.
+			unix_endpoint remote_unix_endpoint() const;
+#endif
+
 			/// Put the socket into a passive listening state that will start acknowledging
 			/// and queueing up new connections ready to be accepted by a call to 'accept()'.
 			///
@@ -152,6 +221,99 @@ namespace cppcoro
 			/// If the socket could not be placed into a listening mode.
 			void listen(std::uint32_t backlog);
 
+			// Socket options.
+			//
+			// The setters throw std::system_error if the option could not be
+			// set, as do the getters if it could not be read.
+			//
+			// Options that only tune performance (busy polling, quick acks,
+			// corking and the incoming CPU) are ignored on platforms that
+			// don't support them, and their getters return the default value.
+			// Options that change behaviour throw std::system_error with
+			// std::errc::operation_not_supported on such platforms instead.
+
+			/// Disable Nagle's algorithm (TCP_NODELAY) so that small writes are
+			/// sent immediately rather than being coalesced.
+			void set_tcp_no_delay(bool enabled);
+			bool tcp_no_delay() const;
+
+			/// Allow several sockets to bind to the same address and port
+			/// (SO_REUSEPORT), with the kernel distributing incoming connections
+			/// or datagrams between them. Must be set before bind().
+			///
+			/// Not supported on Windows.
+			void set_reuse_port(bool enabled);
+			bool reuse_port() const;
+
+			/// Set the size of the kernel's receive buffer (SO_RCVBUF).
+			///
+			/// The kernel may adjust the size. Linux doubles it to allow for
+			/// bookkeeping overhead and reports the doubled value.
+			void set_receive_buffer_size(std::size_t size);
+			std::size_t receive_buffer_size() const;
+
+			/// Set the size of the kernel's send buffer (SO_SNDBUF).
+			///
+			/// The kernel may adjust the size. Linux doubles it to allow for
+			/// bookkeeping overhead and reports the doubled value.
+			void set_send_buffer_size(std::size_t size);
+			std::size_t send_buffer_size() const;
+
+			/// Busy poll the device queue for up to \a duration when a receive
+			/// would otherwise block (SO_BUSY_POLL), trading CPU for latency.
+			/// Zero disables busy polling.
+			///
+			/// Linux only. Increasing the value may require CAP_NET_ADMIN.
+			void set_busy_poll(std::chrono::microseconds duration);
+			std::chrono::microseconds busy_poll() const;
+
+			/// Send acknowledgements immediately rather than delaying them
+			/// (TCP_QUICKACK).
+			///
+			/// Linux only. The kernel may leave quick ack mode again by itself
+			/// so this needs setting again after each receive to be sure that
+			/// it stays in effect.
+			void set_tcp_quick_ack(bool enabled);
+			bool tcp_quick_ack() const;
+
+			/// Hold back partial frames until the option is cleared or a full
+			/// frame is queued (TCP_CORK), so that a message written in pieces
+			/// goes out in as few segments as possible.
+			///
+			/// Linux only.
+			void set_tcp_cork(bool enabled);
+			bool tcp_cork() const;
+
+			/// Accept data in the SYN of incoming connections (TCP_FASTOPEN).
+			/// Must be set on a listening socket before listen().
+			///
+			/// \param queueLength
+			/// The maximum number of pending fast open requests. Zero disables
+			/// fast open. Windows only supports enabling or disabling it, so
+			/// any non-zero length just enables it there.
+			void set_tcp_fast_open(std::uint32_t queueLength);
+
+			/// Query whether fast open is enabled on a listening socket.
+			///
+			/// This only reports whether it is enabled, rather than the queue
+			/// length, so that it means the same on every platform.
+			bool tcp_fast_open() const;
+
+			/// Send the first data of an outgoing connection in its SYN if the
+			/// peer supports it (TCP_FASTOPEN_CONNECT on Linux, TCP_FASTOPEN
+			/// on Windows). Must be set before connect().
+			void set_tcp_fast_open_connect(bool enabled);
+			bool tcp_fast_open_connect() const;
+
+			/// Set the CPU whose receive queue should handle this socket's
+			/// packets (SO_INCOMING_CPU), so that a socket can be handled by the
+			/// thread running on the CPU that its packets arrive on.
+			///
+			/// Linux only. incoming_cpu() returns the CPU that last received a
+			/// packet for the socket, or -1 if that is not known.
+			void set_incoming_cpu(int cpu);
+			int incoming_cpu() const;
+
 			/// Connect the socket to the specified remote end-point.
 			///
 			/// The socket must be in a bound but unconnected state prior to this call.
@@ -185,6 +347,20 @@ namespace cppcoro
 				const ip_endpoint& remoteEndPoint,
 				cancellation_token ct) noexcept;
 
+#if CPPCORO_OS_LINUX
+			/// Connect a Unix domain socket to the socket bound to \a remoteEndPoint.
+			///
+			/// \return
+			/// An awaitable object that must be co_await'ed to perform the connect
+			/// operation. The result of the co_await expression is type void.
+			[[nodiscard]]
+			socket_connect_operation connect(const unix_endpoint& remoteEndPoint) noexcept;
+			[[nodiscard]]
+			socket_connect_operation_cancellable connect(
+				const unix_endpoint& remoteEndPoint,
+				cancellation_token ct) noexcept;
+#endif
+
 			[[nodiscard]]
 			socket_accept_operation accept(socket& acceptingSocket) noexcept;
 			[[nodiscard]]
@@ -192,6 +368,38 @@ namespace cppcoro
 				socket& acceptingSocket,
 				cancellation_token ct) noexcept;
 
+			/// Accept connections on a listening socket as they arrive.
+			///
+			/// On Linux a single multishot accept is kept armed for the lifetime
+			/// of the stream rather than submitting a new accept for each
+			/// connection, which needs Linux 5.19. On older kernels, and on
+			/// Windows, this falls back to calling accept() in a loop.
+			///
+			/// Connections accepted ahead of the consumer are queued, up to a
+			/// limit of 64. Once the limit is reached the multishot accept is
+			/// stopped and further connections wait in the listen backlog
+			/// until the consumer has taken every queued connection. A few
+			/// more than 64 may be queued if they were already accepted when
+			/// the accept was stopped.
+			///
+			/// \param ioSvc
+			/// The io_service to associate the accepted sockets with.
+			///
+			/// \param ct
+			/// A cancellation token that can be used to stop accepting connections.
+			/// The stream then completes by throwing cppcoro::operation_cancelled.
+			///
+			/// \return
+			/// A sequence of the accepted connections that never completes on its
+			/// own. Connections accepted but not yet consumed when the stream is
+			/// destroyed are closed.
+			///
+			/// \throws std::system_error
+			/// If accepting a connection failed.
+			async_generator<socket> accept_stream(
+				io_service& ioSvc,
+				cancellation_token ct = {});
+
 			[[nodiscard]]
 			socket_disconnect_operation disconnect() noexcept;
 			[[nodiscard]]
@@ -207,6 +415,59 @@ namespace cppcoro
 				std::size_t size,
 				cancellation_token ct) noexcept;
 
+			/// Send data gathered from several buffers with a single system call.
+			///
+			/// \param buffers
+			/// The buffers to send, in order. The buffers must remain valid
+			/// until the operation completes. On Linux at most 1024 buffers
+			/// are sent per call.
+			///
+			/// \return
+			/// An awaitable object that will start the operation when co_await'ed.
+			/// The result of the co_await expression is the total number of bytes
+			/// sent, which, like send(), may be less than the total size of the
+			/// buffers.
+			[[nodiscard]]
+			socket_send_vectored_operation send(
+				std::span<const const_buffer> buffers) noexcept;
+			[[nodiscard]]
+			socket_send_vectored_operation_cancellable send(
+				std::span<const const_buffer> buffers,
+				cancellation_token ct) noexcept;
+
+			/// Send the contents of a range of a file to the connected peer.
+			///
+			/// The data is transferred from the file to the socket by the
+			/// operating system (TransmitFile() on Windows) without being
+			/// copied through a user-space buffer.
+			///
+			/// \param file
+			/// The file to send data from. The file must remain open until the
+			/// operation completes.
+			///
+			/// \param offset
+			/// The offset within the file of the first byte to send.
+			///
+			/// \param size
+			/// The number of bytes to send.
+			///
+			/// \return
+			/// An awaitable object that will start the operation when co_await'ed.
+			/// The result of the co_await expression is the number of bytes sent,
+			/// which, like send(), may be less than \a size. Zero is returned if
+			/// \a offset is at or past the end of the file.
+			[[nodiscard]]
+			socket_send_file_operation send_file(
+				readable_file& file,
+				std::uint64_t offset,
+				std::size_t size) noexcept;
+			[[nodiscard]]
+			socket_send_file_operation_cancellable send_file(
+				readable_file& file,
+				std::uint64_t offset,
+				std::size_t size,
+				cancellation_token ct) noexcept;
+
 			[[nodiscard]]
 			socket_recv_operation recv(
 				void* buffer,
@@ -217,6 +478,27 @@ namespace cppcoro
 				std::size_t size,
 				cancellation_token ct) noexcept;
 
+			/// Receive data scattered across several buffers with a single
+			/// system call.
+			///
+			/// \param buffers
+			/// The buffers to receive into, in order. Each buffer is filled
+			/// before any data is written to the next. The buffers must remain
+			/// valid until the operation completes. On Linux at most 1024
+			/// buffers are received into per call.
+			///
+			/// \return
+			/// An awaitable object that will start the operation when co_await'ed.
+			/// The result of the co_await expression is the total number of bytes
+			/// received. Zero is returned if the peer closed the connection.
+			[[nodiscard]]
+			socket_recv_vectored_operation recv(
+				std::span<const mutable_buffer> buffers) noexcept;
+			[[nodiscard]]
+			socket_recv_vectored_operation_cancellable recv(
+				std::span<const mutable_buffer> buffers,
+				cancellation_token ct) noexcept;
+
 			[[nodiscard]]
 			socket_recv_from_operation recv_from(
 				void* buffer,
@@ -239,6 +521,218 @@ namespace cppcoro
 				std::size_t size,
 				cancellation_token ct) noexcept;
 
+#if CPPCORO_OS_LINUX
+			/// Receive a batch of datagrams with a single system call.
+			///
+			/// Waits until at least one datagram is available and then receives
+			/// as many of the queued datagrams as there are buffers, up to 1024.
+			///
+			/// \param buffers
+			/// The buffers to receive the datagrams into, one datagram per buffer.
+			/// The 'bytesReceived', 'source' and 'truncated' fields of each buffer
+			/// that received a datagram are set when the operation completes.
+			/// The buffers must remain valid until the operation completes.
+			///
+			/// \return
+			/// An awaitable object that will start the operation when co_await'ed.
+			/// The result of the co_await expression is the number of datagrams
+			/// received, which is the number of leading buffers that were filled.
+			[[nodiscard]]
+			socket_recv_from_many_operation recv_from_many(
+				std::span<datagram_buffer> buffers) noexcept;
+			[[nodiscard]]
+			socket_recv_from_many_operation_cancellable recv_from_many(
+				std::span<datagram_buffer> buffers,
+				cancellation_token ct) noexcept;
+
+			/// Send a batch of datagrams with a single system call.
+			///
+			/// \param datagrams
+			/// The datagrams to send, each to its own destination. At most 1024
+			/// are sent per call. The datagrams and their buffers must remain
+			/// valid until the operation completes.
+			///
+			/// \return
+			/// An awaitable object that will start the operation when co_await'ed.
+			/// The result of the co_await expression is the number of leading
+			/// datagrams that were sent, which may be less than the number given.
+			[[nodiscard]]
+			socket_send_to_many_operation send_to_many(
+				std::span<const datagram> datagrams) noexcept;
+			[[nodiscard]]
+			socket_send_to_many_operation_cancellable send_to_many(
+				std::span<const datagram> datagrams,
+				cancellation_token ct) noexcept;
+
+			/// Send a buffer as a series of datagrams of a fixed size using UDP
+			/// generic segmentation offload (UDP_SEGMENT).
+			///
+			/// The kernel, or the network card if it supports it, splits the
+			/// buffer into datagrams so that the whole buffer is sent with one
+			/// pass through the network stack.
+			///
+			/// \param destination
+			/// The address and port to send all of the datagrams to.
+			///
+			/// \param buffer
+			/// The data to send. Its size must not exceed 64KB or 64 segments.
+			///
+			/// \param segmentSize
+			/// The size of each datagram. The last datagram is shorter if the
+			/// size of the buffer is not a multiple of this.
+			///
+			/// \return
+			/// An awaitable object that will start the operation when co_await'ed.
+			/// The result of the co_await expression is the number of bytes sent.
+			[[nodiscard]]
+			socket_send_to_operation send_to_segmented(
+				const ip_endpoint& destination,
+				const void* buffer,
+				std::size_t size,
+				std::uint16_t segmentSize) noexcept;
+			[[nodiscard]]
+			socket_send_to_operation_cancellable send_to_segmented(
+				const ip_endpoint& destination,
+				const void* buffer,
+				std::size_t size,
+				std::uint16_t segmentSize,
+				cancellation_token ct) noexcept;
+
+			/// Enable or disable UDP generic receive offload (UDP_GRO).
+			///
+			/// While enabled, datagrams of the same size from the same source may
+			/// be received coalesced into a single buffer. Use recv_from_segmented()
+			/// rather than recv_from() to find out where the datagrams are split.
+			///
+			/// \throws std::system_error
+			/// If the option could not be set.
+			void set_udp_gro(bool enabled);
+
+			/// Receive a datagram, or a series of coalesced datagrams if
+			/// UDP_GRO is enabled.
+			///
+			/// \return
+			/// An awaitable object that will start the operation when co_await'ed.
+			/// The result of the co_await expression is a tuple of the number of
+			/// bytes received, the source end-point and the size of each datagram
+			/// that the data is made up of. All of the datagrams are that size
+			/// apart from the last, which may be shorter.
+			[[nodiscard]]
+			socket_recv_from_segmented_operation recv_from_segmented(
+				void* buffer,
+				std::size_t size) noexcept;
+			[[nodiscard]]
+			socket_recv_from_segmented_operation_cancellable recv_from_segmented(
+				void* buffer,
+				std::size_t size,
+				cancellation_token ct) noexcept;
+
+			/// Receive data into a buffer selected from a pool when the data
+			/// arrives, rather than into a buffer supplied up front.
+			///
+			/// \param pool
+			/// The pool to select the buffer from. Must have been created with
+			/// the io_service that this socket is associated with.
+			///
+			/// \return
+			/// An awaitable object that will start the operation when co_await'ed.
+			/// The result of the co_await expression is a lease on the buffer
+			/// holding the received data, which is given back to the pool when
+			/// the lease is destroyed. The lease has a size of zero if the peer
+			/// closed the connection. Fails with ENOBUFS if every buffer in the
+			/// pool is leased.
+			[[nodiscard]]
+			socket_recv_pooled_operation recv(
+				recv_buffer_pool& pool) noexcept;
+			[[nodiscard]]
+			socket_recv_pooled_operation_cancellable recv(
+				recv_buffer_pool& pool,
+				cancellation_token ct) noexcept;
+
+			/// Send data without copying it into the socket's send buffer
+			/// (IORING_OP_SEND_ZC).
+			///
+			/// The kernel sends the data straight from \a buffer, so the
+			/// operation does not complete until the kernel has finished with
+			/// the buffer, which may be after the data has been acknowledged
+			/// by the peer. Only worthwhile for large buffers. Falls back to a
+			/// normal send on kernels older than Linux 6.0.
+			///
+			/// \return
+			/// An awaitable object that will start the operation when co_await'ed.
+			/// The result of the co_await expression is the number of bytes sent,
+			/// which, like send(), may be less than \a size.
+			[[nodiscard]]
+			socket_send_zero_copy_operation send_zero_copy(
+				const void* buffer,
+				std::size_t size) noexcept;
+			[[nodiscard]]
+			socket_send_zero_copy_operation_cancellable send_zero_copy(
+				const void* buffer,
+				std::size_t size,
+				cancellation_token ct) noexcept;
+
+			/// Send data on a Unix domain socket along with open file descriptors
+			/// (SCM_RIGHTS).
+			///
+			/// The peer receives duplicates of the file descriptors that refer to
+			/// the same open files, so, for example, a memfd can be used to share
+			/// a large buffer between processes without copying it through the
+			/// socket.
+			///
+			/// \param buffer
+			/// The data to send with the file descriptors. This must not be
+			/// empty for a stream socket, as the descriptors are attached to
+			/// the data.
+			///
+			/// \param fds
+			/// The file descriptors to send, at most max_fds_per_message. They
+			/// remain open in this process and can be closed as soon as the
+			/// operation completes.
+			///
+			/// \return
+			/// An awaitable object that will start the operation when co_await'ed.
+			/// The result of the co_await expression is the number of bytes sent.
+			/// The file descriptors are sent with the first of them.
+			[[nodiscard]]
+			socket_send_fds_operation send_fds(
+				const void* buffer,
+				std::size_t size,
+				std::span<const int> fds) noexcept;
+			[[nodiscard]]
+			socket_send_fds_operation_cancellable send_fds(
+				const void* buffer,
+				std::size_t size,
+				std::span<const int> fds,
+				cancellation_token ct) noexcept;
+
+			/// Receive data on a Unix domain socket along with any file
+			/// descriptors sent with it by send_fds().
+			///
+			/// \param fds
+			/// Receives the file descriptors. The caller takes ownership of them
+			/// and must close them. They are opened with FD_CLOEXEC set.
+			///
+			/// \return
+			/// An awaitable object that will start the operation when co_await'ed.
+			/// The result of the co_await expression is a tuple of the number of
+			/// bytes received and the number of file descriptors received into
+			/// the leading elements of \a fds. Fails with EMSGSIZE if more file
+			/// descriptors were sent than \a fds has room for, in which case all
+			/// of the file descriptors are closed.
+			[[nodiscard]]
+			socket_recv_fds_operation recv_fds(
+				void* buffer,
+				std::size_t size,
+				std::span<int> fds) noexcept;
+			[[nodiscard]]
+			socket_recv_fds_operation_cancellable recv_fds(
+				void* buffer,
+				std::size_t size,
+				std::span<int> fds,
+				cancellation_token ct) noexcept;
+#endif
+
 			void close_send();
 			void close_recv();
 
@@ -251,11 +745,18 @@ namespace cppcoro
 			explicit socket(
 				cppcoro::detail::win32::socket_t handle,
 				bool skipCompletionOnSuccess) noexcept;
+#elif CPPCORO_OS_LINUX
+			explicit socket(
+				cppcoro::detail::lnx::fd_t handle,
+				io_service& ioService) noexcept;
 #endif
 
 #if CPPCORO_OS_WINNT
 			cppcoro::detail::win32::socket_t m_handle;
 			bool m_skipCompletionOnSuccess;
+#elif CPPCORO_OS_LINUX
+			cppcoro::detail::lnx::fd_t m_handle;
+			io_service* m_ioService;
 #endif
 
 			ip_endpoint m_localEndPoint;
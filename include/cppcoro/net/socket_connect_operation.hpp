@@ -90,6 +90,113 @@ namespace cppcoro
 	}
 }
 
-#endif // CPPCORO_OS_WINNT
+#elif CPPCORO_OS_LINUX
+# include <cppcoro/detail/linux.hpp>
+# include <cppcoro/detail/linux_io_uring_operation.hpp>
+# include <cppcoro/net/unix_endpoint.hpp>
+
+namespace cppcoro
+{
+	namespace net
+	{
+		class socket;
+
+		class socket_connect_operation_impl
+		{
+		public:
+
+			socket_connect_operation_impl(
+				socket& socket,
+				const ip_endpoint& remoteEndPoint) noexcept
+				: m_socket(socket)
+				, m_remoteEndPoint(remoteEndPoint)
+				, m_remoteAddressLength(0)
+			{}
+
+			socket_connect_operation_impl(
+				socket& socket,
+				const unix_endpoint& remoteEndPoint) noexcept;
+
+			bool try_start(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+			void cancel(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+			void get_result(cppcoro::detail::io_uring_operation_base& operation);
+
+		private:
+
+			socket& m_socket;
+			ip_endpoint m_remoteEndPoint;
+			cppcoro::detail::lnx::sockaddr_storage_t m_remoteAddress;
+
+			// Zero until the remote address has been filled in, which for an
+			// IP end-point is deferred until the operation is started. -1 if
+			// the path of a Unix domain end-point is too long.
+			int m_remoteAddressLength;
+
+		};
+
+		class socket_connect_operation
+			: public cppcoro::detail::io_uring_operation<socket_connect_operation>
+		{
+		public:
+
+			socket_connect_operation(
+				socket& socket,
+				const ip_endpoint& remoteEndPoint) noexcept
+				: m_impl(socket, remoteEndPoint)
+			{}
+
+			socket_connect_operation(
+				socket& socket,
+				const unix_endpoint& remoteEndPoint) noexcept
+				: m_impl(socket, remoteEndPoint)
+			{}
+
+		private:
+
+			friend class cppcoro::detail::io_uring_operation<socket_connect_operation>;
+
+			bool try_start() noexcept { return m_impl.try_start(*this); }
+			decltype(auto) get_result() { return m_impl.get_result(*this); }
+
+			socket_connect_operation_impl m_impl;
+
+		};
+
+		class socket_connect_operation_cancellable
+			: public cppcoro::detail::io_uring_operation_cancellable<socket_connect_operation_cancellable>
+		{
+		public:
+
+			socket_connect_operation_cancellable(
+				socket& socket,
+				const ip_endpoint& remoteEndPoint,
+				cancellation_token&& ct) noexcept
+				: cppcoro::detail::io_uring_operation_cancellable<socket_connect_operation_cancellable>(std::move(ct))
+				, m_impl(socket, remoteEndPoint)
+			{}
+
+			socket_connect_operation_cancellable(
+				socket& socket,
+				const unix_endpoint& remoteEndPoint,
+				cancellation_token&& ct) noexcept
+				: cppcoro::detail::io_uring_operation_cancellable<socket_connect_operation_cancellable>(std::move(ct))
+				, m_impl(socket, remoteEndPoint)
+			{}
+
+		private:
+
+			friend class cppcoro::detail::io_uring_operation_cancellable<socket_connect_operation_cancellable>;
+
+			bool try_start() noexcept { return m_impl.try_start(*this); }
+			void cancel() noexcept { m_impl.cancel(*this); }
+			void get_result() { m_impl.get_result(*this); }
+
+			socket_connect_operation_impl m_impl;
+
+		};
+	}
+}
+
+#endif
 
 #endif
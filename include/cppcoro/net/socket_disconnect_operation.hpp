@@ -80,6 +80,78 @@ namespace cppcoro
 	}
 }
 
-#endif // CPPCORO_OS_WINNT
+#elif CPPCORO_OS_LINUX
+# include <cppcoro/detail/linux.hpp>
+# include <cppcoro/detail/linux_io_uring_operation.hpp>
+
+namespace cppcoro
+{
+	namespace net
+	{
+		class socket;
+
+		class socket_disconnect_operation_impl
+		{
+		public:
+
+			socket_disconnect_operation_impl(socket& socket) noexcept
+				: m_socket(socket)
+			{}
+
+			bool try_start(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+			void cancel(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+			void get_result(cppcoro::detail::io_uring_operation_base& operation);
+
+		private:
+
+			socket& m_socket;
+
+		};
+
+		class socket_disconnect_operation
+			: public cppcoro::detail::io_uring_operation<socket_disconnect_operation>
+		{
+		public:
+
+			socket_disconnect_operation(socket& socket) noexcept
+				: m_impl(socket)
+			{}
+
+		private:
+
+			friend class cppcoro::detail::io_uring_operation<socket_disconnect_operation>;
+
+			bool try_start() noexcept { return m_impl.try_start(*this); }
+			void get_result() { m_impl.get_result(*this); }
+
+			socket_disconnect_operation_impl m_impl;
+
+		};
+
+		class socket_disconnect_operation_cancellable
+			: public cppcoro::detail::io_uring_operation_cancellable<socket_disconnect_operation_cancellable>
+		{
+		public:
+
+			socket_disconnect_operation_cancellable(socket& socket, cancellation_token&& ct) noexcept
+				: cppcoro::detail::io_uring_operation_cancellable<socket_disconnect_operation_cancellable>(std::move(ct))
+				, m_impl(socket)
+			{}
+
+		private:
+
+			friend class cppcoro::detail::io_uring_operation_cancellable<socket_disconnect_operation_cancellable>;
+
+			bool try_start() noexcept { return m_impl.try_start(*this); }
+			void cancel() noexcept { m_impl.cancel(*this); }
+			void get_result() { m_impl.get_result(*this); }
+
+			socket_disconnect_operation_impl m_impl;
+
+		};
+	}
+}
+
+#endif
 
 #endif
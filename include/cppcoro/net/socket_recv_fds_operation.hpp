@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_NET_SOCKET_RECV_FDS_OPERATION_HPP_INCLUDED
+#define CPPCORO_NET_SOCKET_RECV_FDS_OPERATION_HPP_INCLUDED
+
+#include <cppcoro/config.hpp>
+#include <cppcoro/cancellation_token.hpp>
+#include <cppcoro/net/socket_send_fds_operation.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <tuple>
+
+#if CPPCORO_OS_LINUX
+# include <cppcoro/detail/linux.hpp>
+# include <cppcoro/detail/linux_io_uring_operation.hpp>
+
+namespace cppcoro::net
+{
+	class socket;
+
+	class socket_recv_fds_operation_impl
+	{
+	public:
+
+		socket_recv_fds_operation_impl(
+			socket& s,
+			void* buffer,
+			std::size_t byteCount,
+			std::span<int> fds) noexcept
+			: m_socket(s)
+			, m_buffer{ buffer, byteCount }
+			, m_fds(fds)
+		{}
+
+		bool try_start(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+		void cancel(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+		std::tuple<std::size_t, std::size_t> get_result(
+			cppcoro::detail::io_uring_operation_base& operation);
+
+	private:
+
+		socket& m_socket;
+		cppcoro::detail::lnx::iovec_t m_buffer;
+		std::span<int> m_fds;
+		cppcoro::detail::lnx::msghdr_t m_message;
+
+		// Space for an SCM_RIGHTS control message holding max_fds_per_message
+		// descriptors, ie. CMSG_SPACE(max_fds_per_message * sizeof(int)).
+		alignas(8) std::uint8_t m_control[16 + max_fds_per_message * sizeof(int)];
+
+	};
+
+	class socket_recv_fds_operation
+		: public cppcoro::detail::io_uring_operation<socket_recv_fds_operation>
+	{
+	public:
+
+		socket_recv_fds_operation(
+			socket& s,
+			void* buffer,
+			std::size_t byteCount,
+			std::span<int> fds) noexcept
+			: m_impl(s, buffer, byteCount, fds)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation<socket_recv_fds_operation>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+		decltype(auto) get_result() { return m_impl.get_result(*this); }
+
+		socket_recv_fds_operation_impl m_impl;
+
+	};
+
+	class socket_recv_fds_operation_cancellable
+		: public cppcoro::detail::io_uring_operation_cancellable<socket_recv_fds_operation_cancellable>
+	{
+	public:
+
+		socket_recv_fds_operation_cancellable(
+			socket& s,
+			void* buffer,
+			std::size_t byteCount,
+			std::span<int> fds,
+			cancellation_token&& ct) noexcept
+			: cppcoro::detail::io_uring_operation_cancellable<socket_recv_fds_operation_cancellable>(std::move(ct))
+			, m_impl(s, buffer, byteCount, fds)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation_cancellable<socket_recv_fds_operation_cancellable>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+		void cancel() noexcept { m_impl.cancel(*this); }
+		decltype(auto) get_result() { return m_impl.get_result(*this); }
+
+		socket_recv_fds_operation_impl m_impl;
+
+	};
+}
+
+#endif
+
+#endif
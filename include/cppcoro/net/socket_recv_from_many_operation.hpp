@@ -0,0 +1,161 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_NET_SOCKET_RECV_FROM_MANY_OPERATION_HPP_INCLUDED
+#define CPPCORO_NET_SOCKET_RECV_FROM_MANY_OPERATION_HPP_INCLUDED
+
+#include <cppcoro/config.hpp>
+#include <cppcoro/cancellation_token.hpp>
+#include <cppcoro/net/ip_endpoint.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <span>
+
+namespace cppcoro::net
+{
+	/// A buffer to receive one datagram into as part of a batch received
+	/// by socket::recv_from_many().
+	///
+	/// The caller fills in the 'buffer' and 'size' fields. The remaining
+	/// fields are written for each datagram that is received.
+	struct datagram_buffer
+	{
+		void* buffer = nullptr;
+		std::size_t size = 0;
+
+		std::size_t bytesReceived = 0;
+		ip_endpoint source;
+
+		/// Set if the datagram was larger than the buffer, in which case the
+		/// rest of the datagram has been discarded.
+		bool truncated = false;
+	};
+}
+
+#if CPPCORO_OS_LINUX
+# include <cppcoro/detail/linux.hpp>
+# include <cppcoro/detail/linux_io_uring_operation.hpp>
+
+namespace cppcoro::net
+{
+	class socket;
+
+	class socket_recv_from_many_operation_impl
+	{
+	public:
+
+		socket_recv_from_many_operation_impl(
+			socket& s,
+			std::span<datagram_buffer> buffers) noexcept;
+
+		~socket_recv_from_many_operation_impl();
+
+		bool try_start(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+		void cancel(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+		std::size_t get_result(cppcoro::detail::io_uring_operation_base& operation);
+
+	private:
+
+		// recvmmsg() takes an array of headers, so these are kept separately
+		// from the rest of each message.
+		struct message
+		{
+			cppcoro::detail::lnx::iovec_t m_buffer;
+			cppcoro::detail::lnx::sockaddr_storage_t m_sourceAddress;
+		};
+
+		// Enough that typical batches don't need to allocate anything.
+		// Larger batches allocate their headers and messages when started.
+		static constexpr std::size_t inline_message_count = 16;
+
+		// There is no io_uring equivalent of recvmmsg() so we poll the socket
+		// for readability and call recvmmsg() when it is readable.
+		struct poll_state : cppcoro::detail::lnx::io_state
+		{
+			using io_state::io_state;
+			socket_recv_from_many_operation_impl* m_impl = nullptr;
+		};
+
+		static void on_poll_completed(
+			cppcoro::detail::lnx::io_state* state,
+			std::int32_t result,
+			std::uint32_t flags) noexcept;
+
+		/// \return
+		/// The number of datagrams received or a negative errno value.
+		int try_receive() noexcept;
+
+		/// \return
+		/// Zero if the poll was submitted or a negative errno value.
+		int start_poll() noexcept;
+
+		socket& m_socket;
+		std::span<datagram_buffer> m_buffers;
+		cppcoro::detail::lnx::mmsghdr_t* m_headers;
+		message* m_messages;
+		cppcoro::detail::lnx::mmsghdr_t m_inlineHeaders[inline_message_count];
+		message m_inlineMessages[inline_message_count];
+		std::unique_ptr<cppcoro::detail::lnx::mmsghdr_t[]> m_allocatedHeaders;
+		std::unique_ptr<message[]> m_allocatedMessages;
+		poll_state m_pollState;
+		cppcoro::detail::io_uring_operation_base* m_operation;
+		// Protected by the io_uring submission mutex so that a poll can't be
+		// submitted after cancel() has tried to cancel it.
+		bool m_cancelRequested;
+
+	};
+
+	class socket_recv_from_many_operation
+		: public cppcoro::detail::io_uring_operation<socket_recv_from_many_operation>
+	{
+	public:
+
+		socket_recv_from_many_operation(
+			socket& s,
+			std::span<datagram_buffer> buffers) noexcept
+			: m_impl(s, buffers)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation<socket_recv_from_many_operation>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+		std::size_t get_result() { return m_impl.get_result(*this); }
+
+		socket_recv_from_many_operation_impl m_impl;
+
+	};
+
+	class socket_recv_from_many_operation_cancellable
+		: public cppcoro::detail::io_uring_operation_cancellable<socket_recv_from_many_operation_cancellable>
+	{
+	public:
+
+		socket_recv_from_many_operation_cancellable(
+			socket& s,
+			std::span<datagram_buffer> buffers,
+			cancellation_token&& ct) noexcept
+			: cppcoro::detail::io_uring_operation_cancellable<socket_recv_from_many_operation_cancellable>(std::move(ct))
+			, m_impl(s, buffers)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation_cancellable<socket_recv_from_many_operation_cancellable>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+		void cancel() noexcept { m_impl.cancel(*this); }
+		std::size_t get_result() { return m_impl.get_result(*this); }
+
+		socket_recv_from_many_operation_impl m_impl;
+
+	};
+
+}
+
+#endif
+
+#endif
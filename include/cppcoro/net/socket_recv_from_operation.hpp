@@ -101,6 +101,147 @@ namespace cppcoro::net
 
 }
 
-#endif // CPPCORO_OS_WINNT
+#elif CPPCORO_OS_LINUX
+# include <cppcoro/detail/linux.hpp>
+# include <cppcoro/detail/linux_io_uring_operation.hpp>
+
+namespace cppcoro::net
+{
+	class socket;
+
+	class socket_recv_from_operation_impl
+	{
+	public:
+
+		socket_recv_from_operation_impl(
+			socket& socket,
+			void* buffer,
+			std::size_t byteCount) noexcept
+			: m_socket(socket)
+			, m_buffer{ buffer, byteCount }
+		{}
+
+		bool try_start(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+		void cancel(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+		std::tuple<std::size_t, ip_endpoint> get_result(
+			cppcoro::detail::io_uring_operation_base& operation);
+		std::tuple<std::size_t, ip_endpoint, std::size_t> get_segmented_result(
+			cppcoro::detail::io_uring_operation_base& operation);
+
+	private:
+
+		socket& m_socket;
+		cppcoro::detail::lnx::iovec_t m_buffer;
+		cppcoro::detail::lnx::msghdr_t m_message;
+		cppcoro::detail::lnx::sockaddr_storage_t m_sourceAddress;
+
+		// Space for the UDP_GRO control message.
+		alignas(8) std::uint8_t m_control[32];
+
+	};
+
+	class socket_recv_from_operation
+		: public cppcoro::detail::io_uring_operation<socket_recv_from_operation>
+	{
+	public:
+
+		socket_recv_from_operation(
+			socket& socket,
+			void* buffer,
+			std::size_t byteCount) noexcept
+			: m_impl(socket, buffer, byteCount)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation<socket_recv_from_operation>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+		decltype(auto) get_result() { return m_impl.get_result(*this); }
+
+		socket_recv_from_operation_impl m_impl;
+
+	};
+
+	class socket_recv_from_operation_cancellable
+		: public cppcoro::detail::io_uring_operation_cancellable<socket_recv_from_operation_cancellable>
+	{
+	public:
+
+		socket_recv_from_operation_cancellable(
+			socket& socket,
+			void* buffer,
+			std::size_t byteCount,
+			cancellation_token&& ct) noexcept
+			: cppcoro::detail::io_uring_operation_cancellable<socket_recv_from_operation_cancellable>(std::move(ct))
+			, m_impl(socket, buffer, byteCount)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation_cancellable<socket_recv_from_operation_cancellable>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+		void cancel() noexcept { m_impl.cancel(*this); }
+		decltype(auto) get_result() { return m_impl.get_result(*this); }
+
+		socket_recv_from_operation_impl m_impl;
+
+	};
+
+	/// A recv_from() that also reports the size of the segments that the
+	/// received data is made up of when UDP generic receive offload is enabled.
+	class socket_recv_from_segmented_operation
+		: public cppcoro::detail::io_uring_operation<socket_recv_from_segmented_operation>
+	{
+	public:
+
+		socket_recv_from_segmented_operation(
+			socket& socket,
+			void* buffer,
+			std::size_t byteCount) noexcept
+			: m_impl(socket, buffer, byteCount)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation<socket_recv_from_segmented_operation>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+		decltype(auto) get_result() { return m_impl.get_segmented_result(*this); }
+
+		socket_recv_from_operation_impl m_impl;
+
+	};
+
+	class socket_recv_from_segmented_operation_cancellable
+		: public cppcoro::detail::io_uring_operation_cancellable<socket_recv_from_segmented_operation_cancellable>
+	{
+	public:
+
+		socket_recv_from_segmented_operation_cancellable(
+			socket& socket,
+			void* buffer,
+			std::size_t byteCount,
+			cancellation_token&& ct) noexcept
+			: cppcoro::detail::io_uring_operation_cancellable<socket_recv_from_segmented_operation_cancellable>(std::move(ct))
+			, m_impl(socket, buffer, byteCount)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation_cancellable<socket_recv_from_segmented_operation_cancellable>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+		void cancel() noexcept { m_impl.cancel(*this); }
+		decltype(auto) get_result() { return m_impl.get_segmented_result(*this); }
+
+		socket_recv_from_operation_impl m_impl;
+
+	};
+
+}
+
+#endif
 
 #endif
@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_NET_SOCKET_RECV_POOLED_OPERATION_HPP_INCLUDED
+#define CPPCORO_NET_SOCKET_RECV_POOLED_OPERATION_HPP_INCLUDED
+
+#include <cppcoro/config.hpp>
+#include <cppcoro/cancellation_token.hpp>
+
+#if CPPCORO_OS_LINUX
+# include <cppcoro/net/recv_buffer_pool.hpp>
+# include <cppcoro/detail/linux.hpp>
+# include <cppcoro/detail/linux_io_uring_operation.hpp>
+
+namespace cppcoro::net
+{
+	class socket;
+
+	class socket_recv_pooled_operation_impl
+	{
+	public:
+
+		socket_recv_pooled_operation_impl(
+			socket& s,
+			recv_buffer_pool& pool) noexcept
+			: m_socket(s)
+			, m_pool(pool)
+		{}
+
+		bool try_start(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+		void cancel(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+		recv_buffer_lease get_result(cppcoro::detail::io_uring_operation_base& operation);
+
+	private:
+
+		socket& m_socket;
+		recv_buffer_pool& m_pool;
+
+	};
+
+	class socket_recv_pooled_operation
+		: public cppcoro::detail::io_uring_operation<socket_recv_pooled_operation>
+	{
+	public:
+
+		socket_recv_pooled_operation(
+			socket& s,
+			recv_buffer_pool& pool) noexcept
+			: m_impl(s, pool)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation<socket_recv_pooled_operation>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+		recv_buffer_lease get_result() { return m_impl.get_result(*this); }
+
+		socket_recv_pooled_operation_impl m_impl;
+
+	};
+
+	class socket_recv_pooled_operation_cancellable
+		: public cppcoro::detail::io_uring_operation_cancellable<socket_recv_pooled_operation_cancellable>
+	{
+	public:
+
+		socket_recv_pooled_operation_cancellable(
+			socket& s,
+			recv_buffer_pool& pool,
+			cancellation_token&& ct) noexcept
+			: cppcoro::detail::io_uring_operation_cancellable<socket_recv_pooled_operation_cancellable>(std::move(ct))
+			, m_impl(s, pool)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation_cancellable<socket_recv_pooled_operation_cancellable>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+		void cancel() noexcept { m_impl.cancel(*this); }
+		recv_buffer_lease get_result() { return m_impl.get_result(*this); }
+
+		socket_recv_pooled_operation_impl m_impl;
+
+	};
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,191 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_NET_SOCKET_RECV_VECTORED_OPERATION_HPP_INCLUDED
+#define CPPCORO_NET_SOCKET_RECV_VECTORED_OPERATION_HPP_INCLUDED
+
+#include <cppcoro/config.hpp>
+#include <cppcoro/cancellation_token.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <span>
+
+namespace cppcoro::net
+{
+	/// One of the buffers that a single receive by socket::recv() scatters
+	/// the received data across.
+	struct mutable_buffer
+	{
+		void* buffer = nullptr;
+		std::size_t size = 0;
+	};
+}
+
+#if CPPCORO_OS_WINNT
+# include <cppcoro/detail/win32.hpp>
+# include <cppcoro/detail/win32_overlapped_operation.hpp>
+
+namespace cppcoro::net
+{
+	class socket;
+
+	class socket_recv_vectored_operation_impl
+	{
+	public:
+
+		socket_recv_vectored_operation_impl(
+			socket& s,
+			std::span<const mutable_buffer> buffers) noexcept
+			: m_socket(s)
+			, m_buffers(buffers)
+		{}
+
+		bool try_start(cppcoro::detail::win32_overlapped_operation_base& operation) noexcept;
+		void cancel(cppcoro::detail::win32_overlapped_operation_base& operation) noexcept;
+
+	private:
+
+		socket& m_socket;
+		std::span<const mutable_buffer> m_buffers;
+
+		// Most receives scatter into only a few buffers so only allocate an
+		// array of WSABUFs when there are more than this.
+		cppcoro::detail::win32::wsabuf m_inlineWsaBuffers[4];
+		std::unique_ptr<cppcoro::detail::win32::wsabuf[]> m_wsaBuffers;
+
+	};
+
+	class socket_recv_vectored_operation
+		: public cppcoro::detail::win32_overlapped_operation<socket_recv_vectored_operation>
+	{
+	public:
+
+		socket_recv_vectored_operation(
+			socket& s,
+			std::span<const mutable_buffer> buffers) noexcept
+			: m_impl(s, buffers)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::win32_overlapped_operation<socket_recv_vectored_operation>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+
+		socket_recv_vectored_operation_impl m_impl;
+
+	};
+
+	class socket_recv_vectored_operation_cancellable
+		: public cppcoro::detail::win32_overlapped_operation_cancellable<socket_recv_vectored_operation_cancellable>
+	{
+	public:
+
+		socket_recv_vectored_operation_cancellable(
+			socket& s,
+			std::span<const mutable_buffer> buffers,
+			cancellation_token&& ct) noexcept
+			: cppcoro::detail::win32_overlapped_operation_cancellable<socket_recv_vectored_operation_cancellable>(std::move(ct))
+			, m_impl(s, buffers)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::win32_overlapped_operation_cancellable<socket_recv_vectored_operation_cancellable>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+		void cancel() noexcept { m_impl.cancel(*this); }
+
+		socket_recv_vectored_operation_impl m_impl;
+
+	};
+
+}
+
+#elif CPPCORO_OS_LINUX
+# include <cppcoro/detail/linux.hpp>
+# include <cppcoro/detail/linux_io_uring_operation.hpp>
+
+namespace cppcoro::net
+{
+	class socket;
+
+	class socket_recv_vectored_operation_impl
+	{
+	public:
+
+		socket_recv_vectored_operation_impl(
+			socket& s,
+			std::span<const mutable_buffer> buffers) noexcept
+			: m_socket(s)
+			, m_buffers(buffers)
+		{}
+
+		bool try_start(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+		void cancel(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+
+	private:
+
+		socket& m_socket;
+		std::span<const mutable_buffer> m_buffers;
+		cppcoro::detail::lnx::msghdr_t m_message;
+
+		// Most receives scatter into only a few buffers so only allocate an
+		// array of iovecs when there are more than this.
+		cppcoro::detail::lnx::iovec_t m_inlineIovecs[4];
+		std::unique_ptr<cppcoro::detail::lnx::iovec_t[]> m_iovecs;
+
+	};
+
+	class socket_recv_vectored_operation
+		: public cppcoro::detail::io_uring_operation<socket_recv_vectored_operation>
+	{
+	public:
+
+		socket_recv_vectored_operation(
+			socket& s,
+			std::span<const mutable_buffer> buffers) noexcept
+			: m_impl(s, buffers)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation<socket_recv_vectored_operation>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+
+		socket_recv_vectored_operation_impl m_impl;
+
+	};
+
+	class socket_recv_vectored_operation_cancellable
+		: public cppcoro::detail::io_uring_operation_cancellable<socket_recv_vectored_operation_cancellable>
+	{
+	public:
+
+		socket_recv_vectored_operation_cancellable(
+			socket& s,
+			std::span<const mutable_buffer> buffers,
+			cancellation_token&& ct) noexcept
+			: cppcoro::detail::io_uring_operation_cancellable<socket_recv_vectored_operation_cancellable>(std::move(ct))
+			, m_impl(s, buffers)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation_cancellable<socket_recv_vectored_operation_cancellable>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+		void cancel() noexcept { m_impl.cancel(*this); }
+
+		socket_recv_vectored_operation_impl m_impl;
+
+	};
+
+}
+
+#endif
+
+#endif
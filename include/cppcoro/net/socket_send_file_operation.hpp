@@ -0,0 +1,221 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_NET_SOCKET_SEND_FILE_OPERATION_HPP_INCLUDED
+#define CPPCORO_NET_SOCKET_SEND_FILE_OPERATION_HPP_INCLUDED
+
+#include <cppcoro/config.hpp>
+#include <cppcoro/cancellation_token.hpp>
+
+#include <cstdint>
+
+#if CPPCORO_OS_WINNT
+# include <cppcoro/detail/win32.hpp>
+# include <cppcoro/detail/win32_overlapped_operation.hpp>
+
+namespace cppcoro::net
+{
+	class socket;
+
+	class socket_send_file_operation_impl
+	{
+	public:
+
+		socket_send_file_operation_impl(
+			socket& s,
+			cppcoro::detail::win32::handle_t fileHandle,
+			std::size_t byteCount) noexcept
+			: m_socket(s)
+			, m_fileHandle(fileHandle)
+			, m_byteCount(byteCount)
+		{}
+
+		bool try_start(cppcoro::detail::win32_overlapped_operation_base& operation) noexcept;
+		void cancel(cppcoro::detail::win32_overlapped_operation_base& operation) noexcept;
+
+	private:
+
+		socket& m_socket;
+		cppcoro::detail::win32::handle_t m_fileHandle;
+		std::size_t m_byteCount;
+
+	};
+
+	class socket_send_file_operation
+		: public cppcoro::detail::win32_overlapped_operation<socket_send_file_operation>
+	{
+	public:
+
+		socket_send_file_operation(
+			socket& s,
+			cppcoro::detail::win32::handle_t fileHandle,
+			std::uint64_t fileOffset,
+			std::size_t byteCount) noexcept
+			: cppcoro::detail::win32_overlapped_operation<socket_send_file_operation>(fileOffset)
+			, m_impl(s, fileHandle, byteCount)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::win32_overlapped_operation<socket_send_file_operation>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+
+		socket_send_file_operation_impl m_impl;
+
+	};
+
+	class socket_send_file_operation_cancellable
+		: public cppcoro::detail::win32_overlapped_operation_cancellable<socket_send_file_operation_cancellable>
+	{
+	public:
+
+		socket_send_file_operation_cancellable(
+			socket& s,
+			cppcoro::detail::win32::handle_t fileHandle,
+			std::uint64_t fileOffset,
+			std::size_t byteCount,
+			cancellation_token&& ct) noexcept
+			: cppcoro::detail::win32_overlapped_operation_cancellable<socket_send_file_operation_cancellable>(
+				fileOffset, std::move(ct))
+			, m_impl(s, fileHandle, byteCount)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::win32_overlapped_operation_cancellable<socket_send_file_operation_cancellable>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+		void cancel() noexcept { return m_impl.cancel(*this); }
+
+		socket_send_file_operation_impl m_impl;
+
+	};
+
+}
+
+#elif CPPCORO_OS_LINUX
+# include <cppcoro/detail/linux.hpp>
+# include <cppcoro/detail/linux_io_uring_operation.hpp>
+
+namespace cppcoro::net
+{
+	class socket;
+
+	class socket_send_file_operation_impl
+	{
+	public:
+
+		socket_send_file_operation_impl(
+			socket& s,
+			cppcoro::detail::lnx::fd_t fileDescriptor,
+			std::uint64_t fileOffset,
+			std::size_t byteCount) noexcept
+			: m_socket(s)
+			, m_fileDescriptor(fileDescriptor)
+			, m_fileOffset(fileOffset)
+			, m_byteCount(byteCount)
+			, m_pipeSize(0)
+			, m_fillState(&socket_send_file_operation_impl::on_fill_completed)
+			, m_drainState(&socket_send_file_operation_impl::on_drain_completed)
+			, m_bytesInPipe(0)
+			, m_operation(nullptr)
+		{}
+
+		bool try_start(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+		void cancel(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+
+	private:
+
+		// The data is spliced from the file into a pipe and then from the
+		// pipe into the socket. These are the states of the two splices.
+		struct splice_state : cppcoro::detail::lnx::io_state
+		{
+			using io_state::io_state;
+			socket_send_file_operation_impl* m_impl = nullptr;
+		};
+
+		static void on_fill_completed(
+			cppcoro::detail::lnx::io_state* state,
+			std::int32_t result,
+			std::uint32_t flags) noexcept;
+
+		static void on_drain_completed(
+			cppcoro::detail::lnx::io_state* state,
+			std::int32_t result,
+			std::uint32_t flags) noexcept;
+
+		void release_pipe() noexcept;
+
+		socket& m_socket;
+		cppcoro::detail::lnx::fd_t m_fileDescriptor;
+		std::uint64_t m_fileOffset;
+		std::size_t m_byteCount;
+		// The pipe is borrowed from a per-thread cache and returned to it
+		// once it is empty again, so that each send doesn't pay for creating
+		// and resizing a new pipe.
+		cppcoro::detail::lnx::safe_fd m_pipeReadEnd;
+		cppcoro::detail::lnx::safe_fd m_pipeWriteEnd;
+		int m_pipeSize;
+		splice_state m_fillState;
+		splice_state m_drainState;
+		std::int32_t m_bytesInPipe;
+		cppcoro::detail::io_uring_operation_base* m_operation;
+
+	};
+
+	class socket_send_file_operation
+		: public cppcoro::detail::io_uring_operation<socket_send_file_operation>
+	{
+	public:
+
+		socket_send_file_operation(
+			socket& s,
+			cppcoro::detail::lnx::fd_t fileDescriptor,
+			std::uint64_t fileOffset,
+			std::size_t byteCount) noexcept
+			: m_impl(s, fileDescriptor, fileOffset, byteCount)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation<socket_send_file_operation>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+
+		socket_send_file_operation_impl m_impl;
+
+	};
+
+	class socket_send_file_operation_cancellable
+		: public cppcoro::detail::io_uring_operation_cancellable<socket_send_file_operation_cancellable>
+	{
+	public:
+
+		socket_send_file_operation_cancellable(
+			socket& s,
+			cppcoro::detail::lnx::fd_t fileDescriptor,
+			std::uint64_t fileOffset,
+			std::size_t byteCount,
+			cancellation_token&& ct) noexcept
+			: cppcoro::detail::io_uring_operation_cancellable<socket_send_file_operation_cancellable>(std::move(ct))
+			, m_impl(s, fileDescriptor, fileOffset, byteCount)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation_cancellable<socket_send_file_operation_cancellable>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+		void cancel() noexcept { return m_impl.cancel(*this); }
+
+		socket_send_file_operation_impl m_impl;
+
+	};
+
+}
+
+#endif
+
+#endif
@@ -89,6 +89,192 @@ namespace cppcoro::net
 
 }
 
-#endif // CPPCORO_OS_WINNT
+#elif CPPCORO_OS_LINUX
+# include <cppcoro/detail/linux.hpp>
+# include <cppcoro/detail/linux_io_uring_operation.hpp>
+
+# include <atomic>
+
+namespace cppcoro::net
+{
+	class socket;
+
+	class socket_send_operation_impl
+	{
+	public:
+
+		socket_send_operation_impl(
+			socket& s,
+			const void* buffer,
+			std::size_t byteCount) noexcept
+			: m_socket(s)
+			, m_buffer(buffer)
+			, m_byteCount(byteCount)
+		{}
+
+		bool try_start(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+		void cancel(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+
+	private:
+
+		socket& m_socket;
+		const void* m_buffer;
+		std::size_t m_byteCount;
+
+	};
+
+	class socket_send_operation
+		: public cppcoro::detail::io_uring_operation<socket_send_operation>
+	{
+	public:
+
+		socket_send_operation(
+			socket& s,
+			const void* buffer,
+			std::size_t byteCount) noexcept
+			: m_impl(s, buffer, byteCount)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation<socket_send_operation>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+
+		socket_send_operation_impl m_impl;
+
+	};
+
+	class socket_send_operation_cancellable
+		: public cppcoro::detail::io_uring_operation_cancellable<socket_send_operation_cancellable>
+	{
+	public:
+
+		socket_send_operation_cancellable(
+			socket& s,
+			const void* buffer,
+			std::size_t byteCount,
+			cancellation_token&& ct) noexcept
+			: cppcoro::detail::io_uring_operation_cancellable<socket_send_operation_cancellable>(std::move(ct))
+			, m_impl(s, buffer, byteCount)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation_cancellable<socket_send_operation_cancellable>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+		void cancel() noexcept { return m_impl.cancel(*this); }
+
+		socket_send_operation_impl m_impl;
+
+	};
+
+	class socket_send_zero_copy_operation_impl
+	{
+	public:
+
+		socket_send_zero_copy_operation_impl(
+			socket& s,
+			const void* buffer,
+			std::size_t byteCount) noexcept
+			: m_socket(s)
+			, m_buffer(buffer)
+			, m_byteCount(byteCount)
+			, m_sendState(&socket_send_zero_copy_operation_impl::on_send_completed)
+			, m_operation(nullptr)
+			, m_result(0)
+			, m_pendingCompletions(2)
+		{}
+
+		bool try_start(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+		void cancel(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+
+	private:
+
+		// A zero-copy send completes twice: once with the number of bytes
+		// sent and again, flagged with IORING_CQE_F_NOTIF, once the kernel
+		// has finished with the buffer. Both completions go to this state
+		// so that the operation only completes after the second one.
+		struct send_state : cppcoro::detail::lnx::io_state
+		{
+			using io_state::io_state;
+			socket_send_zero_copy_operation_impl* m_impl = nullptr;
+		};
+
+		static void on_send_completed(
+			cppcoro::detail::lnx::io_state* state,
+			std::int32_t result,
+			std::uint32_t flags) noexcept;
+
+		/// \return
+		/// Zero if the send was submitted or a negative errno value.
+		int submit_send(std::uint8_t opcode) noexcept;
+
+		socket& m_socket;
+		const void* m_buffer;
+		std::size_t m_byteCount;
+		send_state m_sendState;
+		cppcoro::detail::io_uring_operation_base* m_operation;
+
+		// The result of the first completion.
+		std::int32_t m_result;
+
+		// The number of completions still to come, once the first completion
+		// has indicated that a notification will follow.
+		std::atomic<int> m_pendingCompletions;
+
+	};
+
+	class socket_send_zero_copy_operation
+		: public cppcoro::detail::io_uring_operation<socket_send_zero_copy_operation>
+	{
+	public:
+
+		socket_send_zero_copy_operation(
+			socket& s,
+			const void* buffer,
+			std::size_t byteCount) noexcept
+			: m_impl(s, buffer, byteCount)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation<socket_send_zero_copy_operation>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+
+		socket_send_zero_copy_operation_impl m_impl;
+
+	};
+
+	class socket_send_zero_copy_operation_cancellable
+		: public cppcoro::detail::io_uring_operation_cancellable<socket_send_zero_copy_operation_cancellable>
+	{
+	public:
+
+		socket_send_zero_copy_operation_cancellable(
+			socket& s,
+			const void* buffer,
+			std::size_t byteCount,
+			cancellation_token&& ct) noexcept
+			: cppcoro::detail::io_uring_operation_cancellable<socket_send_zero_copy_operation_cancellable>(std::move(ct))
+			, m_impl(s, buffer, byteCount)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation_cancellable<socket_send_zero_copy_operation_cancellable>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+		void cancel() noexcept { return m_impl.cancel(*this); }
+
+		socket_send_zero_copy_operation_impl m_impl;
+
+	};
+
+}
+
+#endif
 
 #endif
@@ -0,0 +1,148 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_NET_SOCKET_SEND_TO_MANY_OPERATION_HPP_INCLUDED
+#define CPPCORO_NET_SOCKET_SEND_TO_MANY_OPERATION_HPP_INCLUDED
+
+#include <cppcoro/config.hpp>
+#include <cppcoro/cancellation_token.hpp>
+#include <cppcoro/net/ip_endpoint.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <span>
+
+namespace cppcoro::net
+{
+	/// A single datagram to send as part of a batch sent by socket::send_to_many().
+	struct datagram
+	{
+		ip_endpoint destination;
+		const void* buffer = nullptr;
+		std::size_t size = 0;
+	};
+}
+
+#if CPPCORO_OS_LINUX
+# include <cppcoro/detail/linux.hpp>
+# include <cppcoro/detail/linux_io_uring_operation.hpp>
+
+namespace cppcoro::net
+{
+	class socket;
+
+	class socket_send_to_many_operation_impl
+	{
+	public:
+
+		socket_send_to_many_operation_impl(
+			socket& s,
+			std::span<const datagram> datagrams) noexcept;
+
+		~socket_send_to_many_operation_impl();
+
+		bool try_start(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+		void cancel(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+
+	private:
+
+		// sendmmsg() takes an array of headers, so these are kept separately
+		// from the rest of each message.
+		struct message
+		{
+			cppcoro::detail::lnx::iovec_t m_buffer;
+			cppcoro::detail::lnx::sockaddr_storage_t m_destinationAddress;
+		};
+
+		// Enough that typical batches don't need to allocate anything.
+		// Larger batches allocate their headers and messages when started.
+		static constexpr std::size_t inline_message_count = 16;
+
+		// There is no io_uring equivalent of sendmmsg() so we poll the socket
+		// for writability and call sendmmsg() when it is writable.
+		struct poll_state : cppcoro::detail::lnx::io_state
+		{
+			using io_state::io_state;
+			socket_send_to_many_operation_impl* m_impl = nullptr;
+		};
+
+		static void on_poll_completed(
+			cppcoro::detail::lnx::io_state* state,
+			std::int32_t result,
+			std::uint32_t flags) noexcept;
+
+		/// \return
+		/// The number of datagrams sent or a negative errno value.
+		int try_send() noexcept;
+
+		/// \return
+		/// Zero if the poll was submitted or a negative errno value.
+		int start_poll() noexcept;
+
+		socket& m_socket;
+		std::span<const datagram> m_datagrams;
+		cppcoro::detail::lnx::mmsghdr_t* m_headers;
+		message* m_messages;
+		cppcoro::detail::lnx::mmsghdr_t m_inlineHeaders[inline_message_count];
+		message m_inlineMessages[inline_message_count];
+		std::unique_ptr<cppcoro::detail::lnx::mmsghdr_t[]> m_allocatedHeaders;
+		std::unique_ptr<message[]> m_allocatedMessages;
+		poll_state m_pollState;
+		cppcoro::detail::io_uring_operation_base* m_operation;
+		// Protected by the io_uring submission mutex so that a poll can't be
+		// submitted after cancel() has tried to cancel it.
+		bool m_cancelRequested;
+
+	};
+
+	class socket_send_to_many_operation
+		: public cppcoro::detail::io_uring_operation<socket_send_to_many_operation>
+	{
+	public:
+
+		socket_send_to_many_operation(
+			socket& s,
+			std::span<const datagram> datagrams) noexcept
+			: m_impl(s, datagrams)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation<socket_send_to_many_operation>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+
+		socket_send_to_many_operation_impl m_impl;
+
+	};
+
+	class socket_send_to_many_operation_cancellable
+		: public cppcoro::detail::io_uring_operation_cancellable<socket_send_to_many_operation_cancellable>
+	{
+	public:
+
+		socket_send_to_many_operation_cancellable(
+			socket& s,
+			std::span<const datagram> datagrams,
+			cancellation_token&& ct) noexcept
+			: cppcoro::detail::io_uring_operation_cancellable<socket_send_to_many_operation_cancellable>(std::move(ct))
+			, m_impl(s, datagrams)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation_cancellable<socket_send_to_many_operation_cancellable>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+		void cancel() noexcept { m_impl.cancel(*this); }
+
+		socket_send_to_many_operation_impl m_impl;
+
+	};
+
+}
+
+#endif
+
+#endif
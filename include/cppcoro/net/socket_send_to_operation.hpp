@@ -95,6 +95,103 @@ namespace cppcoro::net
 
 }
 
-#endif // CPPCORO_OS_WINNT
+#elif CPPCORO_OS_LINUX
+# include <cppcoro/detail/linux.hpp>
+# include <cppcoro/detail/linux_io_uring_operation.hpp>
+
+namespace cppcoro::net
+{
+	class socket;
+
+	class socket_send_to_operation_impl
+	{
+	public:
+
+		socket_send_to_operation_impl(
+			socket& s,
+			const ip_endpoint& destination,
+			const void* buffer,
+			std::size_t byteCount,
+			std::uint16_t segmentSize) noexcept
+			: m_socket(s)
+			, m_destination(destination)
+			, m_buffer{ const_cast<void*>(buffer), byteCount }
+			, m_segmentSize(segmentSize)
+		{}
+
+		bool try_start(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+		void cancel(cppcoro::detail::io_uring_operation_base& operation) noexcept;
+
+	private:
+
+		socket& m_socket;
+		ip_endpoint m_destination;
+		cppcoro::detail::lnx::iovec_t m_buffer;
+		cppcoro::detail::lnx::msghdr_t m_message;
+		cppcoro::detail::lnx::sockaddr_storage_t m_destinationAddress;
+
+		// If non-zero, the buffer is sent as a series of datagrams of this
+		// size using UDP generic segmentation offload.
+		std::uint16_t m_segmentSize;
+
+		// Space for the UDP_SEGMENT control message.
+		alignas(8) std::uint8_t m_control[32];
+
+	};
+
+	class socket_send_to_operation
+		: public cppcoro::detail::io_uring_operation<socket_send_to_operation>
+	{
+	public:
+
+		socket_send_to_operation(
+			socket& s,
+			const ip_endpoint& destination,
+			const void* buffer,
+			std::size_t byteCount,
+			std::uint16_t segmentSize = 0) noexcept
+			: m_impl(s, destination, buffer, byteCount, segmentSize)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation<socket_send_to_operation>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+
+		socket_send_to_operation_impl m_impl;
+
+	};
+
+	class socket_send_to_operation_cancellable
+		: public cppcoro::detail::io_uring_operation_cancellable<socket_send_to_operation_cancellable>
+	{
+	public:
+
+		socket_send_to_operation_cancellable(
+			socket& s,
+			const ip_endpoint& destination,
+			const void* buffer,
+			std::size_t byteCount,
+			cancellation_token&& ct,
+			std::uint16_t segmentSize = 0) noexcept
+			: cppcoro::detail::io_uring_operation_cancellable<socket_send_to_operation_cancellable>(std::move(ct))
+			, m_impl(s, destination, buffer, byteCount, segmentSize)
+		{}
+
+	private:
+
+		friend class cppcoro::detail::io_uring_operation_cancellable<socket_send_to_operation_cancellable>;
+
+		bool try_start() noexcept { return m_impl.try_start(*this); }
+		void cancel() noexcept { return m_impl.cancel(*this); }
+
+		socket_send_to_operation_impl m_impl;
+
+	};
+
+}
+
+#endif
 
 #endif
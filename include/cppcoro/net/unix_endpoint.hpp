@@ -0,0 +1,94 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+#ifndef CPPCORO_NET_UNIX_ENDPOINT_HPP_INCLUDED
+#define CPPCORO_NET_UNIX_ENDPOINT_HPP_INCLUDED
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace cppcoro
+{
+	namespace net
+	{
+		/// The address of a Unix domain socket (AF_UNIX).
+		///
+		/// An end-point is one of:
+		/// - unnamed, as for a socket that has not been bound.
+		/// - a path in the filesystem.
+		/// - a name in the Linux abstract namespace, which is not visible in
+		///   the filesystem and goes away when the last socket bound to it is
+		///   closed. The path of an abstract end-point starts with a null
+		///   character.
+		class unix_endpoint
+		{
+		public:
+
+			/// The longest path that will fit in a sockaddr_un. Binding or
+			/// connecting to a longer path fails with ENAMETOOLONG.
+			static constexpr std::size_t max_path_length = 107;
+
+			/// Construct an unnamed end-point.
+			unix_endpoint() noexcept
+				: m_path()
+			{}
+
+			explicit unix_endpoint(std::string path) noexcept
+				: m_path(std::move(path))
+			{}
+
+			/// Construct an end-point in the abstract namespace.
+			static unix_endpoint abstract(std::string_view name)
+			{
+				std::string path(1, '\0');
+				path.append(name);
+				return unix_endpoint{ std::move(path) };
+			}
+
+			/// The path of the socket, which starts with a null character for
+			/// an end-point in the abstract namespace.
+			const std::string& path() const noexcept { return m_path; }
+
+			bool is_unnamed() const noexcept { return m_path.empty(); }
+
+			bool is_abstract() const noexcept { return !m_path.empty() && m_path[0] == '\0'; }
+
+			/// Format the end-point as a string, showing the leading null
+			/// character of an abstract end-point as '@', as ss(8) does.
+			std::string to_string() const
+			{
+				if (is_abstract())
+				{
+					return '@' + m_path.substr(1);
+				}
+
+				return m_path;
+			}
+
+		private:
+
+			std::string m_path;
+
+		};
+
+		inline bool operator==(const unix_endpoint& a, const unix_endpoint& b)
+		{
+			return a.path() == b.path();
+		}
+
+		inline bool operator!=(const unix_endpoint& a, const unix_endpoint& b)
+		{
+			return !(a == b);
+		}
+
+		inline bool operator<(const unix_endpoint& a, const unix_endpoint& b)
+		{
+			return a.path() < b.path();
+		}
+	}
+}
+
+#endif
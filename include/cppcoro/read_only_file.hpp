@@ -51,6 +51,8 @@ namespace cppcoro
 
 #if CPPCORO_OS_WINNT
 		read_only_file(detail::win32::safe_handle&& fileHandle) noexcept;
+#elif CPPCORO_OS_LINUX
+		read_only_file(detail::lnx::safe_fd&& fileDescriptor, io_service& ioService) noexcept;
 #endif
 
 	};
@@ -7,7 +7,13 @@
 
 #include <cppcoro/file.hpp>
 #include <cppcoro/file_read_operation.hpp>
+#include <cppcoro/file_read_many_operation.hpp>
 #include <cppcoro/cancellation_token.hpp>
+#include <cppcoro/async_generator.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
 
 namespace cppcoro
 {
@@ -55,6 +61,61 @@ namespace cppcoro
 			std::size_t byteCount,
 			cancellation_token ct) const noexcept;
 
+		/// Read several ranges of the file as a single batch.
+		///
+		/// All of the reads are issued together when the returned operation is
+		/// co_await'ed, and the awaiting coroutine is resumed once, after the
+		/// last of them has completed. This avoids the cost of a coroutine
+		/// frame and a resumption per read that awaiting each read() with
+		/// when_all() would incur.
+		///
+		/// \param requests
+		/// The reads to perform. Each request's 'bytesRead' and 'error' fields
+		/// are set as that read completes. A failed read does not fail the
+		/// batch; check each request's 'error'. The requests and their buffers
+		/// must remain valid until the operation completes. The same alignment
+		/// requirements as read() apply to files opened using
+		/// file_buffering_mode::unbuffered.
+		///
+		/// \param ct
+		/// An optional cancellation_token that can be used to cancel the
+		/// reads that have not yet completed. If cancellation is requested
+		/// and any of the reads did not complete then the co_await expression
+		/// throws operation_cancelled.
+		///
+		/// \return
+		/// An object that represents the batch of reads.
+		/// This object must be co_await'ed to start the read operations.
+		[[nodiscard]]
+		file_read_many_operation read_many(
+			std::span<file_read_request> requests,
+			cancellation_token ct = {}) const noexcept;
+
+		/// Read the file sequentially as a stream of fixed-size chunks.
+		///
+		/// Keeps up to \a readAheadDepth reads in flight ahead of the consumer
+		/// so that the device queue stays busy while the consumer is processing
+		/// the current chunk. When the consumer advances past a chunk its buffer
+		/// is recycled for the next read-ahead.
+		///
+		/// \param chunkSize
+		/// The number of bytes to read per chunk. The final chunk may be shorter.
+		/// If the file has been opened using file_buffering_mode::unbuffered
+		/// then the chunkSize must be a multiple of the file-system's sector size.
+		///
+		/// \param readAheadDepth
+		/// The number of reads to keep outstanding while the consumer is
+		/// processing a chunk. Must be at least 1.
+		///
+		/// \return
+		/// A generator that yields a view of each chunk, in file order.
+		/// The view is only valid until the generator is next advanced.
+		/// The file must outlive the generator. Destroying the generator before
+		/// it completes requests cancellation of any reads still in flight.
+		async_generator<std::span<const std::byte>> read_chunks(
+			std::size_t chunkSize,
+			std::uint32_t readAheadDepth = 4) const;
+
 	protected:
 
 		using file::file;
@@ -117,11 +117,15 @@ namespace cppcoro
 	template<typename SCHEDULER, typename T>
 	async_generator<T> resume_on(SCHEDULER& scheduler, async_generator<T> source)
 	{
-		for (auto iter = co_await source.begin(); iter != source.end(); co_await ++iter)
+		const auto itEnd = source.end();
+		auto it = co_await source.begin();
+		while (it != itEnd)
 		{
-			auto& value = *iter;
+			auto& value = *it;
 			co_await scheduler.schedule();
 			co_yield value;
+
+			(void)co_await ++it;
 		}
 	}
 }
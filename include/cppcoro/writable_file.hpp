@@ -7,6 +7,8 @@
 
 #include <cppcoro/file.hpp>
 #include <cppcoro/file_write_operation.hpp>
+#include <cppcoro/file_write_vectored_operation.hpp>
+#include <cppcoro/file_sync_operation.hpp>
 #include <cppcoro/cancellation_token.hpp>
 
 namespace cppcoro
@@ -61,6 +63,107 @@ namespace cppcoro
 			std::size_t byteCount,
 			cancellation_token ct) noexcept;
 
+		/// Write the contents of several buffers to a contiguous range of the
+		/// file with a single operation.
+		///
+		/// On Linux this is the equivalent of pwritev(). On Windows it uses
+		/// WriteFileGather(), which requires the file to have been opened
+		/// using file_buffering_mode::unbuffered and each buffer to start on a
+		/// page boundary and be a multiple of the page size in length.
+		///
+		/// \param offset
+		/// The offset within the file to start writing from.
+		///
+		/// \param buffers
+		/// The buffers to write, in order. The span and the buffers must
+		/// remain valid until the operation completes.
+		///
+		/// \return
+		/// An object that represents the write operation.
+		/// This object must be co_await'ed to start the write operation.
+		/// The co_await expression produces the number of bytes written, which
+		/// may be less than the total size of the buffers.
+		[[nodiscard]]
+		file_write_vectored_operation write(
+			std::uint64_t offset,
+			std::span<const file_write_buffer> buffers) noexcept;
+		[[nodiscard]]
+		file_write_vectored_operation_cancellable write(
+			std::uint64_t offset,
+			std::span<const file_write_buffer> buffers,
+			cancellation_token ct) noexcept;
+
+		/// Flush the data and metadata of the file to the storage device.
+		///
+		/// Once the returned operation completes, all writes that completed
+		/// before it was started are durable.
+		///
+		/// On Linux this is submitted to the io_service as an asynchronous
+		/// fsync() so that it doesn't block the awaiting I/O thread.
+		/// Windows has no asynchronous equivalent so the flush is performed
+		/// synchronously when the operation is co_await'ed.
+		///
+		/// \return
+		/// An object that represents the flush operation.
+		/// This object must be co_await'ed to start the flush operation.
+		/// The co_await expression throws std::system_error if the flush fails.
+		[[nodiscard]]
+		file_sync_operation flush() noexcept;
+
+		/// Flush the data of the file to the storage device.
+		///
+		/// Like flush() except that metadata that is not required to read
+		/// the data back (eg. modification time) is not flushed. This is
+		/// the equivalent of fdatasync() and is typically cheaper than flush()
+		/// when the size of the file has not changed.
+		///
+		/// On Windows this is the same as flush().
+		[[nodiscard]]
+		file_sync_operation sync_data() noexcept;
+
+		/// Allocate storage for a range of the file without changing its size.
+		///
+		/// Subsequent writes to the range will not fail due to lack of disk
+		/// space and can avoid the cost of allocating blocks as they go.
+		/// Use set_size() to extend the file itself.
+		///
+		/// On Windows the allocation is only ever grown, and this is performed
+		/// synchronously when the operation is co_await'ed.
+		///
+		/// \param offset
+		/// The offset within the file of the start of the range.
+		///
+		/// \param length
+		/// The length of the range in bytes.
+		///
+		/// \return
+		/// An object that represents the allocate operation.
+		/// This object must be co_await'ed to start the allocate operation.
+		[[nodiscard]]
+		file_allocate_operation preallocate(
+			std::uint64_t offset,
+			std::uint64_t length) noexcept;
+
+		/// Deallocate the storage for a range of the file without changing
+		/// its size. The range reads back as zeroes afterwards.
+		///
+		/// On Windows the storage is only released if the file has been
+		/// marked as sparse, otherwise the range is just zeroed.
+		///
+		/// \param offset
+		/// The offset within the file of the start of the range.
+		///
+		/// \param length
+		/// The length of the range in bytes.
+		///
+		/// \return
+		/// An object that represents the deallocate operation.
+		/// This object must be co_await'ed to start the deallocate operation.
+		[[nodiscard]]
+		file_allocate_operation punch_hole(
+			std::uint64_t offset,
+			std::uint64_t length) noexcept;
+
 	protected:
 
 		using file::file;
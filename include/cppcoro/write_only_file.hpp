@@ -57,6 +57,8 @@ namespace cppcoro
 
 #if CPPCORO_OS_WINNT
 		write_only_file(detail::win32::safe_handle&& fileHandle) noexcept;
+#elif CPPCORO_OS_LINUX
+		write_only_file(detail::lnx::safe_fd&& fileDescriptor, io_service& ioService) noexcept;
 #endif
 
 	};
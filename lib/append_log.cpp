@@ -0,0 +1,251 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/append_log.hpp>
+#include <cppcoro/single_consumer_event.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <span>
+
+struct cppcoro::append_log::append_waiter
+{
+	append_waiter(const void* data, std::size_t size) noexcept
+		: m_data(data)
+		, m_size(size)
+		, m_offset(0)
+		, m_promotedToLeader(false)
+		, m_next(nullptr)
+	{}
+
+	const void* m_data;
+	std::size_t m_size;
+
+	// Result, written by the leader of the batch before m_completed is set.
+	std::uint64_t m_offset;
+	std::exception_ptr m_exception;
+
+	// Set instead of a result when the waiter has been chosen to write
+	// the next batch.
+	bool m_promotedToLeader;
+
+	append_waiter* m_next;
+	cppcoro::single_consumer_event m_completed;
+};
+
+cppcoro::append_log cppcoro::append_log::open(
+	io_service& ioService,
+	const cppcoro::filesystem::path& path,
+	std::uint64_t writeOffset,
+	std::uint64_t preallocateSize)
+{
+	// Batches are made durable with sync_data() once they have been written
+	// rather than by opening the file write-through, so that a batch costs
+	// a single flush regardless of how many records are in it.
+	auto file = write_only_file::open(
+		ioService,
+		path,
+		file_open_mode::create_or_open,
+		file_share_mode::read);
+
+	if (preallocateSize > file.size())
+	{
+		file.set_size(preallocateSize);
+	}
+
+	return append_log{ std::move(file), writeOffset };
+}
+
+cppcoro::append_log::append_log(
+	write_only_file&& file,
+	std::uint64_t writeOffset) noexcept
+	: m_file(std::move(file))
+	, m_queueHead(nullptr)
+	, m_queueTail(nullptr)
+	, m_batchInProgress(false)
+	, m_writeOffset(writeOffset)
+{
+}
+
+cppcoro::append_log::~append_log()
+{
+	assert(m_queueHead == nullptr);
+	assert(!m_batchInProgress);
+}
+
+cppcoro::task<std::uint64_t>
+cppcoro::append_log::append(const void* data, std::size_t size)
+{
+	append_waiter waiter{ data, size };
+
+	bool isLeader;
+	{
+		std::lock_guard lock{ m_mutex };
+		if (m_queueTail == nullptr)
+		{
+			m_queueHead = &waiter;
+		}
+		else
+		{
+			m_queueTail->m_next = &waiter;
+		}
+		m_queueTail = &waiter;
+
+		isLeader = !m_batchInProgress;
+		m_batchInProgress = true;
+	}
+
+	if (!isLeader)
+	{
+		co_await waiter.m_completed;
+
+		if (!waiter.m_promotedToLeader)
+		{
+			if (waiter.m_exception)
+			{
+				std::rethrow_exception(waiter.m_exception);
+			}
+
+			co_return waiter.m_offset;
+		}
+	}
+
+	// The leader's own record is always part of the batch it writes.
+	co_await write_batch(waiter);
+
+	if (waiter.m_exception)
+	{
+		std::rethrow_exception(waiter.m_exception);
+	}
+
+	co_return waiter.m_offset;
+}
+
+std::uint64_t cppcoro::append_log::write_offset() const
+{
+	std::lock_guard lock{ m_mutex };
+	return m_writeOffset;
+}
+
+cppcoro::task<> cppcoro::append_log::write_batch(append_waiter& leader)
+{
+	append_waiter* batch;
+	std::uint64_t batchOffset;
+	{
+		std::lock_guard lock{ m_mutex };
+		batch = m_queueHead;
+		m_queueHead = nullptr;
+		m_queueTail = nullptr;
+		batchOffset = m_writeOffset;
+	}
+
+	assert(batch != nullptr);
+
+	std::size_t batchSize = 0;
+	for (auto* waiter = batch; waiter != nullptr; waiter = waiter->m_next)
+	{
+		waiter->m_offset = batchOffset + batchSize;
+		batchSize += waiter->m_size;
+	}
+
+	std::exception_ptr batchException;
+	try
+	{
+#if CPPCORO_OS_WINNT
+		// WriteFileGather() only writes whole, page-aligned pages so write
+		// each record in turn instead. They are all made durable together
+		// by the sync_data() below.
+		for (auto* waiter = batch; waiter != nullptr; waiter = waiter->m_next)
+		{
+			std::size_t bytesWritten = 0;
+			while (bytesWritten < waiter->m_size)
+			{
+				bytesWritten += co_await m_file.write(
+					waiter->m_offset + bytesWritten,
+					static_cast<const std::byte*>(waiter->m_data) + bytesWritten,
+					waiter->m_size - bytesWritten);
+			}
+		}
+#else
+		// Gather the records straight from the appenders' buffers into a
+		// single write rather than copying them into a contiguous buffer.
+		m_batchBuffers.clear();
+		for (auto* waiter = batch; waiter != nullptr; waiter = waiter->m_next)
+		{
+			m_batchBuffers.push_back(file_write_buffer{ waiter->m_data, waiter->m_size });
+		}
+
+		std::span<file_write_buffer> remaining{ m_batchBuffers };
+		std::uint64_t writeOffset = batchOffset;
+		while (!remaining.empty())
+		{
+			std::size_t bytesWritten = co_await m_file.write(writeOffset, remaining);
+			writeOffset += bytesWritten;
+
+			// Skip over the buffers that were written in full and trim the
+			// one that was only partially written, if any.
+			while (!remaining.empty() && bytesWritten >= remaining.front().size)
+			{
+				bytesWritten -= remaining.front().size;
+				remaining = remaining.subspan(1);
+			}
+
+			if (bytesWritten > 0)
+			{
+				auto& partial = remaining.front();
+				partial.buffer = static_cast<const std::byte*>(partial.buffer) + bytesWritten;
+				partial.size -= bytesWritten;
+			}
+		}
+#endif
+
+		co_await m_file.sync_data();
+	}
+	catch (...)
+	{
+		batchException = std::current_exception();
+	}
+
+	// Hand leadership to the first append that queued up behind this batch,
+	// or mark the log idle if there isn't one.
+	append_waiter* nextLeader;
+	{
+		std::lock_guard lock{ m_mutex };
+		if (!batchException)
+		{
+			m_writeOffset = batchOffset + batchSize;
+		}
+
+		nextLeader = m_queueHead;
+		if (nextLeader == nullptr)
+		{
+			m_batchInProgress = false;
+		}
+	}
+
+	// NOTE: Once the log is idle it may be destroyed as soon as the last of
+	// the appends below is resumed, so we must not touch 'this' from here on.
+
+	if (nextLeader != nullptr)
+	{
+		// Start the next batch before resuming this batch's writers so that
+		// it overlaps with whatever they do next.
+		nextLeader->m_promotedToLeader = true;
+		nextLeader->m_completed.set();
+	}
+
+	for (auto* waiter = batch; waiter != nullptr;)
+	{
+		// Read the next pointer before resuming as resumption can free the waiter.
+		auto* next = waiter->m_next;
+		waiter->m_exception = batchException;
+		if (waiter != &leader)
+		{
+			waiter->m_completed.set();
+		}
+		waiter = next;
+	}
+}
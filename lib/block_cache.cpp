@@ -0,0 +1,286 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/block_cache.hpp>
+#include <cppcoro/when_all.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+	namespace local
+	{
+		// Blocks are aligned to a page boundary so that the cache can be used
+		// with files opened using file_buffering_mode::unbuffered.
+		constexpr std::size_t block_alignment = 4096;
+	}
+}
+
+struct cppcoro::block_cache::block
+{
+	explicit block(std::size_t capacity)
+		: m_data(static_cast<std::byte*>(::operator new(
+			capacity, std::align_val_t{ local::block_alignment })))
+		, m_size(0)
+	{}
+
+	~block()
+	{
+		::operator delete(m_data, std::align_val_t{ local::block_alignment });
+	}
+
+	block(const block&) = delete;
+	block& operator=(const block&) = delete;
+
+	std::byte* m_data;
+
+	// Number of valid bytes. Only less than the block size for the block
+	// containing the end of the file.
+	std::size_t m_size;
+};
+
+struct cppcoro::block_cache::shard
+{
+	struct slot
+	{
+		std::uint64_t m_blockIndex = 0;
+
+		// The load of the block. This may still be in progress, in which case
+		// lookups of the block await the same load.
+		shared_task<block_ptr> m_block;
+
+		bool m_occupied = false;
+
+		// CLOCK reference bit. Set on each lookup and cleared as the clock
+		// hand passes, so only blocks not looked up for a full revolution
+		// of the hand are evicted.
+		bool m_referenced = false;
+	};
+
+	/// Choose a slot to hold a new block, evicting the block in it if there is one.
+	///
+	/// Must be called with m_mutex held.
+	std::size_t acquire_slot() noexcept
+	{
+		for (;;)
+		{
+			const std::size_t slotIndex = m_clockHand;
+			m_clockHand = (m_clockHand + 1) % m_slots.size();
+
+			slot& s = m_slots[slotIndex];
+			if (s.m_occupied && s.m_referenced)
+			{
+				s.m_referenced = false;
+				continue;
+			}
+
+			if (s.m_occupied)
+			{
+				evict(slotIndex);
+			}
+
+			return slotIndex;
+		}
+	}
+
+	/// Must be called with m_mutex held.
+	void evict(std::size_t slotIndex) noexcept
+	{
+		slot& s = m_slots[slotIndex];
+		m_slotIndices.erase(s.m_blockIndex);
+
+		// Lookups that are still waiting on the load hold their own
+		// reference to it, so this doesn't affect them.
+		s.m_block = {};
+		s.m_occupied = false;
+		s.m_referenced = false;
+	}
+
+	std::mutex m_mutex;
+	std::unordered_map<std::uint64_t, std::size_t> m_slotIndices;
+	std::vector<slot> m_slots;
+	std::size_t m_clockHand = 0;
+
+	std::uint64_t m_hits = 0;
+	std::uint64_t m_misses = 0;
+	std::uint64_t m_coalesced = 0;
+};
+
+cppcoro::block_cache::block_cache(
+	const readable_file& file,
+	std::size_t blockSize,
+	std::size_t capacity,
+	std::size_t shardCount)
+	: m_file(file)
+	, m_blockSize(blockSize)
+	, m_shardCount(shardCount)
+	, m_shards(std::make_unique<shard[]>(shardCount))
+{
+	assert(blockSize > 0);
+	assert(capacity > 0);
+	assert(shardCount > 0);
+
+	const std::size_t slotsPerShard = (capacity + shardCount - 1) / shardCount;
+	for (std::size_t i = 0; i < shardCount; ++i)
+	{
+		m_shards[i].m_slots.resize(slotsPerShard);
+		m_shards[i].m_slotIndices.reserve(slotsPerShard);
+	}
+}
+
+cppcoro::block_cache::~block_cache()
+{
+}
+
+cppcoro::task<std::size_t> cppcoro::block_cache::read(
+	std::uint64_t offset,
+	void* buffer,
+	std::size_t byteCount)
+{
+	if (byteCount == 0)
+	{
+		co_return 0;
+	}
+
+	const std::uint64_t firstBlockIndex = offset / m_blockSize;
+	const std::uint64_t lastBlockIndex = (offset + byteCount - 1) / m_blockSize;
+
+	// Look up all of the blocks concurrently so that a read spanning several
+	// uncached blocks waits for one read of the file rather than one per block.
+	std::vector<block_ptr> blocks;
+	if (firstBlockIndex == lastBlockIndex)
+	{
+		blocks.push_back(co_await get_block(firstBlockIndex));
+	}
+	else
+	{
+		std::vector<task<block_ptr>> lookups;
+		lookups.reserve(static_cast<std::size_t>(lastBlockIndex - firstBlockIndex + 1));
+		for (auto blockIndex = firstBlockIndex; blockIndex <= lastBlockIndex; ++blockIndex)
+		{
+			lookups.push_back(get_block(blockIndex));
+		}
+
+		blocks = co_await when_all(std::move(lookups));
+	}
+
+	auto* output = static_cast<std::byte*>(buffer);
+	std::size_t bytesRead = 0;
+	std::size_t offsetInBlock = static_cast<std::size_t>(offset % m_blockSize);
+	for (const auto& b : blocks)
+	{
+		if (offsetInBlock >= b->m_size)
+		{
+			// Reached the end of the file.
+			break;
+		}
+
+		const std::size_t bytesToCopy = std::min(b->m_size - offsetInBlock, byteCount - bytesRead);
+		std::memcpy(output + bytesRead, b->m_data + offsetInBlock, bytesToCopy);
+		bytesRead += bytesToCopy;
+		offsetInBlock = 0;
+	}
+
+	co_return bytesRead;
+}
+
+cppcoro::block_cache::statistics cppcoro::block_cache::stats() const
+{
+	statistics result{ 0, 0, 0 };
+	for (std::size_t i = 0; i < m_shardCount; ++i)
+	{
+		shard& s = m_shards[i];
+		std::lock_guard lock{ s.m_mutex };
+		result.hits += s.m_hits;
+		result.misses += s.m_misses;
+		result.coalesced += s.m_coalesced;
+	}
+
+	return result;
+}
+
+cppcoro::block_cache::shard&
+cppcoro::block_cache::shard_for_block(std::uint64_t blockIndex) const noexcept
+{
+	return m_shards[static_cast<std::size_t>(blockIndex % m_shardCount)];
+}
+
+cppcoro::task<cppcoro::block_cache::block_ptr>
+cppcoro::block_cache::get_block(std::uint64_t blockIndex)
+{
+	shard& s = shard_for_block(blockIndex);
+
+	shared_task<block_ptr> load;
+	{
+		std::lock_guard lock{ s.m_mutex };
+
+		auto it = s.m_slotIndices.find(blockIndex);
+		if (it != s.m_slotIndices.end())
+		{
+			auto& slot = s.m_slots[it->second];
+			slot.m_referenced = true;
+			load = slot.m_block;
+
+			if (load.is_ready())
+			{
+				++s.m_hits;
+			}
+			else
+			{
+				++s.m_coalesced;
+			}
+		}
+		else
+		{
+			++s.m_misses;
+			load = load_block(blockIndex);
+
+			const std::size_t slotIndex = s.acquire_slot();
+			auto& slot = s.m_slots[slotIndex];
+			slot.m_blockIndex = blockIndex;
+			slot.m_block = load;
+			slot.m_occupied = true;
+			slot.m_referenced = true;
+			s.m_slotIndices.emplace(blockIndex, slotIndex);
+		}
+	}
+
+	try
+	{
+		co_return co_await load;
+	}
+	catch (...)
+	{
+		// Don't cache the failure. Remove the block so that the next lookup
+		// retries the read, unless that has already happened.
+		std::lock_guard lock{ s.m_mutex };
+		auto it = s.m_slotIndices.find(blockIndex);
+		if (it != s.m_slotIndices.end() && s.m_slots[it->second].m_block == load)
+		{
+			s.evict(it->second);
+		}
+
+		throw;
+	}
+}
+
+cppcoro::shared_task<cppcoro::block_cache::block_ptr>
+cppcoro::block_cache::load_block(std::uint64_t blockIndex)
+{
+	auto b = std::make_shared<block>(m_blockSize);
+
+	// Reads of regular files only come up short at end-of-file, so a short
+	// read means this is the last block. Don't try to read the rest: the
+	// offset wouldn't be aligned, which unbuffered reads reject.
+	b->m_size = co_await m_file.read(blockIndex * m_blockSize, b->m_data, m_blockSize);
+
+	co_return b;
+}
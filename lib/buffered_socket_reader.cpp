@@ -0,0 +1,171 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/net/buffered_socket_reader.hpp>
+
+#include <cassert>
+#include <cstring>
+
+cppcoro::net::buffered_socket_reader::buffered_socket_reader(
+	socket& socket,
+	std::size_t capacity)
+	: m_socket(socket)
+	, m_buffer(std::make_unique<std::byte[]>(capacity > 0 ? capacity : 1))
+	, m_capacity(capacity > 0 ? capacity : 1)
+	, m_begin(0)
+	, m_end(0)
+{
+}
+
+cppcoro::task<std::string_view>
+cppcoro::net::buffered_socket_reader::read_until(
+	std::string_view delimiter,
+	cancellation_token ct)
+{
+	assert(!delimiter.empty());
+
+	// Offset from m_begin to start searching from, so that data that has
+	// already been searched isn't searched again after each receive.
+	std::size_t searchOffset = 0;
+
+	while (true)
+	{
+		const std::string_view buffered{
+			reinterpret_cast<const char*>(m_buffer.get() + m_begin),
+			m_end - m_begin };
+
+		const auto position = buffered.find(delimiter, searchOffset);
+		if (position != std::string_view::npos)
+		{
+			const std::size_t size = position + delimiter.size();
+			co_return std::string_view{ reinterpret_cast<const char*>(consume(size)), size };
+		}
+
+		if (buffered.size() >= delimiter.size())
+		{
+			searchOffset = buffered.size() - delimiter.size() + 1;
+		}
+
+		if (buffered.size() == m_capacity)
+		{
+			throw_message_too_large();
+		}
+
+		reserve(1);
+
+		const std::size_t bytesReceived = co_await m_socket.recv(
+			m_buffer.get() + m_end, m_capacity - m_end, ct);
+		if (bytesReceived == 0)
+		{
+			if (m_begin == m_end)
+			{
+				co_return std::string_view{};
+			}
+
+			throw_connection_closed();
+		}
+
+		m_end += bytesReceived;
+	}
+}
+
+cppcoro::task<std::span<const std::byte>>
+cppcoro::net::buffered_socket_reader::read_exact(
+	std::size_t size,
+	cancellation_token ct)
+{
+	const bool received = co_await fill(size, true, std::move(ct));
+	if (!received)
+	{
+		co_return std::span<const std::byte>{};
+	}
+
+	co_return std::span<const std::byte>{ consume(size), size };
+}
+
+cppcoro::task<bool> cppcoro::net::buffered_socket_reader::fill(
+	std::size_t size,
+	bool eofAllowed,
+	cancellation_token ct)
+{
+	if (size > m_capacity)
+	{
+		throw_message_too_large();
+	}
+
+	if (m_end - m_begin >= size)
+	{
+		co_return true;
+	}
+
+	reserve(size - (m_end - m_begin));
+
+	while (m_end - m_begin < size)
+	{
+		// Receive as much as there is room for, not just what is needed for
+		// this message, so that following messages can be read without
+		// another system call.
+		const std::size_t bytesReceived = co_await m_socket.recv(
+			m_buffer.get() + m_end, m_capacity - m_end, ct);
+		if (bytesReceived == 0)
+		{
+			if (eofAllowed && m_begin == m_end)
+			{
+				co_return false;
+			}
+
+			throw_connection_closed();
+		}
+
+		m_end += bytesReceived;
+	}
+
+	co_return true;
+}
+
+void cppcoro::net::buffered_socket_reader::reserve(std::size_t size) noexcept
+{
+	assert(m_end - m_begin + size <= m_capacity);
+
+	if (m_capacity - m_end < size)
+	{
+		std::memmove(m_buffer.get(), m_buffer.get() + m_begin, m_end - m_begin);
+		m_end -= m_begin;
+		m_begin = 0;
+	}
+}
+
+std::byte* cppcoro::net::buffered_socket_reader::consume(std::size_t size) noexcept
+{
+	assert(m_end - m_begin >= size);
+
+	std::byte* data = m_buffer.get() + m_begin;
+	m_begin += size;
+
+	if (m_begin == m_end)
+	{
+		// Nothing left to keep, so the next receive can start at the
+		// beginning of the buffer without moving anything. The data just
+		// consumed stays put until then.
+		m_begin = 0;
+		m_end = 0;
+	}
+
+	return data;
+}
+
+void cppcoro::net::buffered_socket_reader::throw_message_too_large()
+{
+	throw std::system_error(
+		std::make_error_code(std::errc::message_size),
+		"message is larger than the buffered_socket_reader capacity");
+}
+
+void cppcoro::net::buffered_socket_reader::throw_connection_closed()
+{
+	throw std::system_error(
+		std::make_error_code(std::errc::connection_aborted),
+		"connection closed part-way through a message");
+}
@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/net/buffered_socket_writer.hpp>
+
+#include <cstring>
+#include <span>
+
+cppcoro::net::buffered_socket_writer::buffered_socket_writer(
+	socket& socket,
+	std::size_t highWaterMark)
+	: m_socket(socket)
+	, m_buffer(std::make_unique<std::byte[]>(highWaterMark > 0 ? highWaterMark : 1))
+	, m_capacity(highWaterMark > 0 ? highWaterMark : 1)
+	, m_size(0)
+{
+}
+
+cppcoro::task<> cppcoro::net::buffered_socket_writer::write(
+	const void* data,
+	std::size_t size,
+	cancellation_token ct)
+{
+	if (size <= m_capacity - m_size)
+	{
+		std::memcpy(m_buffer.get() + m_size, data, size);
+		m_size += size;
+
+		if (m_size == m_capacity)
+		{
+			co_await flush(std::move(ct));
+		}
+
+		co_return;
+	}
+
+	// Send the buffered data and the new data together rather than
+	// copying the new data into the buffer piecemeal.
+	const_buffer buffers[2] = {
+		const_buffer{ m_buffer.get(), m_size },
+		const_buffer{ data, size },
+	};
+	co_await send_all(buffers, 2, std::move(ct));
+	m_size = 0;
+}
+
+cppcoro::task<> cppcoro::net::buffered_socket_writer::flush(cancellation_token ct)
+{
+	if (m_size == 0)
+	{
+		co_return;
+	}
+
+	const_buffer buffer{ m_buffer.get(), m_size };
+	co_await send_all(&buffer, 1, std::move(ct));
+	m_size = 0;
+}
+
+cppcoro::task<> cppcoro::net::buffered_socket_writer::send_all(
+	const_buffer* buffers,
+	std::size_t count,
+	cancellation_token ct)
+{
+	while (count > 0)
+	{
+		std::size_t bytesSent = co_await m_socket.send(
+			std::span<const const_buffer>{ buffers, count }, ct);
+
+		while (count > 0 && bytesSent >= buffers->size)
+		{
+			bytesSent -= buffers->size;
+			++buffers;
+			--count;
+		}
+
+		if (count > 0)
+		{
+			buffers->buffer = static_cast<const std::byte*>(buffers->buffer) + bytesSent;
+			buffers->size -= bytesSent;
+		}
+	}
+}
@@ -0,0 +1,372 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/net/connection_pool.hpp>
+
+#include <cppcoro/cancellation_registration.hpp>
+#include <cppcoro/io_service.hpp>
+#include <cppcoro/on_scope_exit.hpp>
+#include <cppcoro/operation_cancelled.hpp>
+
+#include <cassert>
+#include <utility>
+
+#if CPPCORO_OS_WINNT
+# include <WinSock2.h>
+# include <Windows.h>
+#elif CPPCORO_OS_LINUX
+# include <poll.h>
+#endif
+
+cppcoro::net::pooled_connection::pooled_connection(
+	connection_pool& pool,
+	const ip_endpoint& remoteEndPoint,
+	socket&& connection) noexcept
+	: m_pool(&pool)
+	, m_remoteEndPoint(remoteEndPoint)
+	, m_socket(std::move(connection))
+{
+}
+
+cppcoro::net::pooled_connection::pooled_connection(pooled_connection&& other) noexcept
+	: m_pool(std::exchange(other.m_pool, nullptr))
+	, m_remoteEndPoint(other.m_remoteEndPoint)
+	, m_socket(std::move(other.m_socket))
+{
+	other.m_socket.reset();
+}
+
+cppcoro::net::pooled_connection::~pooled_connection()
+{
+	release();
+}
+
+cppcoro::net::pooled_connection&
+cppcoro::net::pooled_connection::operator=(pooled_connection&& other) noexcept
+{
+	if (this != &other)
+	{
+		release();
+
+		m_pool = std::exchange(other.m_pool, nullptr);
+		m_remoteEndPoint = other.m_remoteEndPoint;
+		m_socket = std::move(other.m_socket);
+		other.m_socket.reset();
+	}
+
+	return *this;
+}
+
+void cppcoro::net::pooled_connection::release() noexcept
+{
+	if (m_socket)
+	{
+		m_pool->release(m_remoteEndPoint, std::move(*m_socket));
+		m_socket.reset();
+	}
+}
+
+void cppcoro::net::pooled_connection::discard() noexcept
+{
+	m_socket.reset();
+}
+
+cppcoro::net::connection_pool::connection_pool(
+	io_service& ioSvc,
+	std::size_t maxIdlePerEndPoint,
+	std::size_t maxConnectsPerEndPoint,
+	std::chrono::milliseconds idleTimeout)
+	: m_ioService(ioSvc)
+	, m_maxIdlePerEndPoint(maxIdlePerEndPoint)
+	, m_maxConnectsPerEndPoint(maxConnectsPerEndPoint > 0 ? maxConnectsPerEndPoint : 1)
+	, m_idleTimeout(idleTimeout)
+	, m_idleCount(0)
+{
+}
+
+cppcoro::net::connection_pool::~connection_pool()
+{
+#ifndef NDEBUG
+	for (auto& [remoteEndPoint, state] : m_endPoints)
+	{
+		assert(state.m_waitersHead == nullptr);
+		assert(state.m_connectCount == 0);
+	}
+#endif
+}
+
+cppcoro::task<cppcoro::net::pooled_connection>
+cppcoro::net::connection_pool::acquire(ip_endpoint remoteEndPoint, cancellation_token ct)
+{
+	while (true)
+	{
+		waiter w;
+
+		const acquire_action action = try_acquire(remoteEndPoint, w);
+		if (action == acquire_action::reuse)
+		{
+			co_return pooled_connection{ *this, remoteEndPoint, std::move(*w.m_connection) };
+		}
+
+		if (action == acquire_action::wait)
+		{
+			{
+				std::optional<cancellation_registration> registration;
+				if (ct.can_be_cancelled())
+				{
+					registration.emplace(ct, [&] { cancel_wait(remoteEndPoint, w); });
+				}
+
+				co_await w.m_event;
+			}
+
+			if (w.m_connection)
+			{
+				co_return pooled_connection{ *this, remoteEndPoint, std::move(*w.m_connection) };
+			}
+
+			if (w.m_cancelled)
+			{
+				throw operation_cancelled{};
+			}
+
+			if (!w.m_mayConnect)
+			{
+				continue;
+			}
+		}
+
+		pooled_connection connection = co_await connect(remoteEndPoint, std::move(ct));
+		co_return connection;
+	}
+}
+
+std::size_t cppcoro::net::connection_pool::idle_count() const noexcept
+{
+	std::lock_guard lock{ m_mutex };
+	return m_idleCount;
+}
+
+void cppcoro::net::connection_pool::close_idle() noexcept
+{
+	std::lock_guard lock{ m_mutex };
+	for (auto& [remoteEndPoint, state] : m_endPoints)
+	{
+		state.m_idle.clear();
+	}
+	m_idleCount = 0;
+}
+
+cppcoro::net::connection_pool::acquire_action
+cppcoro::net::connection_pool::try_acquire(const ip_endpoint& remoteEndPoint, waiter& w)
+{
+	std::lock_guard lock{ m_mutex };
+
+	end_point_state& state = m_endPoints[remoteEndPoint];
+
+	// Reuse the most recently released connection as it is the least likely
+	// to have been closed by the peer, and it lets the rest time out.
+	const auto now = clock::now();
+	while (!state.m_idle.empty())
+	{
+		idle_connection connection = std::move(state.m_idle.back());
+		state.m_idle.pop_back();
+		--m_idleCount;
+
+		if (now - connection.m_releaseTime > m_idleTimeout)
+		{
+			// All of the others were released earlier so have timed out too.
+			m_idleCount -= state.m_idle.size();
+			state.m_idle.clear();
+			break;
+		}
+
+		if (is_usable(connection.m_socket))
+		{
+			w.m_connection.emplace(std::move(connection.m_socket));
+			return acquire_action::reuse;
+		}
+	}
+
+	if (state.m_connectCount < m_maxConnectsPerEndPoint)
+	{
+		++state.m_connectCount;
+		return acquire_action::connect;
+	}
+
+	w.m_previous = state.m_waitersTail;
+	if (state.m_waitersTail != nullptr)
+	{
+		state.m_waitersTail->m_next = &w;
+	}
+	else
+	{
+		state.m_waitersHead = &w;
+	}
+	state.m_waitersTail = &w;
+
+	return acquire_action::wait;
+}
+
+cppcoro::task<cppcoro::net::pooled_connection>
+cppcoro::net::connection_pool::connect(ip_endpoint remoteEndPoint, cancellation_token ct)
+{
+	auto finishOnExit = on_scope_exit([&] { connect_finished(remoteEndPoint); });
+
+	socket connection = remoteEndPoint.is_ipv4()
+		? socket::create_tcpv4(m_ioService)
+		: socket::create_tcpv6(m_ioService);
+	if (remoteEndPoint.is_ipv4())
+	{
+		connection.bind(ipv4_endpoint{});
+	}
+	else
+	{
+		connection.bind(ipv6_endpoint{});
+	}
+
+	co_await connection.connect(remoteEndPoint, std::move(ct));
+
+	co_return pooled_connection{ *this, remoteEndPoint, std::move(connection) };
+}
+
+void cppcoro::net::connection_pool::connect_finished(const ip_endpoint& remoteEndPoint) noexcept
+{
+	waiter* w;
+	{
+		std::lock_guard lock{ m_mutex };
+
+		end_point_state& state = m_endPoints[remoteEndPoint];
+		w = pop_waiter(state);
+		if (w != nullptr)
+		{
+			// Pass the connect on rather than freeing it up, so that the
+			// waiter can't lose it to a new call to acquire().
+			w->m_mayConnect = true;
+		}
+		else
+		{
+			--state.m_connectCount;
+		}
+	}
+
+	if (w != nullptr)
+	{
+		w->m_event.set();
+	}
+}
+
+void cppcoro::net::connection_pool::release(
+	const ip_endpoint& remoteEndPoint,
+	socket&& connection) noexcept
+{
+	waiter* w;
+	{
+		std::lock_guard lock{ m_mutex };
+
+		end_point_state& state = m_endPoints[remoteEndPoint];
+		w = pop_waiter(state);
+		if (w != nullptr)
+		{
+			w->m_connection.emplace(std::move(connection));
+		}
+		else if (m_maxIdlePerEndPoint > 0)
+		{
+			if (state.m_idle.size() == m_maxIdlePerEndPoint)
+			{
+				state.m_idle.pop_front();
+				--m_idleCount;
+			}
+
+			state.m_idle.push_back(idle_connection{ std::move(connection), clock::now() });
+			++m_idleCount;
+		}
+	}
+
+	if (w != nullptr)
+	{
+		w->m_event.set();
+	}
+}
+
+void cppcoro::net::connection_pool::cancel_wait(
+	const ip_endpoint& remoteEndPoint,
+	waiter& w) noexcept
+{
+	{
+		std::lock_guard lock{ m_mutex };
+
+		end_point_state& state = m_endPoints[remoteEndPoint];
+
+		// If the waiter is no longer queued then it has already been given a
+		// connection or a connect and will be resumed with that instead.
+		if (w.m_previous == nullptr && state.m_waitersHead != &w)
+		{
+			return;
+		}
+
+		if (w.m_previous != nullptr)
+		{
+			w.m_previous->m_next = w.m_next;
+		}
+		else
+		{
+			state.m_waitersHead = w.m_next;
+		}
+
+		if (w.m_next != nullptr)
+		{
+			w.m_next->m_previous = w.m_previous;
+		}
+		else
+		{
+			state.m_waitersTail = w.m_previous;
+		}
+
+		w.m_cancelled = true;
+	}
+
+	w.m_event.set();
+}
+
+cppcoro::net::connection_pool::waiter*
+cppcoro::net::connection_pool::pop_waiter(end_point_state& state) noexcept
+{
+	waiter* w = state.m_waitersHead;
+	if (w != nullptr)
+	{
+		state.m_waitersHead = w->m_next;
+		if (state.m_waitersHead != nullptr)
+		{
+			state.m_waitersHead->m_previous = nullptr;
+		}
+		else
+		{
+			state.m_waitersTail = nullptr;
+		}
+
+		w->m_next = nullptr;
+	}
+
+	return w;
+}
+
+bool cppcoro::net::connection_pool::is_usable(socket& connection) noexcept
+{
+	// The peer shouldn't send anything on a connection that has no request
+	// outstanding, so a readable connection has either been closed by the
+	// peer or is out of step with it.
+#if CPPCORO_OS_WINNT
+	WSAPOLLFD pollFd{};
+	pollFd.fd = connection.native_handle();
+	pollFd.events = POLLRDNORM;
+	return ::WSAPoll(&pollFd, 1, 0) == 0;
+#elif CPPCORO_OS_LINUX
+	pollfd pollFd{};
+	pollFd.fd = connection.native_handle();
+	pollFd.events = POLLIN;
+	return ::poll(&pollFd, 1, 0) == 0;
+#endif
+}
@@ -0,0 +1,280 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/copy_file.hpp>
+#include <cppcoro/io_service.hpp>
+#include <cppcoro/static_thread_pool.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <system_error>
+
+#if CPPCORO_OS_LINUX
+# include <cerrno>
+# include <unistd.h>
+#endif
+
+namespace
+{
+	namespace local
+	{
+		constexpr std::size_t copy_chunk_size = 1024 * 1024;
+
+		// The buffered copy reads and writes whole multiples of this, from a
+		// buffer aligned to it, so that it can be used with files opened using
+		// file_buffering_mode::unbuffered.
+		constexpr std::size_t copy_buffer_alignment = 4096;
+
+		constexpr std::size_t round_up_to_alignment(std::size_t byteCount) noexcept
+		{
+			return (byteCount + copy_buffer_alignment - 1) & ~(copy_buffer_alignment - 1);
+		}
+
+		struct aligned_buffer_deleter
+		{
+			void operator()(std::byte* buffer) const noexcept
+			{
+				::operator delete(buffer, std::align_val_t{ copy_buffer_alignment });
+			}
+		};
+
+		using aligned_buffer = std::unique_ptr<std::byte, aligned_buffer_deleter>;
+
+		aligned_buffer allocate_copy_buffer()
+		{
+			return aligned_buffer{ static_cast<std::byte*>(::operator new(
+				copy_chunk_size,
+				std::align_val_t{ copy_buffer_alignment })) };
+		}
+
+		/// Copy a chunk by reading it into a buffer and writing it back out.
+		///
+		/// The read always asks for a whole number of blocks and lets it come
+		/// up short at end-of-file. If the data to write doesn't end on a block
+		/// boundary and nothing in the destination follows it, the write is
+		/// padded out to a whole block and the destination truncated back
+		/// afterwards. An unaligned tail in the middle of the destination is
+		/// written as-is, which unbuffered files reject.
+		///
+		/// \return
+		/// The number of bytes copied. Zero if \a offset is at or past the
+		/// end of the source file.
+		cppcoro::task<std::size_t> copy_chunk_buffered(
+			cppcoro::readable_file& source,
+			cppcoro::writable_file& destination,
+			std::uint64_t offset,
+			std::size_t byteCount,
+			std::byte* buffer,
+			cppcoro::cancellation_token ct)
+		{
+			const std::size_t bytesRead = co_await source.read(
+				offset, buffer, round_up_to_alignment(byteCount), ct);
+			const std::size_t bytesToCopy = std::min(bytesRead, byteCount);
+
+			std::size_t bytesToWrite = bytesToCopy;
+			const bool isPadded =
+				bytesToCopy % copy_buffer_alignment != 0 &&
+				destination.size() <= offset + bytesToCopy;
+			if (isPadded)
+			{
+				bytesToWrite = round_up_to_alignment(bytesToCopy);
+				std::memset(buffer + bytesToCopy, 0, bytesToWrite - bytesToCopy);
+			}
+
+			std::size_t bytesWritten = 0;
+			while (bytesWritten < bytesToWrite)
+			{
+				const std::size_t result = co_await destination.write(
+					offset + bytesWritten,
+					buffer + bytesWritten,
+					bytesToWrite - bytesWritten,
+					ct);
+				if (result == 0)
+				{
+					throw std::system_error
+					{
+						std::make_error_code(std::errc::io_error),
+						"Error copying file: write made no progress"
+					};
+				}
+
+				bytesWritten += result;
+			}
+
+			if (isPadded)
+			{
+				destination.set_size(offset + bytesToCopy);
+			}
+
+			co_return bytesToCopy;
+		}
+
+#if CPPCORO_OS_LINUX
+		/// Copy a chunk using copy_file_range().
+		///
+		/// \return
+		/// The number of bytes copied, zero if \a offset is at or past the end
+		/// of the source file, or a negative errno value on failure.
+		std::int64_t copy_chunk_in_kernel(
+			int sourceFd,
+			int destinationFd,
+			std::uint64_t offset,
+			std::size_t byteCount) noexcept
+		{
+			loff_t sourceOffset = static_cast<loff_t>(offset);
+			loff_t destinationOffset = static_cast<loff_t>(offset);
+
+			ssize_t result;
+			do
+			{
+				result = ::copy_file_range(
+					sourceFd, &sourceOffset, destinationFd, &destinationOffset, byteCount, 0);
+			} while (result < 0 && errno == EINTR);
+
+			return result < 0 ? -errno : result;
+		}
+
+		/// Query whether a copy_file_range() failure means that it can't be
+		/// used for this pair of files, rather than that the copy failed.
+		bool is_unsupported_by_files(int errorCode) noexcept
+		{
+			return errorCode == EXDEV ||
+				errorCode == EINVAL ||
+				errorCode == ENOSYS ||
+				errorCode == EOPNOTSUPP ||
+				errorCode == EBADF;
+		}
+#endif
+	}
+}
+
+cppcoro::task<std::uint64_t> cppcoro::copy_file(
+	io_service& ioService,
+	static_thread_pool& blockingPool,
+	readable_file& source,
+	writable_file& destination,
+	std::uint64_t offset,
+	std::uint64_t length,
+	cancellation_token ct)
+{
+	std::uint64_t bytesCopied = 0;
+
+	auto progress = copy_file_with_progress(
+		ioService, blockingPool, source, destination, offset, length, std::move(ct));
+	auto it = co_await progress.begin();
+	while (it != progress.end())
+	{
+		bytesCopied = *it;
+		(void)co_await ++it;
+	}
+
+	co_return bytesCopied;
+}
+
+cppcoro::async_generator<std::uint64_t> cppcoro::copy_file_with_progress(
+	io_service& ioService,
+	static_thread_pool& blockingPool,
+	readable_file& source,
+	writable_file& destination,
+	std::uint64_t offset,
+	std::uint64_t length,
+	cancellation_token ct)
+{
+	// Only allocated if we end up needing to copy through user space.
+	local::aligned_buffer buffer;
+
+#if CPPCORO_OS_LINUX
+	bool useCopyFileRange = true;
+#else
+	(void)ioService;
+	(void)blockingPool;
+	const bool useCopyFileRange = false;
+#endif
+
+	std::uint64_t bytesCopied = 0;
+	while (bytesCopied < length)
+	{
+		ct.throw_if_cancellation_requested();
+
+		const std::uint64_t chunkOffset = offset + bytesCopied;
+		const std::size_t chunkSize = static_cast<std::size_t>(
+			std::min<std::uint64_t>(local::copy_chunk_size, length - bytesCopied));
+
+		std::size_t chunkBytesCopied = 0;
+		bool isEndOfSource = false;
+
+#if CPPCORO_OS_LINUX
+		if (useCopyFileRange)
+		{
+			// copy_file_range() blocks until the chunk has been copied, so
+			// make the call on the blocking pool rather than stalling an I/O
+			// thread, and come back to the I/O service before carrying on.
+			co_await blockingPool.schedule();
+
+			const std::int64_t result = local::copy_chunk_in_kernel(
+				source.native_handle(),
+				destination.native_handle(),
+				chunkOffset,
+				chunkSize);
+
+			co_await ioService.schedule();
+			if (result >= 0)
+			{
+				chunkBytesCopied = static_cast<std::size_t>(result);
+			}
+			else if (local::is_unsupported_by_files(static_cast<int>(-result)))
+			{
+				// This can happen part-way through, eg. an unbuffered file
+				// rejecting the unaligned last chunk, so fall back for the
+				// rest of the copy. If it was a genuine error then the
+				// buffered copy will report it.
+				useCopyFileRange = false;
+			}
+			else
+			{
+				throw std::system_error
+				{
+					static_cast<int>(-result),
+					std::system_category(),
+					"Error copying file: copy_file_range"
+				};
+			}
+		}
+#endif
+
+		if (!useCopyFileRange)
+		{
+			if (!buffer)
+			{
+				buffer = local::allocate_copy_buffer();
+			}
+
+			chunkBytesCopied = co_await local::copy_chunk_buffered(
+				source, destination, chunkOffset, chunkSize, buffer.get(), ct);
+
+			// A short read only happens at end-of-file. Stop here rather than
+			// reading again from an offset that unbuffered files may reject.
+			isEndOfSource = chunkBytesCopied < chunkSize;
+		}
+
+		if (chunkBytesCopied == 0)
+		{
+			// Reached the end of the source file.
+			break;
+		}
+
+		bytesCopied += chunkBytesCopied;
+
+		co_yield bytesCopied;
+
+		if (isEndOfSource)
+		{
+			break;
+		}
+	}
+}
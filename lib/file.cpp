@@ -14,6 +14,10 @@
 #  define WIN32_LEAN_AND_MEAN
 # endif
 # include <Windows.h>
+#elif CPPCORO_OS_LINUX
+# include <fcntl.h>
+# include <sys/stat.h>
+# include <unistd.h>
 #endif
 
 cppcoro::file::~file()
@@ -36,9 +40,24 @@ std::uint64_t cppcoro::file::size() const
 	}
 
 	return size.QuadPart;
+#elif CPPCORO_OS_LINUX
+	struct stat fileStatus;
+	if (::fstat(m_fileDescriptor.fd(), &fileStatus) == -1)
+	{
+		throw std::system_error
+		{
+			errno,
+			std::system_category(),
+			"error getting file size: fstat"
+		};
+	}
+
+	return static_cast<std::uint64_t>(fileStatus.st_size);
 #endif
 }
 
+#if CPPCORO_OS_WINNT
+
 cppcoro::file::file(detail::win32::safe_handle&& fileHandle) noexcept
 	: m_fileHandle(std::move(fileHandle))
 {
@@ -166,3 +185,83 @@ cppcoro::detail::win32::safe_handle cppcoro::file::open(
 
 	return std::move(fileHandle);
 }
+
+#elif CPPCORO_OS_LINUX
+
+cppcoro::file::file(
+	detail::lnx::safe_fd&& fileDescriptor,
+	io_service* ioService) noexcept
+	: m_fileDescriptor(std::move(fileDescriptor))
+	, m_ioService(ioService)
+{
+}
+
+cppcoro::detail::lnx::safe_fd cppcoro::file::open(
+	int fileAccess,
+	[[maybe_unused]] io_service& ioService,
+	const cppcoro::filesystem::path& path,
+	file_open_mode openMode,
+	[[maybe_unused]] file_share_mode shareMode,
+	file_buffering_mode bufferingMode)
+{
+	// NOTE: There is no equivalent of the Windows share modes as Linux
+	// only supports advisory locking, so the share mode is ignored.
+
+	int flags = fileAccess | O_CLOEXEC;
+	if ((bufferingMode & file_buffering_mode::write_through) == file_buffering_mode::write_through)
+	{
+		flags |= O_DSYNC;
+	}
+	if ((bufferingMode & file_buffering_mode::unbuffered) == file_buffering_mode::unbuffered)
+	{
+		flags |= O_DIRECT;
+	}
+
+	switch (openMode)
+	{
+	case file_open_mode::create_or_open:
+		flags |= O_CREAT;
+		break;
+	case file_open_mode::create_always:
+		flags |= O_CREAT | O_TRUNC;
+		break;
+	case file_open_mode::create_new:
+		flags |= O_CREAT | O_EXCL;
+		break;
+	case file_open_mode::open_existing:
+		break;
+	case file_open_mode::truncate_existing:
+		flags |= O_TRUNC;
+		break;
+	}
+
+	// Open the file
+	detail::lnx::safe_fd fileDescriptor{ ::open(path.c_str(), flags, 0666) };
+	if (fileDescriptor == -1)
+	{
+		throw std::system_error
+		{
+			errno,
+			std::system_category(),
+			"error opening file: open"
+		};
+	}
+
+	// Access pattern hints. These are only advisory so failure is not an error.
+	if ((bufferingMode & file_buffering_mode::random_access) == file_buffering_mode::random_access)
+	{
+		(void)::posix_fadvise(fileDescriptor.fd(), 0, 0, POSIX_FADV_RANDOM);
+	}
+	if ((bufferingMode & file_buffering_mode::sequential) == file_buffering_mode::sequential)
+	{
+		(void)::posix_fadvise(fileDescriptor.fd(), 0, 0, POSIX_FADV_SEQUENTIAL);
+	}
+
+	// Unlike an I/O completion port, an io_uring does not need the file to be
+	// associated with it up-front. Operations on the file are submitted to
+	// the io_service's io_uring when they are started.
+
+	return fileDescriptor;
+}
+
+#endif
@@ -0,0 +1,355 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/file_read_many_operation.hpp>
+#include <cppcoro/operation_cancelled.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+#if CPPCORO_OS_WINNT
+# ifndef WIN32_LEAN_AND_MEAN
+#  define WIN32_LEAN_AND_MEAN
+# endif
+# include <Windows.h>
+
+struct cppcoro::file_read_many_operation::read_state : cppcoro::detail::win32::io_state
+{
+	file_read_many_operation* m_operation;
+	file_read_request* m_request;
+};
+
+cppcoro::file_read_many_operation::file_read_many_operation(
+	detail::win32::handle_t fileHandle,
+	std::span<file_read_request> requests,
+	cancellation_token ct) noexcept
+	: m_fileHandle(fileHandle)
+	, m_requests(requests)
+	, m_submittedCount(0)
+	, m_remainingCount(requests.size() + 1)
+	, m_cancellationRequested(false)
+	, m_submissionCompleted(false)
+	, m_cancellationToken(std::move(ct))
+{
+}
+
+cppcoro::file_read_many_operation::file_read_many_operation(
+	file_read_many_operation&& other) noexcept
+	: m_fileHandle(other.m_fileHandle)
+	, m_requests(other.m_requests)
+	, m_submittedCount(0)
+	, m_remainingCount(other.m_requests.size() + 1)
+	, m_cancellationRequested(false)
+	, m_submissionCompleted(false)
+	, m_cancellationToken(std::move(other.m_cancellationToken))
+{
+	// Only valid to move the operation before it has been started.
+	assert(other.m_states == nullptr);
+}
+
+bool cppcoro::file_read_many_operation::await_suspend(
+	cppcoro::coroutine_handle<> awaitingCoroutine)
+{
+	m_awaitingCoroutine = awaitingCoroutine;
+
+	m_states = std::make_unique<read_state[]>(m_requests.size());
+
+	// Register the cancellation callback before starting any reads so that
+	// everything after the first read is started is noexcept.
+	// See win32_overlapped_operation_cancellable::await_suspend().
+	if (m_cancellationToken.can_be_cancelled())
+	{
+		m_cancellationRegistration.emplace(
+			std::move(m_cancellationToken),
+			[this] { this->on_cancellation_requested(); });
+	}
+
+	for (auto& request : m_requests)
+	{
+		request.bytesRead = 0;
+		request.error.clear();
+	}
+
+	// Issue every read before waiting on any of them, so the device sees the
+	// whole batch at once and we only pay for a single coroutine resumption.
+	for (auto& request : m_requests)
+	{
+		if (m_cancellationRequested.load(std::memory_order_relaxed))
+		{
+			// Don't bother starting the rest of the batch.
+			request.error = std::error_code{
+				ERROR_OPERATION_ABORTED, std::system_category() };
+			on_request_finished();
+			continue;
+		}
+
+		auto& state = m_states[m_submittedCount++];
+		state.Offset = static_cast<DWORD>(request.offset);
+		state.OffsetHigh = static_cast<DWORD>(request.offset >> 32);
+		state.m_callback = &file_read_many_operation::on_read_completed;
+		state.m_operation = this;
+		state.m_request = &request;
+
+		const DWORD numberOfBytesToRead =
+			request.byteCount <= 0xFFFFFFFF ?
+			static_cast<DWORD>(request.byteCount) : DWORD(0xFFFFFFFF);
+
+		DWORD numberOfBytesRead = 0;
+		const BOOL ok = ::ReadFile(
+			m_fileHandle,
+			request.buffer,
+			numberOfBytesToRead,
+			&numberOfBytesRead,
+			reinterpret_cast<LPOVERLAPPED>(static_cast<detail::win32::overlapped*>(&state)));
+		const DWORD errorCode = ok ? ERROR_SUCCESS : ::GetLastError();
+		if (errorCode != ERROR_IO_PENDING)
+		{
+			// Completed synchronously.
+			//
+			// We are assuming that the file-handle has been set to the
+			// mode where synchronous completions do not post a completion
+			// event to the I/O completion port.
+			on_read_completed(&state, errorCode, numberOfBytesRead, 0);
+		}
+	}
+
+	// Use sequentially-consistent ordering here so that either we observe
+	// the cancellation request or the cancellation callback observes that
+	// submission has finished (or both).
+	m_submissionCompleted.store(true, std::memory_order_seq_cst);
+	if (m_cancellationRequested.load(std::memory_order_seq_cst))
+	{
+		cancel_outstanding_reads();
+	}
+
+	// Release the reference held while submitting. If every read has already
+	// completed then continue without suspending.
+	return m_remainingCount.fetch_sub(1, std::memory_order_acq_rel) != 1;
+}
+
+void cppcoro::file_read_many_operation::on_read_completed(
+	detail::win32::io_state* ioState,
+	detail::win32::dword_t errorCode,
+	detail::win32::dword_t numberOfBytesTransferred,
+	[[maybe_unused]] detail::win32::ulongptr_t completionKey) noexcept
+{
+	auto* state = static_cast<read_state*>(ioState);
+	auto* request = state->m_request;
+
+	request->bytesRead = numberOfBytesTransferred;
+	if (errorCode != ERROR_SUCCESS)
+	{
+		request->error = std::error_code{
+			static_cast<int>(errorCode), std::system_category() };
+	}
+
+	state->m_operation->on_request_finished();
+}
+
+void cppcoro::file_read_many_operation::cancel_outstanding_reads() noexcept
+{
+	// Requests that have already completed will fail with ERROR_NOT_FOUND
+	// which is harmless. The states remain valid until await_resume() has
+	// deregistered the cancellation callback.
+	for (std::size_t i = 0; i < m_submittedCount; ++i)
+	{
+		(void)::CancelIoEx(
+			m_fileHandle,
+			reinterpret_cast<LPOVERLAPPED>(
+				static_cast<detail::win32::overlapped*>(&m_states[i])));
+	}
+}
+
+#elif CPPCORO_OS_LINUX
+# include <linux/io_uring.h>
+
+struct cppcoro::file_read_many_operation::read_state : cppcoro::detail::lnx::io_state
+{
+	file_read_many_operation* m_operation;
+	file_read_request* m_request;
+};
+
+cppcoro::file_read_many_operation::file_read_many_operation(
+	detail::lnx::io_uring_queue& ioQueue,
+	detail::lnx::fd_t fileDescriptor,
+	std::span<file_read_request> requests,
+	cancellation_token ct) noexcept
+	: m_ioQueue(ioQueue)
+	, m_fileDescriptor(fileDescriptor)
+	, m_requests(requests)
+	, m_submittedCount(0)
+	, m_remainingCount(requests.size() + 1)
+	, m_cancellationRequested(false)
+	, m_submissionCompleted(false)
+	, m_cancellationToken(std::move(ct))
+{
+}
+
+cppcoro::file_read_many_operation::file_read_many_operation(
+	file_read_many_operation&& other) noexcept
+	: m_ioQueue(other.m_ioQueue)
+	, m_fileDescriptor(other.m_fileDescriptor)
+	, m_requests(other.m_requests)
+	, m_submittedCount(0)
+	, m_remainingCount(other.m_requests.size() + 1)
+	, m_cancellationRequested(false)
+	, m_submissionCompleted(false)
+	, m_cancellationToken(std::move(other.m_cancellationToken))
+{
+	// Only valid to move the operation before it has been started.
+	assert(other.m_states == nullptr);
+}
+
+bool cppcoro::file_read_many_operation::await_suspend(
+	cppcoro::coroutine_handle<> awaitingCoroutine)
+{
+	m_awaitingCoroutine = awaitingCoroutine;
+
+	m_states = std::make_unique<read_state[]>(m_requests.size());
+
+	// Register the cancellation callback before starting any reads so that
+	// everything after the first read is started is noexcept.
+	if (m_cancellationToken.can_be_cancelled())
+	{
+		m_cancellationRegistration.emplace(
+			std::move(m_cancellationToken),
+			[this] { this->on_cancellation_requested(); });
+	}
+
+	for (auto& request : m_requests)
+	{
+		request.bytesRead = 0;
+		request.error.clear();
+	}
+
+	// Prepare every read and then submit them all to the kernel with a
+	// single system call.
+	{
+		std::lock_guard lock{ m_ioQueue.submission_mutex() };
+
+		for (auto& request : m_requests)
+		{
+			io_uring_sqe* sqe = m_cancellationRequested.load(std::memory_order_relaxed) ?
+				nullptr : m_ioQueue.get_sqe();
+			if (sqe == nullptr)
+			{
+				// Either cancellation was requested, in which case don't bother
+				// starting the rest of the batch, or the submission queue is full.
+				request.error = std::error_code{
+					m_cancellationRequested.load(std::memory_order_relaxed) ? ECANCELED : EBUSY,
+					std::system_category() };
+				on_request_finished();
+				continue;
+			}
+
+			auto& state = m_states[m_submittedCount++];
+			state.m_callback = &file_read_many_operation::on_read_completed;
+			state.m_operation = this;
+			state.m_request = &request;
+
+			sqe->opcode = IORING_OP_READ;
+			sqe->fd = m_fileDescriptor;
+			sqe->off = request.offset;
+			sqe->addr = reinterpret_cast<std::uintptr_t>(request.buffer);
+			sqe->len = request.byteCount <= 0xFFFFFFFF ?
+				static_cast<std::uint32_t>(request.byteCount) : std::uint32_t(0xFFFFFFFF);
+			sqe->user_data = reinterpret_cast<std::uintptr_t>(
+				static_cast<detail::lnx::io_state*>(&state));
+		}
+
+		m_ioQueue.submit_pending();
+	}
+
+	// Use sequentially-consistent ordering here so that either we observe
+	// the cancellation request or the cancellation callback observes that
+	// submission has finished (or both).
+	m_submissionCompleted.store(true, std::memory_order_seq_cst);
+	if (m_cancellationRequested.load(std::memory_order_seq_cst))
+	{
+		cancel_outstanding_reads();
+	}
+
+	// Release the reference held while submitting. If every read has already
+	// completed then continue without suspending.
+	return m_remainingCount.fetch_sub(1, std::memory_order_acq_rel) != 1;
+}
+
+void cppcoro::file_read_many_operation::on_read_completed(
+	detail::lnx::io_state* ioState,
+	std::int32_t result,
+	[[maybe_unused]] std::uint32_t flags) noexcept
+{
+	auto* state = static_cast<read_state*>(ioState);
+	auto* request = state->m_request;
+
+	if (result >= 0)
+	{
+		request->bytesRead = static_cast<std::size_t>(result);
+	}
+	else
+	{
+		request->error = std::error_code{ -result, std::system_category() };
+	}
+
+	state->m_operation->on_request_finished();
+}
+
+void cppcoro::file_read_many_operation::cancel_outstanding_reads() noexcept
+{
+	// Requests that have already completed will fail to be found which is
+	// harmless. The states remain valid until await_resume() has
+	// deregistered the cancellation callback.
+	for (std::size_t i = 0; i < m_submittedCount; ++i)
+	{
+		m_ioQueue.cancel(reinterpret_cast<std::uintptr_t>(
+			static_cast<detail::lnx::io_state*>(&m_states[i])));
+	}
+}
+
+#endif
+
+#if CPPCORO_OS_WINNT || CPPCORO_OS_LINUX
+
+cppcoro::file_read_many_operation::~file_read_many_operation()
+{
+}
+
+void cppcoro::file_read_many_operation::await_resume()
+{
+	// Wait for any concurrently executing cancellation callback to return
+	// before the operation is allowed to be destroyed.
+	m_cancellationRegistration.reset();
+
+	if (m_cancellationRequested.load(std::memory_order_acquire))
+	{
+		const bool anyIncomplete = std::any_of(
+			m_requests.begin(),
+			m_requests.end(),
+			[](const file_read_request& request) { return static_cast<bool>(request.error); });
+		if (anyIncomplete)
+		{
+			throw operation_cancelled{};
+		}
+	}
+}
+
+void cppcoro::file_read_many_operation::on_request_finished() noexcept
+{
+	if (m_remainingCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		m_awaitingCoroutine.resume();
+	}
+}
+
+void cppcoro::file_read_many_operation::on_cancellation_requested() noexcept
+{
+	m_cancellationRequested.store(true, std::memory_order_seq_cst);
+	if (m_submissionCompleted.load(std::memory_order_seq_cst))
+	{
+		cancel_outstanding_reads();
+	}
+}
+
+#endif
@@ -0,0 +1,142 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/file_sync_operation.hpp>
+
+#if CPPCORO_OS_WINNT
+# ifndef WIN32_LEAN_AND_MEAN
+#  define WIN32_LEAN_AND_MEAN
+# endif
+# include <Windows.h>
+# include <winioctl.h>
+
+bool cppcoro::file_sync_operation_impl::try_start(
+	cppcoro::detail::win32_overlapped_operation_base& operation) noexcept
+{
+	// There is no overlapped version of FlushFileBuffers() nor a way to
+	// flush only the data of a file, so this always completes synchronously
+	// and flushes the metadata as well.
+	(void)m_dataOnly;
+
+	const BOOL ok = ::FlushFileBuffers(m_fileHandle);
+	operation.m_errorCode = ok ? ERROR_SUCCESS : ::GetLastError();
+	operation.m_numberOfBytesTransferred = 0;
+
+	return false;
+}
+
+bool cppcoro::file_allocate_operation_impl::try_start(
+	cppcoro::detail::win32_overlapped_operation_base& operation) noexcept
+{
+	if (m_punchHole)
+	{
+		// The range is only deallocated if the file is sparse, otherwise
+		// it is just zeroed.
+		FILE_ZERO_DATA_INFORMATION zeroDataInformation;
+		zeroDataInformation.FileOffset.QuadPart = static_cast<LONGLONG>(m_offset);
+		zeroDataInformation.BeyondFinalZero.QuadPart = static_cast<LONGLONG>(m_offset + m_length);
+
+		DWORD numberOfBytesReturned = 0;
+		const BOOL ok = ::DeviceIoControl(
+			m_fileHandle,
+			FSCTL_SET_ZERO_DATA,
+			&zeroDataInformation,
+			sizeof(zeroDataInformation),
+			nullptr,
+			0,
+			&numberOfBytesReturned,
+			operation.get_overlapped());
+		const DWORD errorCode = ok ? ERROR_SUCCESS : ::GetLastError();
+		if (errorCode != ERROR_IO_PENDING)
+		{
+			// Completed synchronously.
+			//
+			// We are assuming that the file-handle has been set to the
+			// mode where synchronous completions do not post a completion
+			// event to the I/O completion port.
+			operation.m_errorCode = errorCode;
+			operation.m_numberOfBytesTransferred = 0;
+			return false;
+		}
+
+		return true;
+	}
+
+	// Setting the allocation size can't be done asynchronously.
+	// Only ever grow the allocation as shrinking it below the end of
+	// the file would truncate the file.
+	operation.m_numberOfBytesTransferred = 0;
+
+	FILE_STANDARD_INFO standardInfo;
+	BOOL ok = ::GetFileInformationByHandleEx(
+		m_fileHandle,
+		FileStandardInfo,
+		&standardInfo,
+		sizeof(standardInfo));
+	if (ok && static_cast<std::uint64_t>(standardInfo.AllocationSize.QuadPart) < m_offset + m_length)
+	{
+		FILE_ALLOCATION_INFO allocationInfo;
+		allocationInfo.AllocationSize.QuadPart = static_cast<LONGLONG>(m_offset + m_length);
+		ok = ::SetFileInformationByHandle(
+			m_fileHandle,
+			FileAllocationInfo,
+			&allocationInfo,
+			sizeof(allocationInfo));
+	}
+
+	operation.m_errorCode = ok ? ERROR_SUCCESS : ::GetLastError();
+
+	return false;
+}
+
+#elif CPPCORO_OS_LINUX
+# include <linux/io_uring.h>
+# include <fcntl.h>
+
+bool cppcoro::file_sync_operation_impl::try_start(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	const int result = m_ioQueue.submit([&](io_uring_sqe& sqe)
+	{
+		sqe.opcode = IORING_OP_FSYNC;
+		sqe.fd = m_fileDescriptor;
+		sqe.fsync_flags = m_dataOnly ? IORING_FSYNC_DATASYNC : 0;
+		sqe.user_data = operation.get_user_data();
+	});
+	if (result < 0)
+	{
+		operation.m_result = result;
+		return false;
+	}
+
+	return true;
+}
+
+bool cppcoro::file_allocate_operation_impl::try_start(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	// Neither mode changes the size of the file.
+	const int mode = m_punchHole ?
+		FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE : FALLOC_FL_KEEP_SIZE;
+
+	const int result = m_ioQueue.submit([&](io_uring_sqe& sqe)
+	{
+		sqe.opcode = IORING_OP_FALLOCATE;
+		sqe.fd = m_fileDescriptor;
+		sqe.off = m_offset;
+		sqe.addr = m_length;
+		sqe.len = static_cast<std::uint32_t>(mode);
+		sqe.user_data = operation.get_user_data();
+	});
+	if (result < 0)
+	{
+		operation.m_result = result;
+		return false;
+	}
+
+	return true;
+}
+
+#endif
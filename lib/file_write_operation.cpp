@@ -50,4 +50,38 @@ void cppcoro::file_write_operation_impl::cancel(
 	(void)::CancelIoEx(m_fileHandle, operation.get_overlapped());
 }
 
-#endif // CPPCORO_OS_WINNT
+#elif CPPCORO_OS_LINUX
+# include <linux/io_uring.h>
+
+bool cppcoro::file_write_operation_impl::try_start(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	const std::uint32_t numberOfBytesToWrite =
+		m_byteCount <= 0xFFFFFFFF ?
+		static_cast<std::uint32_t>(m_byteCount) : std::uint32_t(0xFFFFFFFF);
+
+	const int result = m_ioQueue.submit([&](io_uring_sqe& sqe)
+	{
+		sqe.opcode = IORING_OP_WRITE;
+		sqe.fd = m_fileDescriptor;
+		sqe.off = m_fileOffset;
+		sqe.addr = reinterpret_cast<std::uintptr_t>(m_buffer);
+		sqe.len = numberOfBytesToWrite;
+		sqe.user_data = operation.get_user_data();
+	});
+	if (result < 0)
+	{
+		operation.m_result = result;
+		return false;
+	}
+
+	return true;
+}
+
+void cppcoro::file_write_operation_impl::cancel(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	m_ioQueue.cancel(operation.get_user_data());
+}
+
+#endif
@@ -0,0 +1,151 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/file_write_vectored_operation.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <new>
+
+#if CPPCORO_OS_WINNT
+# ifndef WIN32_LEAN_AND_MEAN
+#  define WIN32_LEAN_AND_MEAN
+# endif
+# include <Windows.h>
+
+bool cppcoro::file_write_vectored_operation_impl::try_start(
+	cppcoro::detail::win32_overlapped_operation_base& operation) noexcept
+{
+	SYSTEM_INFO systemInfo;
+	::GetSystemInfo(&systemInfo);
+	const std::size_t pageSize = systemInfo.dwPageSize;
+
+	// WriteFileGather() writes whole pages so each buffer must start on a
+	// page boundary and be a multiple of the page size.
+	std::size_t pageCount = 0;
+	for (const auto& b : m_buffers)
+	{
+		if (reinterpret_cast<std::uintptr_t>(b.buffer) % pageSize != 0 ||
+			b.size % pageSize != 0)
+		{
+			operation.m_errorCode = ERROR_INVALID_PARAMETER;
+			operation.m_numberOfBytesTransferred = 0;
+			return false;
+		}
+
+		pageCount += b.size / pageSize;
+	}
+
+	// Limit the write to what the byte count can describe.
+	pageCount = (std::min<std::size_t>)(pageCount, 0xFFFFFFFF / pageSize);
+
+	m_segments.reset(new (std::nothrow) std::uint64_t[pageCount + 1]);
+	if (!m_segments)
+	{
+		operation.m_errorCode = ERROR_NOT_ENOUGH_MEMORY;
+		operation.m_numberOfBytesTransferred = 0;
+		return false;
+	}
+
+	auto* segments = reinterpret_cast<FILE_SEGMENT_ELEMENT*>(m_segments.get());
+	std::size_t segmentIndex = 0;
+	for (const auto& b : m_buffers)
+	{
+		for (std::size_t offset = 0; offset < b.size && segmentIndex < pageCount; offset += pageSize)
+		{
+			segments[segmentIndex++].Buffer = PtrToPtr64(
+				static_cast<const std::byte*>(b.buffer) + offset);
+		}
+	}
+	segments[segmentIndex].Alignment = 0;
+
+	BOOL ok = ::WriteFileGather(
+		m_fileHandle,
+		segments,
+		static_cast<DWORD>(pageCount * pageSize),
+		nullptr,
+		operation.get_overlapped());
+	const DWORD errorCode = ok ? ERROR_SUCCESS : ::GetLastError();
+	if (errorCode != ERROR_IO_PENDING)
+	{
+		// Completed synchronously.
+		//
+		// We are assuming that the file-handle has been set to the
+		// mode where synchronous completions do not post a completion
+		// event to the I/O completion port and thus can return without
+		// suspending here.
+
+		operation.m_errorCode = errorCode;
+		operation.m_numberOfBytesTransferred =
+			errorCode == ERROR_SUCCESS ? static_cast<DWORD>(pageCount * pageSize) : 0;
+
+		return false;
+	}
+
+	return true;
+}
+
+void cppcoro::file_write_vectored_operation_impl::cancel(
+	cppcoro::detail::win32_overlapped_operation_base& operation) noexcept
+{
+	(void)::CancelIoEx(m_fileHandle, operation.get_overlapped());
+}
+
+#elif CPPCORO_OS_LINUX
+# include <cerrno>
+
+# include <linux/io_uring.h>
+# include <sys/uio.h>
+
+bool cppcoro::file_write_vectored_operation_impl::try_start(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	// pwritev() writes from at most UIO_MAXIOV buffers per call.
+	const std::size_t bufferCount = std::min<std::size_t>(m_buffers.size(), UIO_MAXIOV);
+
+	cppcoro::detail::lnx::iovec_t* iovecs = m_inlineIovecs;
+	if (bufferCount > std::size(m_inlineIovecs))
+	{
+		m_iovecs.reset(new (std::nothrow) cppcoro::detail::lnx::iovec_t[bufferCount]);
+		if (!m_iovecs)
+		{
+			operation.m_result = -ENOMEM;
+			return false;
+		}
+
+		iovecs = m_iovecs.get();
+	}
+
+	for (std::size_t i = 0; i < bufferCount; ++i)
+	{
+		iovecs[i].iov_base = const_cast<void*>(m_buffers[i].buffer);
+		iovecs[i].iov_len = m_buffers[i].size;
+	}
+
+	const int result = m_ioQueue.submit([&](io_uring_sqe& sqe)
+	{
+		sqe.opcode = IORING_OP_WRITEV;
+		sqe.fd = m_fileDescriptor;
+		sqe.off = m_fileOffset;
+		sqe.addr = reinterpret_cast<std::uintptr_t>(iovecs);
+		sqe.len = static_cast<std::uint32_t>(bufferCount);
+		sqe.user_data = operation.get_user_data();
+	});
+	if (result < 0)
+	{
+		operation.m_result = result;
+		return false;
+	}
+
+	return true;
+}
+
+void cppcoro::file_write_vectored_operation_impl::cancel(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	m_ioQueue.cancel(operation.get_user_data());
+}
+
+#endif
@@ -9,6 +9,9 @@
 #include <system_error>
 #include <cassert>
 #include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <memory>
 #include <thread>
 
 #if CPPCORO_OS_WINNT
@@ -22,6 +25,11 @@
 # include <WS2tcpip.h>
 # include <MSWSock.h>
 # include <Windows.h>
+#elif CPPCORO_OS_LINUX
+# include <poll.h>
+# include <sys/eventfd.h>
+# include <sys/timerfd.h>
+# include <unistd.h>
 #endif
 
 namespace
@@ -77,9 +85,136 @@ namespace
 
 		return cppcoro::detail::win32::safe_handle{ handle };
 	}
+#elif CPPCORO_OS_LINUX
+	// Number of submission queue entries. Each submission is passed to the
+	// kernel straight away, so the queue only fills up if the kernel stops
+	// consuming entries (eg. while the completion queue has overflowed), in
+	// which case submissions fail with EBUSY rather than waiting for space.
+	constexpr std::uint32_t io_uring_entries = 1024;
+
+	cppcoro::detail::lnx::safe_fd create_event_fd()
+	{
+		cppcoro::detail::lnx::safe_fd fd{ ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK) };
+		if (fd == -1)
+		{
+			throw std::system_error
+			{
+				errno,
+				std::system_category(),
+				"Error creating wake-up event: eventfd"
+			};
+		}
+
+		return fd;
+	}
+
+	cppcoro::detail::lnx::safe_fd create_timer_fd()
+	{
+		cppcoro::detail::lnx::safe_fd fd{
+			::timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK) };
+		if (fd == -1)
+		{
+			throw std::system_error
+			{
+				errno,
+				std::system_category(),
+				"Error creating timer: timerfd_create"
+			};
+		}
+
+		return fd;
+	}
 #endif
+
+	/// Hint to the CPU that the thread is spinning in a busy-wait loop.
+	void cpu_relax() noexcept
+	{
+#if CPPCORO_OS_WINNT
+		::YieldProcessor();
+#elif defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
+#elif defined(__aarch64__)
+		asm volatile("yield");
+#endif
+	}
 }
 
+/// \brief
+/// Counters recorded by an io_service while instrumentation is enabled.
+///
+/// All counters are updated with relaxed atomic increments so that any
+/// number of event-loop threads may record to them and any thread may
+/// take a snapshot without locking.
+class cppcoro::detail::io_service_instrumentation
+{
+public:
+
+	using clock = std::chrono::steady_clock;
+
+	io_service_instrumentation() noexcept
+	{
+		for (auto* h : { &m_scheduleLatency, &m_eventProcessingTime, &m_eventsPerWakeUp })
+		{
+			for (auto& bucket : *h)
+			{
+				bucket.store(0, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	void record_schedule_latency(clock::duration latency) noexcept
+	{
+		record(m_scheduleLatency, to_nanoseconds(latency));
+	}
+
+	void record_event_processing_time(clock::duration duration) noexcept
+	{
+		record(m_eventProcessingTime, to_nanoseconds(duration));
+	}
+
+	void record_events_per_wake_up(std::uint64_t eventCount) noexcept
+	{
+		record(m_eventsPerWakeUp, eventCount);
+	}
+
+	void snapshot(io_service_stats& stats) const noexcept
+	{
+		copy(m_scheduleLatency, stats.schedule_latency_ns);
+		copy(m_eventProcessingTime, stats.event_processing_time_ns);
+		copy(m_eventsPerWakeUp, stats.events_per_wake_up);
+	}
+
+private:
+
+	using histogram = std::array<
+		std::atomic<std::uint64_t>,
+		std::tuple_size_v<io_service_stats::histogram>>;
+
+	static std::uint64_t to_nanoseconds(clock::duration duration) noexcept
+	{
+		const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+		return ns > 0 ? static_cast<std::uint64_t>(ns) : 0;
+	}
+
+	static void record(histogram& h, std::uint64_t value) noexcept
+	{
+		h[io_service_stats::bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+	}
+
+	static void copy(const histogram& from, io_service_stats::histogram& to) noexcept
+	{
+		for (std::size_t i = 0; i < from.size(); ++i)
+		{
+			to[i] = from[i].load(std::memory_order_relaxed);
+		}
+	}
+
+	histogram m_scheduleLatency;
+	histogram m_eventProcessingTime;
+	histogram m_eventsPerWakeUp;
+
+};
+
 /// \brief
 /// A queue of pending timers that supports efficiently determining
 /// and dequeueing the earliest-due timers in the queue.
@@ -312,15 +447,111 @@ public:
 #if CPPCORO_OS_WINNT
 	detail::win32::safe_handle m_wakeUpEvent;
 	detail::win32::safe_handle m_waitableTimerEvent;
+#elif CPPCORO_OS_LINUX
+	detail::lnx::safe_fd m_wakeUpEvent;
+	detail::lnx::safe_fd m_waitableTimerEvent;
 #endif
 
 	std::atomic<io_service::timed_schedule_operation*> m_newlyQueuedTimers;
+	std::atomic<std::uint32_t> m_pendingTimerCount;
 	std::atomic<bool> m_timerCancellationRequested;
 	std::atomic<bool> m_shutDownRequested;
 
 	std::thread m_thread;
 };
 
+/// \brief
+/// The state of an event loop running on a particular thread.
+///
+/// Coroutines that are scheduled onto the io_service from one of its own
+/// event-loop threads are queued to that thread's local run queue rather
+/// than to the shared queue. This avoids posting an event to the kernel
+/// for the common pattern of an I/O thread yielding via
+/// 'co_await ioService.schedule()'.
+///
+/// Any operations left in the local run queue when the thread exits the
+/// event loop are moved to the shared queue so that they are not lost.
+class cppcoro::io_service::thread_state
+{
+public:
+
+	explicit thread_state(io_service& service) noexcept
+		: m_service(service)
+		, m_head(nullptr)
+		, m_tail(nullptr)
+		, m_budget(local_run_queue_budget)
+		, m_eventsSinceWakeUp(0)
+		, m_previous(current_thread_state())
+	{
+		current_thread_state() = this;
+	}
+
+	~thread_state()
+	{
+		current_thread_state() = m_previous;
+
+		auto* operation = m_head;
+		while (operation != nullptr)
+		{
+			auto* next = operation->m_next;
+			m_service.schedule_impl(operation);
+			operation = next;
+		}
+	}
+
+	thread_state(const thread_state& other) = delete;
+	thread_state& operator=(const thread_state& other) = delete;
+
+	/// Run \a func to process one event, timing it if instrumentation is enabled.
+	template<typename FUNC>
+	void process_event(
+		detail::io_service_instrumentation* instrumentation,
+		FUNC&& func)
+	{
+		++m_eventsSinceWakeUp;
+
+		if (instrumentation == nullptr)
+		{
+			func();
+			return;
+		}
+
+		const auto startTime = std::chrono::steady_clock::now();
+		func();
+		instrumentation->record_event_processing_time(
+			std::chrono::steady_clock::now() - startTime);
+	}
+
+	/// Call before blocking to wait for events.
+	void about_to_wait() noexcept
+	{
+		if (auto* instrumentation = m_service.enabled_instrumentation();
+			instrumentation != nullptr)
+		{
+			instrumentation->record_events_per_wake_up(m_eventsSinceWakeUp);
+		}
+
+		m_eventsSinceWakeUp = 0;
+	}
+
+	// The maximum number of operations to resume from the local run queue
+	// before checking the shared queue and for I/O completions, so that
+	// coroutines that repeatedly reschedule themselves cannot starve them.
+	static constexpr std::uint32_t local_run_queue_budget = 64;
+
+	io_service& m_service;
+
+	// FIFO list of operations scheduled from this thread.
+	io_service::schedule_operation* m_head;
+	io_service::schedule_operation* m_tail;
+
+	std::uint32_t m_budget;
+
+	std::uint64_t m_eventsSinceWakeUp;
+
+	thread_state* m_previous;
+};
+
 
 
 cppcoro::io_service::io_service()
@@ -331,22 +562,35 @@ cppcoro::io_service::io_service()
 cppcoro::io_service::io_service(std::uint32_t concurrencyHint)
 	: m_threadState(0)
 	, m_workCount(0)
+	, m_busyPollMicroseconds(0)
 #if CPPCORO_OS_WINNT
 	, m_iocpHandle(create_io_completion_port(concurrencyHint))
 	, m_winsockInitialised(false)
 	, m_winsockInitialisationMutex()
+#elif CPPCORO_OS_LINUX
+	, m_ioQueue(io_uring_entries)
 #endif
 	, m_scheduleOperations(nullptr)
+#if CPPCORO_OS_LINUX
+	, m_readyOperations(nullptr)
+#endif
 	, m_timerState(nullptr)
+	, m_instrumentationEnabled(false)
+	, m_instrumentation(nullptr)
 {
+	(void)concurrencyHint;
 }
 
 cppcoro::io_service::~io_service()
 {
 	assert(m_scheduleOperations.load(std::memory_order_relaxed) == nullptr);
+#if CPPCORO_OS_LINUX
+	assert(m_readyOperations == nullptr);
+#endif
 	assert(m_threadState.load(std::memory_order_relaxed) < active_thread_count_increment);
 
 	delete m_timerState.load(std::memory_order_relaxed);
+	delete m_instrumentation.load(std::memory_order_relaxed);
 
 #if CPPCORO_OS_WINNT
 	if (m_winsockInitialised.load(std::memory_order_relaxed))
@@ -369,6 +613,7 @@ std::uint64_t cppcoro::io_service::process_events()
 	if (try_enter_event_loop())
 	{
 		auto exitLoop = on_scope_exit([&] { exit_event_loop(); });
+		thread_state threadState{ *this };
 
 		constexpr bool waitForEvent = true;
 		while (try_process_one_event(waitForEvent))
@@ -386,6 +631,7 @@ std::uint64_t cppcoro::io_service::process_pending_events()
 	if (try_enter_event_loop())
 	{
 		auto exitLoop = on_scope_exit([&] { exit_event_loop(); });
+		thread_state threadState{ *this };
 
 		constexpr bool waitForEvent = false;
 		while (try_process_one_event(waitForEvent))
@@ -403,6 +649,7 @@ std::uint64_t cppcoro::io_service::process_one_event()
 	if (try_enter_event_loop())
 	{
 		auto exitLoop = on_scope_exit([&] { exit_event_loop(); });
+		thread_state threadState{ *this };
 
 		constexpr bool waitForEvent = true;
 		if (try_process_one_event(waitForEvent))
@@ -420,6 +667,7 @@ std::uint64_t cppcoro::io_service::process_one_pending_event()
 	if (try_enter_event_loop())
 	{
 		auto exitLoop = on_scope_exit([&] { exit_event_loop(); });
+		thread_state threadState{ *this };
 
 		constexpr bool waitForEvent = false;
 		if (try_process_one_event(waitForEvent))
@@ -458,6 +706,90 @@ bool cppcoro::io_service::is_stop_requested() const noexcept
 	return (m_threadState.load(std::memory_order_acquire) & stop_requested_flag) != 0;
 }
 
+void cppcoro::io_service::set_busy_poll_duration(std::chrono::microseconds duration) noexcept
+{
+	m_busyPollMicroseconds.store(
+		duration.count() > 0 ? static_cast<std::int64_t>(duration.count()) : 0,
+		std::memory_order_relaxed);
+}
+
+std::chrono::microseconds cppcoro::io_service::busy_poll_duration() const noexcept
+{
+	return std::chrono::microseconds{ m_busyPollMicroseconds.load(std::memory_order_relaxed) };
+}
+
+void cppcoro::io_service::set_instrumentation_enabled(bool enabled)
+{
+	if (enabled && m_instrumentation.load(std::memory_order_acquire) == nullptr)
+	{
+		auto newInstrumentation = std::make_unique<detail::io_service_instrumentation>();
+		detail::io_service_instrumentation* expected = nullptr;
+		if (m_instrumentation.compare_exchange_strong(
+			expected,
+			newInstrumentation.get(),
+			std::memory_order_release,
+			std::memory_order_acquire))
+		{
+			newInstrumentation.release();
+		}
+	}
+
+	m_instrumentationEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool cppcoro::io_service::is_instrumentation_enabled() const noexcept
+{
+	return m_instrumentationEnabled.load(std::memory_order_relaxed);
+}
+
+cppcoro::io_service_stats cppcoro::io_service::instrumentation_snapshot() const noexcept
+{
+	io_service_stats stats{};
+
+	if (auto* instrumentation = m_instrumentation.load(std::memory_order_acquire);
+		instrumentation != nullptr)
+	{
+		instrumentation->snapshot(stats);
+	}
+
+	if (auto* timerState = m_timerState.load(std::memory_order_acquire);
+		timerState != nullptr)
+	{
+		stats.pending_timer_count =
+			timerState->m_pendingTimerCount.load(std::memory_order_relaxed);
+	}
+
+	stats.work_count = m_workCount.load(std::memory_order_relaxed);
+
+	return stats;
+}
+
+cppcoro::detail::io_service_instrumentation*
+cppcoro::io_service::enabled_instrumentation() const noexcept
+{
+	if (!m_instrumentationEnabled.load(std::memory_order_relaxed))
+	{
+		return nullptr;
+	}
+
+	return m_instrumentation.load(std::memory_order_acquire);
+}
+
+void cppcoro::io_service::resume_scheduled_operation(schedule_operation* operation)
+{
+	auto* instrumentation = enabled_instrumentation();
+	if (instrumentation != nullptr &&
+		operation->m_scheduleTime != std::chrono::steady_clock::time_point{})
+	{
+		instrumentation->record_schedule_latency(
+			std::chrono::steady_clock::now() - operation->m_scheduleTime);
+	}
+
+	current_thread_state()->process_event(
+		instrumentation,
+		[operation] { operation->m_awaiter.resume(); });
+}
+
 void cppcoro::io_service::notify_work_started() noexcept
 {
 	m_workCount.fetch_add(1, std::memory_order_relaxed);
@@ -471,13 +803,13 @@ void cppcoro::io_service::notify_work_finished() noexcept
 	}
 }
 
+#if CPPCORO_OS_WINNT
+
 cppcoro::detail::win32::handle_t cppcoro::io_service::native_iocp_handle() noexcept
 {
 	return m_iocpHandle.handle();
 }
 
-#if CPPCORO_OS_WINNT
-
 void cppcoro::io_service::ensure_winsock_initialised()
 {
 	if (!m_winsockInitialised.load(std::memory_order_acquire))
@@ -502,15 +834,44 @@ void cppcoro::io_service::ensure_winsock_initialised()
 	}
 }
 
-#endif // CPPCORO_OS_WINNT
+#elif CPPCORO_OS_LINUX
+
+cppcoro::detail::lnx::io_uring_queue& cppcoro::io_service::native_io_uring_queue() noexcept
+{
+	return m_ioQueue;
+}
+
+#endif
 
 void cppcoro::io_service::schedule_impl(schedule_operation* operation) noexcept
 {
+	operation->m_scheduleTime = is_instrumentation_enabled() ?
+		std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+
+	// Scheduling from one of our own event-loop threads only needs to
+	// queue the operation to that thread, which will get to it before
+	// it next waits for events.
+	if (auto* threadState = current_thread_state();
+		threadState != nullptr && &threadState->m_service == this)
+	{
+		operation->m_next = nullptr;
+		if (threadState->m_tail == nullptr)
+		{
+			threadState->m_head = operation;
+		}
+		else
+		{
+			threadState->m_tail->m_next = operation;
+		}
+		threadState->m_tail = operation;
+		return;
+	}
+
 #if CPPCORO_OS_WINNT
 	const BOOL ok = ::PostQueuedCompletionStatus(
 		m_iocpHandle.handle(),
 		0,
-		reinterpret_cast<ULONG_PTR>(operation->m_awaiter.address()),
+		reinterpret_cast<ULONG_PTR>(operation),
 		nullptr);
 	if (!ok)
 	{
@@ -531,6 +892,25 @@ void cppcoro::io_service::schedule_impl(schedule_operation* operation) noexcept
 			std::memory_order_release,
 			std::memory_order_acquire));
 	}
+#elif CPPCORO_OS_LINUX
+	// Posting an event to the io_uring is a system call, so rather than
+	// posting one per operation we only post a wake-up when the list goes
+	// from empty to non-empty. The thread that receives it takes the whole
+	// list and any operations queued after that post another wake-up.
+	auto* head = m_scheduleOperations.load(std::memory_order_acquire);
+	do
+	{
+		operation->m_next = head;
+	} while (!m_scheduleOperations.compare_exchange_weak(
+		head,
+		operation,
+		std::memory_order_release,
+		std::memory_order_acquire));
+
+	if (head == nullptr)
+	{
+		post_wake_up_event();
+	}
 #endif
 }
 
@@ -544,7 +924,7 @@ void cppcoro::io_service::try_reschedule_overflow_operations() noexcept
 		BOOL ok = ::PostQueuedCompletionStatus(
 			m_iocpHandle.handle(),
 			0,
-			reinterpret_cast<ULONG_PTR>(operation->m_awaiter.address()),
+			reinterpret_cast<ULONG_PTR>(operation),
 			nullptr);
 		if (!ok)
 		{
@@ -574,6 +954,74 @@ void cppcoro::io_service::try_reschedule_overflow_operations() noexcept
 #endif
 }
 
+cppcoro::io_service::thread_state*& cppcoro::io_service::current_thread_state() noexcept
+{
+	thread_local thread_state* threadState = nullptr;
+	return threadState;
+}
+
+cppcoro::io_service::schedule_operation*
+cppcoro::io_service::try_dequeue_local_schedule_operation() noexcept
+{
+	auto* threadState = current_thread_state();
+	assert(threadState != nullptr && &threadState->m_service == this);
+
+	auto* operation = threadState->m_head;
+	if (operation == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (threadState->m_budget == 0)
+	{
+		// Give the shared queue and I/O completions a turn. The budget
+		// is replenished once they have been checked.
+		return nullptr;
+	}
+
+	--threadState->m_budget;
+
+	threadState->m_head = operation->m_next;
+	if (threadState->m_head == nullptr)
+	{
+		threadState->m_tail = nullptr;
+	}
+
+	return operation;
+}
+
+#if CPPCORO_OS_LINUX
+
+cppcoro::io_service::schedule_operation*
+cppcoro::io_service::try_dequeue_schedule_operation() noexcept
+{
+	std::lock_guard lock{ m_readyOperationsMutex };
+
+	if (m_readyOperations == nullptr)
+	{
+		// The list is in LIFO order. Reverse it so that operations are
+		// resumed in the order they were scheduled.
+		auto* operation = m_scheduleOperations.exchange(nullptr, std::memory_order_acquire);
+		while (operation != nullptr)
+		{
+			auto* next = operation->m_next;
+			operation->m_next = m_readyOperations;
+			m_readyOperations = operation;
+			operation = next;
+		}
+	}
+
+	auto* operation = m_readyOperations;
+	if (operation != nullptr)
+	{
+		m_readyOperations = operation->m_next;
+	}
+
+	return operation;
+}
+
+#endif
+
 bool cppcoro::io_service::try_enter_event_loop() noexcept
 {
 	auto currentState = m_threadState.load(std::memory_order_relaxed);
@@ -604,14 +1052,38 @@ bool cppcoro::io_service::try_process_one_event(bool waitForEvent)
 		return false;
 	}
 
-	const DWORD timeout = waitForEvent ? INFINITE : 0;
+	// When busy-polling, poll the completion port without blocking until
+	// the busy-poll deadline passes and only then block.
+	const auto busyPollDuration = waitForEvent ?
+		busy_poll_duration() : std::chrono::microseconds{ 0 };
+	std::chrono::steady_clock::time_point busyPollDeadline;
+	DWORD timeout = waitForEvent && busyPollDuration.count() == 0 ? INFINITE : 0;
+
+	auto* threadState = current_thread_state();
 
 	while (true)
 	{
+		// Coroutines scheduled from this thread.
+		if (auto* operation = try_dequeue_local_schedule_operation(); operation != nullptr)
+		{
+			resume_scheduled_operation(operation);
+			return true;
+		}
+
+		threadState->m_budget = thread_state::local_run_queue_budget;
+
+		// Only poll the completion port if there is still local work to do.
+		const bool hasLocalWork = threadState->m_head != nullptr;
+
 		// Check for any schedule_operation objects that were unable to be
 		// queued to the I/O completion port and try to requeue them now.
 		try_reschedule_overflow_operations();
 
+		if (!hasLocalWork && timeout == INFINITE)
+		{
+			threadState->about_to_wait();
+		}
+
 		DWORD numberOfBytesTransferred = 0;
 		ULONG_PTR completionKey = 0;
 		LPOVERLAPPED overlapped = nullptr;
@@ -620,7 +1092,7 @@ bool cppcoro::io_service::try_process_one_event(bool waitForEvent)
 			&numberOfBytesTransferred,
 			&completionKey,
 			&overlapped,
-			timeout);
+			hasLocalWork ? 0 : timeout);
 		if (overlapped != nullptr)
 		{
 			DWORD errorCode = ok ? ERROR_SUCCESS : ::GetLastError();
@@ -628,11 +1100,14 @@ bool cppcoro::io_service::try_process_one_event(bool waitForEvent)
 			auto* state = static_cast<detail::win32::io_state*>(
 				reinterpret_cast<detail::win32::overlapped*>(overlapped));
 
-			state->m_callback(
-				state,
-				errorCode,
-				numberOfBytesTransferred,
-				completionKey);
+			threadState->process_event(enabled_instrumentation(), [&]
+			{
+				state->m_callback(
+					state,
+					errorCode,
+					numberOfBytesTransferred,
+					completionKey);
+			});
 
 			return true;
 		}
@@ -642,8 +1117,8 @@ bool cppcoro::io_service::try_process_one_event(bool waitForEvent)
 			{
 				// This was a coroutine scheduled via a call to
 				// io_service::schedule().
-				cppcoro::coroutine_handle<>::from_address(
-					reinterpret_cast<void*>(completionKey)).resume();
+				resume_scheduled_operation(
+					reinterpret_cast<schedule_operation*>(completionKey));
 				return true;
 			}
 
@@ -662,7 +1137,32 @@ bool cppcoro::io_service::try_process_one_event(bool waitForEvent)
 			const DWORD errorCode = ::GetLastError();
 			if (errorCode == WAIT_TIMEOUT)
 			{
-				return false;
+				if (hasLocalWork)
+				{
+					continue;
+				}
+
+				if (!waitForEvent)
+				{
+					return false;
+				}
+
+				const auto now = std::chrono::steady_clock::now();
+				if (busyPollDeadline == std::chrono::steady_clock::time_point{})
+				{
+					busyPollDeadline = now + busyPollDuration;
+				}
+
+				if (now >= busyPollDeadline)
+				{
+					timeout = INFINITE;
+				}
+				else
+				{
+					cpu_relax();
+				}
+
+				continue;
 			}
 
 			throw std::system_error
@@ -673,6 +1173,87 @@ bool cppcoro::io_service::try_process_one_event(bool waitForEvent)
 			};
 		}
 	}
+#elif CPPCORO_OS_LINUX
+	auto* threadState = current_thread_state();
+	std::chrono::steady_clock::time_point busyPollDeadline;
+
+	while (true)
+	{
+		if (is_stop_requested())
+		{
+			return false;
+		}
+
+		// Coroutines scheduled from this thread.
+		if (auto* operation = try_dequeue_local_schedule_operation(); operation != nullptr)
+		{
+			resume_scheduled_operation(operation);
+			return true;
+		}
+
+		threadState->m_budget = thread_state::local_run_queue_budget;
+
+		// Coroutines scheduled from other threads.
+		if (auto* operation = try_dequeue_schedule_operation(); operation != nullptr)
+		{
+			resume_scheduled_operation(operation);
+			return true;
+		}
+
+		detail::lnx::io_uring_queue::completion completion;
+		if (m_ioQueue.try_get_completion(completion))
+		{
+			if (completion.user_data == detail::lnx::io_uring_queue::wake_up_user_data ||
+				completion.user_data == detail::lnx::io_uring_queue::ignored_user_data)
+			{
+				// Wake-up requests only need to bring us back around the loop
+				// to check for scheduled operations and whether stop is still
+				// required. There may be spurious such events remaining in the
+				// queue from a previous call to stop() that has since been reset().
+				continue;
+			}
+
+			auto* state = reinterpret_cast<detail::lnx::io_state*>(
+				static_cast<std::uintptr_t>(completion.user_data));
+
+			threadState->process_event(enabled_instrumentation(), [&]
+			{
+				state->m_callback(state, completion.result, completion.flags);
+			});
+
+			return true;
+		}
+
+		if (threadState->m_head != nullptr)
+		{
+			continue;
+		}
+
+		if (!waitForEvent)
+		{
+			return false;
+		}
+
+		// Spin checking the completion queue, which the kernel writes to
+		// directly, before paying for a system call to block on it.
+		if (const auto busyPollDuration = busy_poll_duration(); busyPollDuration.count() > 0)
+		{
+			const auto now = std::chrono::steady_clock::now();
+			if (busyPollDeadline == std::chrono::steady_clock::time_point{})
+			{
+				busyPollDeadline = now + busyPollDuration;
+			}
+
+			if (now < busyPollDeadline)
+			{
+				cpu_relax();
+				continue;
+			}
+		}
+
+		threadState->about_to_wait();
+		m_ioQueue.wait_for_completion();
+	}
 #endif
 }
 
@@ -685,6 +1266,8 @@ void cppcoro::io_service::post_wake_up_event() noexcept
 	// and the system is out of memory. In this case threads should find other events
 	// in the queue next time they check anyway and thus wake-up.
 	(void)::PostQueuedCompletionStatus(m_iocpHandle.handle(), 0, 0, nullptr);
+#elif CPPCORO_OS_LINUX
+	(void)m_ioQueue.post(detail::lnx::io_uring_queue::wake_up_user_data);
 #endif
 }
 
@@ -715,8 +1298,12 @@ cppcoro::io_service::timer_thread_state::timer_thread_state()
 #if CPPCORO_OS_WINNT
 	: m_wakeUpEvent(create_auto_reset_event())
 	, m_waitableTimerEvent(create_waitable_timer_event())
+#elif CPPCORO_OS_LINUX
+	: m_wakeUpEvent(create_event_fd())
+	, m_waitableTimerEvent(create_timer_fd())
 #endif
 	, m_newlyQueuedTimers(nullptr)
+	, m_pendingTimerCount(0)
 	, m_timerCancellationRequested(false)
 	, m_shutDownRequested(false)
 	, m_thread([this] { this->run(); })
@@ -887,6 +1474,8 @@ void cppcoro::io_service::timer_thread_state::run() noexcept
 			auto* timer = timersReadyToResume;
 			auto* nextTimer = timer->m_next;
 
+			m_pendingTimerCount.fetch_sub(1, std::memory_order_relaxed);
+
 			// Use 'release' memory order to ensure that any prior writes to
 			// m_next "happen before" any potential uses of that same memory
 			// back on the thread that is executing timed_schedule_operation::await_suspend()
@@ -897,6 +1486,153 @@ void cppcoro::io_service::timer_thread_state::run() noexcept
 					&timer->m_scheduleOperation);
 			}
 
+			timersReadyToResume = nextTimer;
+		}
+	}
+#elif CPPCORO_OS_LINUX
+	using clock = std::chrono::high_resolution_clock;
+	using time_point = clock::time_point;
+
+	timer_queue timerQueue;
+
+	pollfd waitFds[2] =
+	{
+		{ m_wakeUpEvent.fd(), POLLIN, 0 },
+		{ m_waitableTimerEvent.fd(), POLLIN, 0 }
+	};
+
+	time_point lastSetWaitEventTime = time_point::max();
+
+	timed_schedule_operation* timersReadyToResume = nullptr;
+
+	int timeout = -1;
+	while (!m_shutDownRequested.load(std::memory_order_relaxed))
+	{
+		const int waitResult = ::poll(waitFds, 2, timeout);
+		if (waitResult < 0 || (waitFds[0].revents & POLLIN) != 0)
+		{
+			// Wake-up event
+			//
+			// We are only woken up for:
+			// - handling timer cancellation
+			// - handling newly queued timers
+			// - shutdown
+			//
+			// We also handle failure of poll() here so that we remain responsive
+			// to new timers and cancellation even if the wait fails for some reason.
+
+			// Reset the event. This can't block as the eventfd is non-blocking.
+			std::uint64_t wakeUpCount;
+			(void)::read(m_wakeUpEvent.fd(), &wakeUpCount, sizeof(wakeUpCount));
+
+			// Handle cancelled timers
+			if (m_timerCancellationRequested.exchange(false, std::memory_order_acquire))
+			{
+				timerQueue.remove_cancelled_timers(timersReadyToResume);
+			}
+
+			// Handle newly queued timers
+			auto* newTimers = m_newlyQueuedTimers.exchange(nullptr, std::memory_order_acquire);
+			while (newTimers != nullptr)
+			{
+				auto* timer = newTimers;
+				newTimers = timer->m_next;
+
+				if (timer->m_cancellationToken.is_cancellation_requested())
+				{
+					timer->m_next = timersReadyToResume;
+					timersReadyToResume = timer;
+				}
+				else
+				{
+					timerQueue.enqueue_timer(timer);
+				}
+			}
+		}
+
+		if (waitResult > 0 && (waitFds[1].revents & POLLIN) != 0)
+		{
+			std::uint64_t expirationCount;
+			(void)::read(m_waitableTimerEvent.fd(), &expirationCount, sizeof(expirationCount));
+			lastSetWaitEventTime = time_point::max();
+		}
+
+		if (!timerQueue.is_empty())
+		{
+			time_point currentTime = clock::now();
+
+			timerQueue.dequeue_due_timers(currentTime, timersReadyToResume);
+
+			if (!timerQueue.is_empty())
+			{
+				auto earliestDueTime = timerQueue.earliest_due_time();
+				assert(earliestDueTime > currentTime);
+
+				// Set the timer before trying to schedule any of the ready-to-run
+				// timers to avoid the concept of 'current time' on which we calculate the
+				// amount of time to wait until the next timer is ready.
+				if (earliestDueTime != lastSetWaitEventTime)
+				{
+					auto timeUntilNextDueTime = earliestDueTime - currentTime;
+
+					const auto nanoseconds = std::max<std::int64_t>(
+						std::chrono::duration_cast<std::chrono::nanoseconds>(
+							timeUntilNextDueTime).count(),
+						1);
+
+					// A zero interval indicates no repeat on the timer and
+					// no flags indicates a relative due time.
+					itimerspec dueTime{};
+					dueTime.it_value.tv_sec = static_cast<time_t>(nanoseconds / 1'000'000'000);
+					dueTime.it_value.tv_nsec = static_cast<long>(nanoseconds % 1'000'000'000);
+
+					const int result = ::timerfd_settime(
+						m_waitableTimerEvent.fd(), 0, &dueTime, nullptr);
+					if (result == 0)
+					{
+						lastSetWaitEventTime = earliestDueTime;
+						timeout = -1;
+					}
+					else
+					{
+						// Fall back to using the timeout parameter of poll(),
+						// waking up at least once every second to retry setting
+						// the timer.
+						using namespace std::literals::chrono_literals;
+						if (timeUntilNextDueTime > 1s)
+						{
+							timeout = 1000;
+						}
+						else if (timeUntilNextDueTime > 1ms)
+						{
+							timeout = static_cast<int>(
+								std::chrono::duration_cast<std::chrono::milliseconds>(
+									timeUntilNextDueTime).count());
+						}
+						else
+						{
+							timeout = 1;
+						}
+					}
+				}
+			}
+		}
+
+		// Now schedule any ready-to-run timers.
+		while (timersReadyToResume != nullptr)
+		{
+			auto* timer = timersReadyToResume;
+			auto* nextTimer = timer->m_next;
+
+			m_pendingTimerCount.fetch_sub(1, std::memory_order_relaxed);
+
+			// See the comment in the Windows implementation above.
+			if (timer->m_refCount.fetch_sub(1, std::memory_order_release) == 1)
+			{
+				timer->m_scheduleOperation.m_service.schedule_impl(
+					&timer->m_scheduleOperation);
+			}
+
 			timersReadyToResume = nextTimer;
 		}
 	}
@@ -907,6 +1643,9 @@ void cppcoro::io_service::timer_thread_state::wake_up_timer_thread() noexcept
 {
 #if CPPCORO_OS_WINNT
 	(void)::SetEvent(m_wakeUpEvent.handle());
+#elif CPPCORO_OS_LINUX
+	const std::uint64_t increment = 1;
+	(void)::write(m_wakeUpEvent.fd(), &increment, sizeof(increment));
 #endif
 }
 
@@ -986,6 +1725,8 @@ void cppcoro::io_service::timed_schedule_operation::await_suspend(
 	// that a read-with 'acquire' semantics in the timer thread
 	// of the latest value will synchronise with all prior writes
 	// to that value that used 'release' semantics.
+	timerState->m_pendingTimerCount.fetch_add(1, std::memory_order_relaxed);
+
 	auto* prev = timerState->m_newlyQueuedTimers.load(std::memory_order_acquire);
 	do
 	{
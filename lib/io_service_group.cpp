@@ -0,0 +1,190 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/io_service_group.hpp>
+
+#include <exception>
+
+#if CPPCORO_OS_WINNT
+# ifndef WIN32_LEAN_AND_MEAN
+#  define WIN32_LEAN_AND_MEAN
+# endif
+# include <Windows.h>
+#elif CPPCORO_OS_LINUX
+# include <pthread.h>
+# include <sched.h>
+#endif
+
+namespace
+{
+	namespace local
+	{
+		/// Get the CPUs that the process may run on.
+		std::vector<int> available_cpus()
+		{
+			std::vector<int> cpus;
+
+#if CPPCORO_OS_WINNT
+			DWORD_PTR processMask = 0;
+			DWORD_PTR systemMask = 0;
+			if (::GetProcessAffinityMask(::GetCurrentProcess(), &processMask, &systemMask))
+			{
+				for (int cpu = 0; cpu < int(sizeof(DWORD_PTR) * 8); ++cpu)
+				{
+					if ((processMask & (DWORD_PTR(1) << cpu)) != 0)
+					{
+						cpus.push_back(cpu);
+					}
+				}
+			}
+#elif CPPCORO_OS_LINUX
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			if (::sched_getaffinity(0, sizeof(set), &set) == 0)
+			{
+				for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+				{
+					if (CPU_ISSET(cpu, &set))
+					{
+						cpus.push_back(cpu);
+					}
+				}
+			}
+#endif
+
+			return cpus;
+		}
+
+		/// Pin a thread to a single CPU.
+		///
+		/// \return
+		/// true if the thread was pinned.
+		bool pin_thread(std::thread& thread, int cpu) noexcept
+		{
+#if CPPCORO_OS_WINNT
+			return ::SetThreadAffinityMask(
+				thread.native_handle(), DWORD_PTR(1) << cpu) != 0;
+#elif CPPCORO_OS_LINUX
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			CPU_SET(cpu, &set);
+			return ::pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#else
+			(void)thread;
+			(void)cpu;
+			return false;
+#endif
+		}
+	}
+}
+
+cppcoro::io_service_group::io_service_group()
+	: io_service_group(static_cast<std::uint32_t>(local::available_cpus().size()))
+{
+}
+
+cppcoro::io_service_group::io_service_group(std::uint32_t shardCount)
+	: m_shardCount(shardCount > 0 ? shardCount : 1)
+	, m_shards(std::make_unique<shard[]>(m_shardCount))
+{
+	const std::vector<int> cpus = local::available_cpus();
+
+	try
+	{
+		for (std::uint32_t i = 0; i < m_shardCount; ++i)
+		{
+			auto& s = m_shards[i];
+			s.m_thread = std::thread([&s] { s.m_ioService.process_events(); });
+
+			if (!cpus.empty())
+			{
+				const int cpu = cpus[i % cpus.size()];
+				if (local::pin_thread(s.m_thread, cpu))
+				{
+					s.m_cpu = cpu;
+				}
+			}
+		}
+	}
+	catch (...)
+	{
+		shutdown();
+		throw;
+	}
+}
+
+cppcoro::io_service_group::~io_service_group()
+{
+	shutdown();
+}
+
+std::vector<cppcoro::net::socket>
+cppcoro::io_service_group::create_listening_sockets(const net::ip_endpoint& localEndPoint)
+{
+	return create_listening_sockets(localEndPoint, 0);
+}
+
+std::vector<cppcoro::net::socket>
+cppcoro::io_service_group::create_listening_sockets(
+	const net::ip_endpoint& localEndPoint,
+	std::uint32_t backlog)
+{
+	std::vector<net::socket> sockets;
+	sockets.reserve(m_shardCount);
+
+	net::ip_endpoint endPoint = localEndPoint;
+	for (std::uint32_t i = 0; i < m_shardCount; ++i)
+	{
+		auto& s = m_shards[i];
+		auto listeningSocket = endPoint.is_ipv4() ?
+			net::socket::create_tcpv4(s.m_ioService) :
+			net::socket::create_tcpv6(s.m_ioService);
+
+		listeningSocket.set_reuse_port(true);
+		if (s.m_cpu >= 0)
+		{
+			listeningSocket.set_incoming_cpu(s.m_cpu);
+		}
+
+		listeningSocket.bind(endPoint);
+		if (backlog == 0)
+		{
+			listeningSocket.listen();
+		}
+		else
+		{
+			listeningSocket.listen(backlog);
+		}
+
+		// Bind the remaining sockets to the port chosen for the first.
+		endPoint = listeningSocket.local_endpoint();
+
+		sockets.push_back(std::move(listeningSocket));
+	}
+
+	return sockets;
+}
+
+void cppcoro::io_service_group::stop() noexcept
+{
+	for (std::uint32_t i = 0; i < m_shardCount; ++i)
+	{
+		m_shards[i].m_ioService.stop();
+	}
+}
+
+void cppcoro::io_service_group::shutdown() noexcept
+{
+	stop();
+
+	for (std::uint32_t i = 0; i < m_shardCount; ++i)
+	{
+		auto& t = m_shards[i].m_thread;
+		if (t.joinable())
+		{
+			t.join();
+		}
+	}
+}
@@ -10,6 +10,12 @@ std::string cppcoro::net::ip_endpoint::to_string() const
 	return is_ipv4() ? m_ipv4.to_string() : m_ipv6.to_string();
 }
 
+std::to_chars_result
+cppcoro::net::ip_endpoint::to_chars(char* first, char* last) const noexcept
+{
+	return is_ipv4() ? m_ipv4.to_chars(first, last) : m_ipv6.to_chars(first, last);
+}
+
 std::optional<cppcoro::net::ip_endpoint>
 cppcoro::net::ip_endpoint::from_string(std::string_view string) noexcept
 {
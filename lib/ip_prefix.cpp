@@ -0,0 +1,112 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/net/ip_prefix.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+	namespace local
+	{
+		constexpr std::uint64_t mask64(std::uint32_t length) noexcept
+		{
+			return length == 0 ? 0 : length >= 64 ? ~std::uint64_t(0) : ~std::uint64_t(0) << (64 - length);
+		}
+
+		cppcoro::net::ip_address truncate(
+			const cppcoro::net::ip_address& address,
+			std::uint32_t length) noexcept
+		{
+			if (address.is_ipv4())
+			{
+				const std::uint32_t mask = static_cast<std::uint32_t>(mask64(length) >> 32);
+				return cppcoro::net::ipv4_address{ address.to_ipv4().to_integer() & mask };
+			}
+
+			const auto& ipv6 = address.to_ipv6();
+			return cppcoro::net::ipv6_address{
+				ipv6.subnet_prefix() & mask64(length),
+				ipv6.interface_identifier() & mask64(length > 64 ? length - 64 : 0) };
+		}
+
+		std::uint8_t max_length(const cppcoro::net::ip_address& address) noexcept
+		{
+			return address.is_ipv4() ? 32 : 128;
+		}
+	}
+}
+
+cppcoro::net::ip_prefix::ip_prefix(const ip_address& address, std::uint8_t length) noexcept
+	: m_address(local::truncate(address, std::min(length, local::max_length(address))))
+	, m_length(std::min(length, local::max_length(address)))
+{
+	assert(length <= local::max_length(address));
+}
+
+bool cppcoro::net::ip_prefix::contains(const ip_address& address) const noexcept
+{
+	return address.is_ipv4() == m_address.is_ipv4() &&
+		local::truncate(address, m_length) == m_address;
+}
+
+std::string cppcoro::net::ip_prefix::to_string() const
+{
+	char buffer[max_string_length];
+	const auto result = to_chars(buffer, buffer + max_string_length);
+	return std::string{ &buffer[0], result.ptr };
+}
+
+std::to_chars_result
+cppcoro::net::ip_prefix::to_chars(char* first, char* last) const noexcept
+{
+	auto result = m_address.to_chars(first, last);
+	if (result.ec != std::errc{} || result.ptr == last)
+	{
+		return { last, std::errc::value_too_large };
+	}
+
+	*result.ptr++ = '/';
+	return std::to_chars(result.ptr, last, m_length);
+}
+
+std::optional<cppcoro::net::ip_prefix>
+cppcoro::net::ip_prefix::from_string(std::string_view string) noexcept
+{
+	const auto slashPos = string.rfind('/');
+	if (slashPos == std::string_view::npos)
+	{
+		return std::nullopt;
+	}
+
+	auto address = ip_address::from_string(string.substr(0, slashPos));
+	if (!address)
+	{
+		return std::nullopt;
+	}
+
+	// Only accept plain decimal lengths, ie. no sign, no leading zeros and
+	// nothing after the digits.
+	const std::string_view lengthString = string.substr(slashPos + 1);
+	if (lengthString.empty() ||
+		lengthString.size() > 3 ||
+		(lengthString.size() > 1 && lengthString[0] == '0'))
+	{
+		return std::nullopt;
+	}
+
+	std::uint32_t length = 0;
+	const char* lengthEnd = lengthString.data() + lengthString.size();
+	const auto result = std::from_chars(lengthString.data(), lengthEnd, length);
+	if (result.ec != std::errc{} ||
+		result.ptr != lengthEnd ||
+		length > local::max_length(*address))
+	{
+		return std::nullopt;
+	}
+
+	return ip_prefix{ *address, static_cast<std::uint8_t>(length) };
+}
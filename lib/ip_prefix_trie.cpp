@@ -0,0 +1,190 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/detail/ip_prefix_trie.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+namespace
+{
+	namespace local
+	{
+		constexpr std::uint64_t high_mask(std::uint32_t length) noexcept
+		{
+			return length == 0 ? 0 : length >= 64 ? ~std::uint64_t(0) : ~std::uint64_t(0) << (64 - length);
+		}
+
+		constexpr std::uint64_t low_mask(std::uint32_t length) noexcept
+		{
+			return length <= 64 ? 0 : high_mask(length - 64);
+		}
+
+		template<typename KEY>
+		bool has_prefix(const KEY& k, const KEY& prefix, std::uint32_t length) noexcept
+		{
+			return ((k.m_high ^ prefix.m_high) & high_mask(length)) == 0 &&
+				((k.m_low ^ prefix.m_low) & low_mask(length)) == 0;
+		}
+
+		template<typename KEY>
+		KEY truncate(const KEY& k, std::uint32_t length) noexcept
+		{
+			return KEY{ k.m_high & high_mask(length), k.m_low & low_mask(length) };
+		}
+
+		/// The bit of \a k at \a position, counting from the most-significant bit.
+		template<typename KEY>
+		std::uint32_t bit_at(const KEY& k, std::uint32_t position) noexcept
+		{
+			return position < 64 ?
+				static_cast<std::uint32_t>(k.m_high >> (63 - position)) & 1 :
+				static_cast<std::uint32_t>(k.m_low >> (127 - position)) & 1;
+		}
+
+		/// The number of leading bits that \a a and \a b have in common.
+		template<typename KEY>
+		std::uint32_t common_length(const KEY& a, const KEY& b) noexcept
+		{
+			if (a.m_high != b.m_high)
+			{
+				return static_cast<std::uint32_t>(std::countl_zero(a.m_high ^ b.m_high));
+			}
+
+			return 64 + static_cast<std::uint32_t>(std::countl_zero(a.m_low ^ b.m_low));
+		}
+	}
+}
+
+cppcoro::detail::ip_prefix_trie::ip_prefix_trie()
+{
+	// Each trie has a root node for the zero-length prefix, so that a lookup
+	// never has to check for an empty trie.
+	const node root{ key{ 0, 0 }, { 0, 0 }, no_value, 0 };
+	m_ipv4Nodes.push_back(root);
+	m_ipv6Nodes.push_back(root);
+}
+
+void cppcoro::detail::ip_prefix_trie::insert(const net::ip_prefix& prefix, std::uint32_t value)
+{
+	std::vector<node>& nodes = prefix.is_ipv4() ? m_ipv4Nodes : m_ipv6Nodes;
+
+	const key k = to_key(prefix.address());
+	const std::uint32_t length = prefix.length();
+
+	auto newNode = [&](std::uint32_t nodeLength, std::uint32_t nodeValue)
+	{
+		nodes.push_back(node{ local::truncate(k, nodeLength), { 0, 0 }, nodeValue, static_cast<std::uint8_t>(nodeLength) });
+		return static_cast<std::uint32_t>(nodes.size() - 1);
+	};
+
+	// Nodes are referred to by index as adding a node may reallocate them.
+	// Index 0 is the root, which is never a child, so it doubles as 'no child'.
+	std::uint32_t current = 0;
+	while (true)
+	{
+		assert(local::has_prefix(k, nodes[current].m_prefix, nodes[current].m_length));
+
+		const std::uint32_t currentLength = nodes[current].m_length;
+		if (currentLength == length)
+		{
+			nodes[current].m_value = value;
+			return;
+		}
+
+		const std::uint32_t branch = local::bit_at(k, currentLength);
+		const std::uint32_t child = nodes[current].m_children[branch];
+		if (child == 0)
+		{
+			const std::uint32_t leaf = newNode(length, value);
+			nodes[current].m_children[branch] = leaf;
+			return;
+		}
+
+		const std::uint32_t childLength = nodes[child].m_length;
+		const std::uint32_t common = std::min(
+			{ local::common_length(k, nodes[child].m_prefix), childLength, length });
+
+		if (common == childLength)
+		{
+			// The child's prefix is a prefix of the one being inserted.
+			current = child;
+			continue;
+		}
+
+		if (common == length)
+		{
+			// The prefix being inserted is a prefix of the child's, so goes
+			// between the current node and the child.
+			const std::uint32_t middle = newNode(length, value);
+			nodes[middle].m_children[local::bit_at(nodes[child].m_prefix, length)] = child;
+			nodes[current].m_children[branch] = middle;
+			return;
+		}
+
+		// The prefixes diverge part-way through the child's prefix, so add a
+		// valueless node where they diverge with both as its children.
+		const std::uint32_t fork = newNode(common, no_value);
+		const std::uint32_t leaf = newNode(length, value);
+		nodes[fork].m_children[local::bit_at(nodes[child].m_prefix, common)] = child;
+		nodes[fork].m_children[local::bit_at(k, common)] = leaf;
+		nodes[current].m_children[branch] = fork;
+		return;
+	}
+}
+
+std::uint32_t cppcoro::detail::ip_prefix_trie::longest_match(
+	const net::ip_address& address) const noexcept
+{
+	const std::vector<node>& nodes = address.is_ipv4() ? m_ipv4Nodes : m_ipv6Nodes;
+	const std::uint32_t maxLength = address.is_ipv4() ? 32 : 128;
+
+	const key k = to_key(address);
+
+	std::uint32_t result = no_value;
+	const node* current = &nodes[0];
+	while (true)
+	{
+		// Skipped-over bits are only checked here, so a node reached through
+		// a compressed path may turn out not to match.
+		if (!local::has_prefix(k, current->m_prefix, current->m_length))
+		{
+			break;
+		}
+
+		if (current->m_value != no_value)
+		{
+			result = current->m_value;
+		}
+
+		if (current->m_length == maxLength)
+		{
+			break;
+		}
+
+		const std::uint32_t child = current->m_children[local::bit_at(k, current->m_length)];
+		if (child == 0)
+		{
+			break;
+		}
+
+		current = &nodes[child];
+	}
+
+	return result;
+}
+
+cppcoro::detail::ip_prefix_trie::key
+cppcoro::detail::ip_prefix_trie::to_key(const net::ip_address& address) noexcept
+{
+	if (address.is_ipv4())
+	{
+		return key{ std::uint64_t(address.to_ipv4().to_integer()) << 32, 0 };
+	}
+
+	const auto& ipv6 = address.to_ipv6();
+	return key{ ipv6.subnet_prefix(), ipv6.interface_identifier() };
+}
@@ -5,6 +5,10 @@
 
 #include <cppcoro/net/ipv4_address.hpp>
 
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
 namespace
 {
 	namespace local
@@ -18,6 +22,99 @@ namespace
 		{
 			return static_cast<std::uint8_t>(c - '0');
 		}
+
+		constexpr std::uint64_t repeat_byte(std::uint8_t value)
+		{
+			return 0x0101010101010101ull * value;
+		}
+
+		// Sets the high bit of each byte of 'word' that is not an ASCII decimal digit.
+		constexpr std::uint64_t non_digit_bytes(std::uint64_t word)
+		{
+			// Maps '0'..'9' to 0..9. Adding 0x76 then carries into the high bit
+			// of each byte that is 10 or more, without carrying into the next byte.
+			const std::uint64_t t = word ^ repeat_byte('0');
+			return (((t & repeat_byte(0x7F)) + repeat_byte(0x76)) | t) & repeat_byte(0x80);
+		}
+
+		// Sets the high bit of each byte of 'word' that is not a '.'.
+		constexpr std::uint64_t non_dot_bytes(std::uint64_t word)
+		{
+			const std::uint64_t t = word ^ repeat_byte('.');
+			return (((t & repeat_byte(0x7F)) + repeat_byte(0x7F)) | t) & repeat_byte(0x80);
+		}
+
+		// Gathers the high bit of each byte into an 8-bit mask, with byte 0 in bit 0.
+		constexpr std::uint32_t byte_mask(std::uint64_t highBits)
+		{
+			return static_cast<std::uint32_t>(((highBits >> 7) * 0x0102040810204080ull) >> 56);
+		}
+
+		// Parses the common "num.num.num.num" form a word at a time, classifying
+		// all of the chars at once rather than branching on each one.
+		//
+		// Returns false if the string isn't a well-formed dotted quad, in which
+		// case the caller falls back to the general parser.
+		bool try_parse_dotted_quad(std::string_view string, std::uint8_t(&partValues)[4]) noexcept
+		{
+			if constexpr (std::endian::native != std::endian::little)
+			{
+				return false;
+			}
+
+			const std::size_t length = string.length();
+			if (length < 7 || length > 15)
+			{
+				return false;
+			}
+
+			// Padding bytes are neither digits nor dots and are masked off below.
+			char buffer[16] = {};
+			std::memcpy(buffer, string.data(), length);
+
+			std::uint64_t words[2];
+			std::memcpy(words, buffer, sizeof(words));
+
+			const std::uint32_t lengthMask = (1u << length) - 1;
+			const std::uint32_t nonDigits =
+				byte_mask(non_digit_bytes(words[0])) | byte_mask(non_digit_bytes(words[1])) << 8;
+			std::uint32_t dots =
+				~(byte_mask(non_dot_bytes(words[0])) | byte_mask(non_dot_bytes(words[1])) << 8) & lengthMask;
+
+			if ((nonDigits & ~dots & lengthMask) != 0 || std::popcount(dots) != 3)
+			{
+				return false;
+			}
+
+			std::size_t start = 0;
+			for (int part = 0; part < 4; ++part)
+			{
+				const std::size_t end = part < 3 ? static_cast<std::size_t>(std::countr_zero(dots)) : length;
+				dots &= dots - 1;
+
+				const std::size_t digitCount = end - start;
+				if (digitCount == 0 || digitCount > 3 || (digitCount > 1 && buffer[start] == '0'))
+				{
+					return false;
+				}
+
+				std::uint32_t partValue = digit_value(buffer[start]);
+				for (std::size_t i = start + 1; i < end; ++i)
+				{
+					partValue = partValue * 10 + digit_value(buffer[i]);
+				}
+
+				if (partValue > 255)
+				{
+					return false;
+				}
+
+				partValues[part] = static_cast<std::uint8_t>(partValue);
+				start = end + 1;
+			}
+
+			return true;
+		}
 	}
 }
 
@@ -31,10 +128,15 @@ cppcoro::net::ipv4_address::from_string(std::string_view string) noexcept
 		return std::nullopt;
 	}
 
-	const auto length = string.length();
-
 	std::uint8_t partValues[4];
 
+	if (local::try_parse_dotted_quad(string, partValues))
+	{
+		return ipv4_address{ partValues };
+	}
+
+	const auto length = string.length();
+
 	if (string[0] == '0' && length > 1)
 	{
 		if (local::is_digit(string[1]))
@@ -141,11 +243,29 @@ cppcoro::net::ipv4_address::from_string(std::string_view string) noexcept
 
 std::string cppcoro::net::ipv4_address::to_string() const
 {
-	// Buffer is large enough to hold larges ip address
-	// "xxx.xxx.xxx.xxx"
-	char buffer[15];
+	char buffer[max_string_length];
+	const auto result = to_chars(buffer, buffer + max_string_length);
+	return std::string{ &buffer[0], result.ptr };
+}
+
+std::to_chars_result
+cppcoro::net::ipv4_address::to_chars(char* first, char* last) const noexcept
+{
+	if (static_cast<std::size_t>(last - first) < max_string_length)
+	{
+		// Format into a buffer that is big enough and copy what fits.
+		char buffer[max_string_length];
+		const auto result = to_chars(buffer, buffer + max_string_length);
+		const auto length = result.ptr - buffer;
+		if (length > last - first)
+		{
+			return { last, std::errc::value_too_large };
+		}
+
+		return { std::copy(buffer, result.ptr, first), std::errc{} };
+	}
 
-	char* c = &buffer[0];
+	char* c = first;
 	for (int i = 0; i < 4; ++i)
 	{
 		if (i > 0)
@@ -170,5 +290,5 @@ std::string cppcoro::net::ipv4_address::to_string() const
 		}
 	}
 
-	return std::string{ &buffer[0], c };
+	return { c, std::errc{} };
 }
@@ -40,10 +40,22 @@ namespace
 
 std::string cppcoro::net::ipv4_endpoint::to_string() const
 {
-	auto s = m_address.to_string();
-	s.push_back(':');
-	s.append(std::to_string(m_port));
-	return s;
+	char buffer[max_string_length];
+	const auto result = to_chars(buffer, buffer + max_string_length);
+	return std::string{ &buffer[0], result.ptr };
+}
+
+std::to_chars_result
+cppcoro::net::ipv4_endpoint::to_chars(char* first, char* last) const noexcept
+{
+	auto result = m_address.to_chars(first, last);
+	if (result.ec != std::errc{} || result.ptr == last)
+	{
+		return { last, std::errc::value_too_large };
+	}
+
+	*result.ptr++ = ':';
+	return std::to_chars(result.ptr, last, m_port);
 }
 
 std::optional<cppcoro::net::ipv4_endpoint>
@@ -6,6 +6,8 @@
 #include <cppcoro/net/ipv6_address.hpp>
 #include <cppcoro/config.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 
 namespace
@@ -46,6 +48,109 @@ namespace
 				static_cast<char>('0' + value) :
 				static_cast<char>('a' + value - 10);
 		}
+
+		// Maps each char to its hex digit value, or to 0xFF if it isn't a hex digit.
+		constexpr auto hexDigitValues = []
+		{
+			std::array<std::uint8_t, 256> values{};
+			for (std::size_t c = 0; c < values.size(); ++c)
+			{
+				values[c] =
+					(c >= '0' && c <= '9') ? static_cast<std::uint8_t>(c - '0') :
+					(c >= 'a' && c <= 'f') ? static_cast<std::uint8_t>(c - 'a' + 10) :
+					(c >= 'A' && c <= 'F') ? static_cast<std::uint8_t>(c - 'A' + 10) :
+					0xFF;
+			}
+			return values;
+		}();
+
+		// Parses the common all-hex forms, eg. "2001:db8::8a2e:370:7334", in a
+		// single table-driven pass.
+		//
+		// Returns false for anything else, including embedded dotted decimal
+		// and malformed strings, in which case the caller falls back to the
+		// general parser.
+		bool try_parse_hex_parts(std::string_view string, std::uint16_t(&parts)[8]) noexcept
+		{
+			const std::size_t length = string.length();
+
+			int partCount = 0;
+			int doubleColonPos = -1;
+			std::size_t pos = 0;
+
+			if (length >= 2 && string[0] == ':' && string[1] == ':')
+			{
+				doubleColonPos = 0;
+				pos = 2;
+			}
+
+			while (pos < length)
+			{
+				if (partCount == 8)
+				{
+					return false;
+				}
+
+				const std::size_t partStart = pos;
+				std::uint32_t partValue = 0;
+				while (pos < length && (pos - partStart) < 4)
+				{
+					const std::uint8_t digit = hexDigitValues[static_cast<unsigned char>(string[pos])];
+					if (digit > 15)
+					{
+						break;
+					}
+
+					partValue = (partValue << 4) | digit;
+					++pos;
+				}
+
+				if (pos == partStart)
+				{
+					return false;
+				}
+
+				parts[partCount++] = static_cast<std::uint16_t>(partValue);
+
+				if (pos == length)
+				{
+					break;
+				}
+
+				if (string[pos] != ':' || ++pos == length)
+				{
+					return false;
+				}
+
+				if (string[pos] == ':')
+				{
+					if (doubleColonPos >= 0)
+					{
+						return false;
+					}
+
+					doubleColonPos = partCount;
+					++pos;
+				}
+			}
+
+			if (doubleColonPos < 0)
+			{
+				return partCount == 8;
+			}
+
+			if (partCount == 8)
+			{
+				return false;
+			}
+
+			// Move the parts after the double colon to the end and zero the gap.
+			const int zeroCount = 8 - partCount;
+			std::copy_backward(parts + doubleColonPos, parts + partCount, parts + 8);
+			std::fill_n(parts + doubleColonPos, zeroCount, std::uint16_t(0));
+
+			return true;
+		}
 	}
 }
 
@@ -61,6 +166,13 @@ cppcoro::net::ipv6_address::from_string(std::string_view string) noexcept
 		return std::nullopt;
 	}
 
+	std::uint16_t parts[8] = { 0 };
+
+	if (local::try_parse_hex_parts(string, parts))
+	{
+		return ipv6_address{ parts };
+	}
+
 	const std::size_t length = string.length();
 
 	std::optional<int> doubleColonPos;
@@ -74,7 +186,7 @@ cppcoro::net::ipv6_address::from_string(std::string_view string) noexcept
 	}
 
 	int partCount = 0;
-	std::uint16_t parts[8] = { 0 };
+	std::fill_n(parts, 8, std::uint16_t(0));
 
 	while (pos < length && partCount < 8)
 	{
@@ -269,6 +381,28 @@ cppcoro::net::ipv6_address::from_string(std::string_view string) noexcept
 
 std::string cppcoro::net::ipv6_address::to_string() const
 {
+	char buffer[max_string_length];
+	const auto result = to_chars(buffer, buffer + max_string_length);
+	return std::string{ &buffer[0], result.ptr };
+}
+
+std::to_chars_result
+cppcoro::net::ipv6_address::to_chars(char* first, char* last) const noexcept
+{
+	if (static_cast<std::size_t>(last - first) < max_string_length)
+	{
+		// Format into a buffer that is big enough and copy what fits.
+		char buffer[max_string_length];
+		const auto result = to_chars(buffer, buffer + max_string_length);
+		const auto length = result.ptr - buffer;
+		if (length > last - first)
+		{
+			return { last, std::errc::value_too_large };
+		}
+
+		return { std::copy(buffer, result.ptr, first), std::errc{} };
+	}
+
 	std::uint32_t longestZeroRunStart = 0;
 	std::uint32_t longestZeroRunLength = 0;
 	for (std::uint32_t i = 0; i < 8; )
@@ -295,10 +429,7 @@ std::string cppcoro::net::ipv6_address::to_string() const
 		}
 	}
 
-	// Longest string will be 8 x 4 digits + 7 ':' separators
-	char buffer[40];
-
-	char* c = &buffer[0];
+	char* c = first;
 
 	auto appendPart = [&](std::uint32_t index)
 	{
@@ -356,7 +487,7 @@ std::string cppcoro::net::ipv6_address::to_string() const
 		}
 	}
 
-	assert((c - &buffer[0]) <= sizeof(buffer));
+	assert(static_cast<std::size_t>(c - first) <= max_string_length);
 
-	return std::string{ &buffer[0], c };
+	return { c, std::errc{} };
 }
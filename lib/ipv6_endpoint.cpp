@@ -40,12 +40,30 @@ namespace
 
 std::string cppcoro::net::ipv6_endpoint::to_string() const
 {
-	std::string result;
-	result.push_back('[');
-	result += m_address.to_string();
-	result += "]:";
-	result += std::to_string(m_port);
-	return result;
+	char buffer[max_string_length];
+	const auto result = to_chars(buffer, buffer + max_string_length);
+	return std::string{ &buffer[0], result.ptr };
+}
+
+std::to_chars_result
+cppcoro::net::ipv6_endpoint::to_chars(char* first, char* last) const noexcept
+{
+	if (first == last)
+	{
+		return { last, std::errc::value_too_large };
+	}
+
+	*first++ = '[';
+
+	auto result = m_address.to_chars(first, last);
+	if (result.ec != std::errc{} || last - result.ptr < 2)
+	{
+		return { last, std::errc::value_too_large };
+	}
+
+	*result.ptr++ = ']';
+	*result.ptr++ = ':';
+	return std::to_chars(result.ptr, last, m_port);
 }
 
 std::optional<cppcoro::net::ipv6_endpoint>
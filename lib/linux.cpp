@@ -0,0 +1,324 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/detail/linux.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <system_error>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace
+{
+	namespace local
+	{
+		std::uint32_t load_acquire(const std::uint32_t* value) noexcept
+		{
+			return std::atomic_ref<const std::uint32_t>{ *value }.load(std::memory_order_acquire);
+		}
+
+		void store_release(std::uint32_t* value, std::uint32_t newValue) noexcept
+		{
+			std::atomic_ref<std::uint32_t>{ *value }.store(newValue, std::memory_order_release);
+		}
+
+		void* map_ring(int ringFd, std::size_t size, off_t offset)
+		{
+			void* ring = ::mmap(
+				nullptr,
+				size,
+				PROT_READ | PROT_WRITE,
+				MAP_SHARED | MAP_POPULATE,
+				ringFd,
+				offset);
+			if (ring == MAP_FAILED)
+			{
+				throw std::system_error
+				{
+					errno,
+					std::system_category(),
+					"Error creating io_service: mmap"
+				};
+			}
+
+			return ring;
+		}
+	}
+}
+
+void cppcoro::detail::lnx::safe_fd::close() noexcept
+{
+	if (m_fd != -1)
+	{
+		::close(m_fd);
+		m_fd = -1;
+	}
+}
+
+cppcoro::detail::lnx::io_uring_queue::io_uring_queue(std::uint32_t entries)
+	: m_sqRing(nullptr)
+	, m_sqRingSize(0)
+	, m_cqRing(nullptr)
+	, m_cqRingSize(0)
+	, m_sqes(nullptr)
+	, m_sqesSize(0)
+	, m_sqLocalTail(0)
+{
+	io_uring_params params;
+	std::memset(&params, 0, sizeof(params));
+	params.flags = IORING_SETUP_CLAMP;
+
+	const long ringFd = ::syscall(__NR_io_uring_setup, entries, &params);
+	if (ringFd < 0)
+	{
+		throw std::system_error
+		{
+			errno,
+			std::system_category(),
+			"Error creating io_service: io_uring_setup"
+		};
+	}
+
+	m_ringFd = safe_fd{ static_cast<fd_t>(ringFd) };
+
+	// Without this feature the kernel silently drops completions when the
+	// completion queue is full, which would leave operations hanging.
+	if ((params.features & IORING_FEAT_NODROP) == 0)
+	{
+		throw std::system_error
+		{
+			ENOSYS,
+			std::system_category(),
+			"Error creating io_service: io_uring does not support IORING_FEAT_NODROP"
+		};
+	}
+
+	try
+	{
+		m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(std::uint32_t);
+		m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+		if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0)
+		{
+			m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+			m_sqRing = local::map_ring(m_ringFd.fd(), m_sqRingSize, IORING_OFF_SQ_RING);
+			m_cqRing = m_sqRing;
+		}
+		else
+		{
+			m_sqRing = local::map_ring(m_ringFd.fd(), m_sqRingSize, IORING_OFF_SQ_RING);
+			m_cqRing = local::map_ring(m_ringFd.fd(), m_cqRingSize, IORING_OFF_CQ_RING);
+		}
+
+		m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+		m_sqes = static_cast<io_uring_sqe*>(
+			local::map_ring(m_ringFd.fd(), m_sqesSize, IORING_OFF_SQES));
+	}
+	catch (...)
+	{
+		unmap();
+		throw;
+	}
+
+	auto* sqRing = static_cast<std::byte*>(m_sqRing);
+	m_sqHead = reinterpret_cast<std::uint32_t*>(sqRing + params.sq_off.head);
+	m_sqTail = reinterpret_cast<std::uint32_t*>(sqRing + params.sq_off.tail);
+	m_sqMask = *reinterpret_cast<std::uint32_t*>(sqRing + params.sq_off.ring_mask);
+	m_sqEntries = params.sq_entries;
+
+	auto* cqRing = static_cast<std::byte*>(m_cqRing);
+	m_cqHead = reinterpret_cast<std::uint32_t*>(cqRing + params.cq_off.head);
+	m_cqTail = reinterpret_cast<std::uint32_t*>(cqRing + params.cq_off.tail);
+	m_cqMask = *reinterpret_cast<std::uint32_t*>(cqRing + params.cq_off.ring_mask);
+	m_cqes = reinterpret_cast<io_uring_cqe*>(cqRing + params.cq_off.cqes);
+
+	// Entries are always consumed in order, so map each slot of the
+	// indirection array to the entry with the same index once up-front.
+	auto* sqArray = reinterpret_cast<std::uint32_t*>(sqRing + params.sq_off.array);
+	for (std::uint32_t i = 0; i < m_sqEntries; ++i)
+	{
+		sqArray[i] = i;
+	}
+
+	m_sqLocalTail = *m_sqTail;
+}
+
+cppcoro::detail::lnx::io_uring_queue::~io_uring_queue()
+{
+	unmap();
+}
+
+io_uring_sqe* cppcoro::detail::lnx::io_uring_queue::get_sqe() noexcept
+{
+	if (m_sqLocalTail - local::load_acquire(m_sqHead) >= m_sqEntries)
+	{
+		submit_pending();
+
+		if (m_sqLocalTail - local::load_acquire(m_sqHead) >= m_sqEntries)
+		{
+			return nullptr;
+		}
+	}
+
+	io_uring_sqe* sqe = &m_sqes[m_sqLocalTail & m_sqMask];
+	std::memset(sqe, 0, sizeof(io_uring_sqe));
+	++m_sqLocalTail;
+	return sqe;
+}
+
+void cppcoro::detail::lnx::io_uring_queue::submit_pending() noexcept
+{
+	local::store_release(m_sqTail, m_sqLocalTail);
+
+	int result;
+	do
+	{
+		const std::uint32_t toSubmit = m_sqLocalTail - local::load_acquire(m_sqHead);
+		if (toSubmit == 0)
+		{
+			return;
+		}
+
+		result = enter(toSubmit, 0, 0);
+	} while (result == -EINTR);
+}
+
+void cppcoro::detail::lnx::io_uring_queue::cancel(std::uint64_t userData) noexcept
+{
+	// We intentionally ignore the return code here as there is nothing more
+	// we can do. The operation will just run to completion instead.
+	(void)submit([userData](io_uring_sqe& sqe)
+	{
+		sqe.opcode = IORING_OP_ASYNC_CANCEL;
+		sqe.fd = -1;
+		sqe.addr = userData;
+		sqe.user_data = ignored_user_data;
+	});
+}
+
+int cppcoro::detail::lnx::io_uring_queue::post(std::uint64_t userData) noexcept
+{
+	return submit([userData](io_uring_sqe& sqe)
+	{
+		sqe.opcode = IORING_OP_NOP;
+		sqe.fd = -1;
+		sqe.user_data = userData;
+	});
+}
+
+int cppcoro::detail::lnx::io_uring_queue::register_buffer_ring(
+	void* ring,
+	std::uint32_t entries,
+	std::uint16_t groupId) noexcept
+{
+	io_uring_buf_reg reg;
+	std::memset(&reg, 0, sizeof(reg));
+	reg.ring_addr = reinterpret_cast<std::uintptr_t>(ring);
+	reg.ring_entries = entries;
+	reg.bgid = groupId;
+
+	const long result = ::syscall(
+		__NR_io_uring_register,
+		m_ringFd.fd(),
+		IORING_REGISTER_PBUF_RING,
+		&reg,
+		1);
+	return result < 0 ? -errno : 0;
+}
+
+int cppcoro::detail::lnx::io_uring_queue::unregister_buffer_ring(std::uint16_t groupId) noexcept
+{
+	io_uring_buf_reg reg;
+	std::memset(&reg, 0, sizeof(reg));
+	reg.bgid = groupId;
+
+	const long result = ::syscall(
+		__NR_io_uring_register,
+		m_ringFd.fd(),
+		IORING_UNREGISTER_PBUF_RING,
+		&reg,
+		1);
+	return result < 0 ? -errno : 0;
+}
+
+bool cppcoro::detail::lnx::io_uring_queue::try_get_completion(completion& result) noexcept
+{
+	std::lock_guard lock{ m_completionMutex };
+
+	const std::uint32_t head = *m_cqHead;
+	if (head == local::load_acquire(m_cqTail))
+	{
+		return false;
+	}
+
+	const io_uring_cqe& cqe = m_cqes[head & m_cqMask];
+	result.user_data = cqe.user_data;
+	result.result = cqe.res;
+	result.flags = cqe.flags;
+
+	local::store_release(m_cqHead, head + 1);
+
+	return true;
+}
+
+void cppcoro::detail::lnx::io_uring_queue::wait_for_completion()
+{
+	// Also submit any entries left queued by an earlier call to submit_pending().
+	const std::uint32_t toSubmit =
+		local::load_acquire(m_sqTail) - local::load_acquire(m_sqHead);
+
+	const int result = enter(toSubmit, 1, IORING_ENTER_GETEVENTS);
+	if (result < 0 && result != -EINTR && result != -EAGAIN && result != -EBUSY)
+	{
+		throw std::system_error
+		{
+			-result,
+			std::system_category(),
+			"Error retrieving item from io_service queue: io_uring_enter"
+		};
+	}
+}
+
+void cppcoro::detail::lnx::io_uring_queue::unmap() noexcept
+{
+	if (m_sqes != nullptr)
+	{
+		::munmap(m_sqes, m_sqesSize);
+		m_sqes = nullptr;
+	}
+
+	if (m_cqRing != nullptr && m_cqRing != m_sqRing)
+	{
+		::munmap(m_cqRing, m_cqRingSize);
+	}
+	m_cqRing = nullptr;
+
+	if (m_sqRing != nullptr)
+	{
+		::munmap(m_sqRing, m_sqRingSize);
+		m_sqRing = nullptr;
+	}
+}
+
+int cppcoro::detail::lnx::io_uring_queue::enter(
+	std::uint32_t toSubmit,
+	std::uint32_t minComplete,
+	std::uint32_t flags) noexcept
+{
+	const long result = ::syscall(
+		__NR_io_uring_enter,
+		m_ringFd.fd(),
+		toSubmit,
+		minComplete,
+		flags,
+		nullptr,
+		0);
+	return result < 0 ? -errno : static_cast<int>(result);
+}
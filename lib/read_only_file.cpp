@@ -3,7 +3,8 @@
 // Licenced under MIT license. See LICENSE.txt for details.
 ///////////////////////////////////////////////////////////////////////////////
 
-#include <cppcoro\read_only_file.hpp>
+#include <cppcoro/read_only_file.hpp>
+#include <cppcoro/io_service.hpp>
 
 #if CPPCORO_OS_WINNT
 # ifndef WIN32_LEAN_AND_MEAN
@@ -33,4 +34,31 @@ cppcoro::read_only_file::read_only_file(
 {
 }
 
+#elif CPPCORO_OS_LINUX
+# include <fcntl.h>
+
+cppcoro::read_only_file cppcoro::read_only_file::open(
+	io_service& ioService,
+	const cppcoro::filesystem::path& path,
+	file_share_mode shareMode,
+	file_buffering_mode bufferingMode)
+{
+	return read_only_file(file::open(
+		O_RDONLY,
+		ioService,
+		path,
+		file_open_mode::open_existing,
+		shareMode,
+		bufferingMode),
+		ioService);
+}
+
+cppcoro::read_only_file::read_only_file(
+	detail::lnx::safe_fd&& fileDescriptor,
+	io_service& ioService) noexcept
+	: file(std::move(fileDescriptor), &ioService)
+	, readable_file(detail::lnx::safe_fd{}, &ioService)
+{
+}
+
 #endif
@@ -3,7 +3,8 @@
 // Licenced under MIT license. See LICENSE.txt for details.
 ///////////////////////////////////////////////////////////////////////////////
 
-#include <cppcoro\read_write_file.hpp>
+#include <cppcoro/read_write_file.hpp>
+#include <cppcoro/io_service.hpp>
 
 #if CPPCORO_OS_WINNT
 # ifndef WIN32_LEAN_AND_MEAN
@@ -35,4 +36,33 @@ cppcoro::read_write_file::read_write_file(
 {
 }
 
+#elif CPPCORO_OS_LINUX
+# include <fcntl.h>
+
+cppcoro::read_write_file cppcoro::read_write_file::open(
+	io_service& ioService,
+	const cppcoro::filesystem::path& path,
+	file_open_mode openMode,
+	file_share_mode shareMode,
+	file_buffering_mode bufferingMode)
+{
+	return read_write_file(file::open(
+		O_RDWR,
+		ioService,
+		path,
+		openMode,
+		shareMode,
+		bufferingMode),
+		ioService);
+}
+
+cppcoro::read_write_file::read_write_file(
+	detail::lnx::safe_fd&& fileDescriptor,
+	io_service& ioService) noexcept
+	: file(std::move(fileDescriptor), &ioService)
+	, readable_file(detail::lnx::safe_fd{}, &ioService)
+	, writable_file(detail::lnx::safe_fd{}, &ioService)
+{
+}
+
 #endif
@@ -4,6 +4,16 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <cppcoro/readable_file.hpp>
+#include <cppcoro/io_service.hpp>
+#include <cppcoro/cancellation_source.hpp>
+#include <cppcoro/single_consumer_event.hpp>
+#include <cppcoro/on_scope_exit.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <exception>
+#include <memory>
+#include <new>
 
 #if CPPCORO_OS_WINNT
 
@@ -33,4 +43,222 @@ cppcoro::file_read_operation_cancellable cppcoro::readable_file::read(
 		std::move(ct));
 }
 
+cppcoro::file_read_many_operation cppcoro::readable_file::read_many(
+	std::span<file_read_request> requests,
+	cancellation_token ct) const noexcept
+{
+	return file_read_many_operation(
+		m_fileHandle.handle(),
+		requests,
+		std::move(ct));
+}
+
+#elif CPPCORO_OS_LINUX
+
+cppcoro::file_read_operation cppcoro::readable_file::read(
+	std::uint64_t offset,
+	void* buffer,
+	std::size_t byteCount) const noexcept
+{
+	return file_read_operation(
+		m_ioService->native_io_uring_queue(),
+		m_fileDescriptor.fd(),
+		offset,
+		buffer,
+		byteCount);
+}
+
+cppcoro::file_read_operation_cancellable cppcoro::readable_file::read(
+	std::uint64_t offset,
+	void* buffer,
+	std::size_t byteCount,
+	cancellation_token ct) const noexcept
+{
+	return file_read_operation_cancellable(
+		m_ioService->native_io_uring_queue(),
+		m_fileDescriptor.fd(),
+		offset,
+		buffer,
+		byteCount,
+		std::move(ct));
+}
+
+cppcoro::file_read_many_operation cppcoro::readable_file::read_many(
+	std::span<file_read_request> requests,
+	cancellation_token ct) const noexcept
+{
+	return file_read_many_operation(
+		m_ioService->native_io_uring_queue(),
+		m_fileDescriptor.fd(),
+		requests,
+		std::move(ct));
+}
+
 #endif
+
+namespace
+{
+	namespace local
+	{
+		// Buffers are aligned to a page boundary so that read_chunks() can be
+		// used with files opened using file_buffering_mode::unbuffered.
+		constexpr std::size_t read_ahead_buffer_alignment = 4096;
+
+		struct read_ahead_slot
+		{
+			std::byte* m_buffer = nullptr;
+			std::size_t m_bytesRead = 0;
+			std::exception_ptr m_exception;
+			cppcoro::single_consumer_event m_completed;
+		};
+
+		/// State shared between a read_chunks() generator and the reads that
+		/// it has in flight.
+		///
+		/// Reads hold a reference to this state so that the buffers remain
+		/// valid until every read has completed, even if the generator is
+		/// destroyed while reads are still outstanding.
+		class read_ahead_state
+		{
+		public:
+
+			read_ahead_state(std::size_t slotCount, std::size_t chunkSize)
+				: m_slotCount(slotCount)
+				, m_slots(std::make_unique<read_ahead_slot[]>(slotCount))
+				, m_storage(static_cast<std::byte*>(::operator new(
+					slotCount * chunkSize,
+					std::align_val_t{ read_ahead_buffer_alignment })))
+			{
+				for (std::size_t i = 0; i < slotCount; ++i)
+				{
+					m_slots[i].m_buffer = m_storage + i * chunkSize;
+				}
+			}
+
+			~read_ahead_state()
+			{
+				::operator delete(m_storage, std::align_val_t{ read_ahead_buffer_alignment });
+			}
+
+			read_ahead_state(const read_ahead_state&) = delete;
+			read_ahead_state& operator=(const read_ahead_state&) = delete;
+
+			read_ahead_slot& slot_for_chunk(std::uint64_t chunkIndex) noexcept
+			{
+				return m_slots[static_cast<std::size_t>(chunkIndex % m_slotCount)];
+			}
+
+			cppcoro::cancellation_source m_canceller;
+
+		private:
+
+			std::size_t m_slotCount;
+			std::unique_ptr<read_ahead_slot[]> m_slots;
+			std::byte* m_storage;
+
+		};
+
+		struct oneway_task
+		{
+			struct promise_type
+			{
+				cppcoro::suspend_never initial_suspend() { return {}; }
+				cppcoro::suspend_never final_suspend() noexcept { return {}; }
+				void unhandled_exception() { std::terminate(); }
+				oneway_task get_return_object() { return {}; }
+				void return_void() {}
+			};
+		};
+
+		oneway_task read_chunk(
+			const cppcoro::readable_file& file,
+			std::shared_ptr<read_ahead_state> state,
+			read_ahead_slot& slot,
+			std::uint64_t offset,
+			std::size_t byteCount)
+		{
+			try
+			{
+				slot.m_bytesRead = co_await file.read(
+					offset, slot.m_buffer, byteCount, state->m_canceller.token());
+			}
+			catch (...)
+			{
+				slot.m_exception = std::current_exception();
+			}
+
+			slot.m_completed.set();
+		}
+	}
+}
+
+cppcoro::async_generator<std::span<const std::byte>>
+cppcoro::readable_file::read_chunks(
+	std::size_t chunkSize,
+	std::uint32_t readAheadDepth) const
+{
+	assert(chunkSize > 0);
+	assert(readAheadDepth > 0);
+
+	const std::uint64_t fileSize = size();
+	const std::uint64_t chunkCount = (fileSize + chunkSize - 1) / chunkSize;
+
+	// One more slot than the read-ahead depth so that the chunk currently
+	// held by the consumer does not count against the reads in flight.
+	auto state = std::make_shared<local::read_ahead_state>(
+		std::size_t(readAheadDepth) + 1, chunkSize);
+
+	// If the consumer stops early (or a read fails) then don't leave the
+	// remaining reads running to completion in the background.
+	auto cancelOutstandingReads = on_scope_exit([&state]
+	{
+		state->m_canceller.request_cancellation();
+	});
+
+	const auto startRead = [&](std::uint64_t chunkIndex)
+	{
+		auto& slot = state->slot_for_chunk(chunkIndex);
+		slot.m_completed.reset();
+		slot.m_exception = nullptr;
+		slot.m_bytesRead = 0;
+
+		// Always ask for a whole chunk, even for the last one, and let the read
+		// come up short at end-of-file. Trimming the length to the file size
+		// would make it unaligned, which unbuffered reads reject.
+		local::read_chunk(*this, state, slot, chunkIndex * chunkSize, chunkSize);
+	};
+
+	for (std::uint64_t chunkIndex = 0;
+		chunkIndex < std::min<std::uint64_t>(readAheadDepth, chunkCount);
+		++chunkIndex)
+	{
+		startRead(chunkIndex);
+	}
+
+	for (std::uint64_t chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex)
+	{
+		auto& slot = state->slot_for_chunk(chunkIndex);
+
+		co_await slot.m_completed;
+
+		if (slot.m_exception)
+		{
+			std::rethrow_exception(slot.m_exception);
+		}
+
+		// The slot that will receive this read is the one whose chunk the
+		// consumer finished with when it advanced the generator to get here.
+		if (chunkIndex + readAheadDepth < chunkCount)
+		{
+			startRead(chunkIndex + readAheadDepth);
+		}
+
+		if (slot.m_bytesRead == 0)
+		{
+			// The file was truncated after we started reading.
+			break;
+		}
+
+		co_yield std::span<const std::byte>{ slot.m_buffer, slot.m_bytesRead };
+	}
+}
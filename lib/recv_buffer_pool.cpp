@@ -0,0 +1,197 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/net/recv_buffer_pool.hpp>
+
+#if CPPCORO_OS_LINUX
+# include <cppcoro/io_service.hpp>
+
+# include <atomic>
+# include <cassert>
+# include <cerrno>
+# include <system_error>
+# include <utility>
+
+# include <linux/io_uring.h>
+# include <sys/mman.h>
+
+namespace
+{
+	namespace local
+	{
+		std::uint16_t allocate_group_id() noexcept
+		{
+			// Buffer group ids only need to be unique within an io_uring but
+			// it's simpler to make them unique within the process.
+			static std::atomic<std::uint16_t> nextGroupId{ 0 };
+			return nextGroupId.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		void* map_anonymous(std::size_t size)
+		{
+			void* memory = ::mmap(
+				nullptr,
+				size,
+				PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS,
+				-1,
+				0);
+			if (memory == MAP_FAILED)
+			{
+				throw std::system_error
+				{
+					errno,
+					std::system_category(),
+					"Error creating receive buffer pool: mmap"
+				};
+			}
+
+			return memory;
+		}
+	}
+}
+
+cppcoro::net::recv_buffer_lease::recv_buffer_lease() noexcept
+	: m_pool(nullptr)
+	, m_bufferId(0)
+	, m_size(0)
+{}
+
+cppcoro::net::recv_buffer_lease::recv_buffer_lease(
+	recv_buffer_pool& pool,
+	std::uint16_t bufferId,
+	std::size_t size) noexcept
+	: m_pool(&pool)
+	, m_bufferId(bufferId)
+	, m_size(size)
+{}
+
+cppcoro::net::recv_buffer_lease::recv_buffer_lease(recv_buffer_lease&& other) noexcept
+	: m_pool(std::exchange(other.m_pool, nullptr))
+	, m_bufferId(other.m_bufferId)
+	, m_size(std::exchange(other.m_size, 0))
+{}
+
+cppcoro::net::recv_buffer_lease&
+cppcoro::net::recv_buffer_lease::operator=(recv_buffer_lease&& other) noexcept
+{
+	if (this != &other)
+	{
+		release();
+		m_pool = std::exchange(other.m_pool, nullptr);
+		m_bufferId = other.m_bufferId;
+		m_size = std::exchange(other.m_size, 0);
+	}
+
+	return *this;
+}
+
+cppcoro::net::recv_buffer_lease::~recv_buffer_lease()
+{
+	release();
+}
+
+const std::byte* cppcoro::net::recv_buffer_lease::data() const noexcept
+{
+	return m_pool != nullptr ? m_pool->buffer(m_bufferId) : nullptr;
+}
+
+void cppcoro::net::recv_buffer_lease::release() noexcept
+{
+	if (m_pool != nullptr)
+	{
+		std::exchange(m_pool, nullptr)->provide(m_bufferId);
+		m_size = 0;
+	}
+}
+
+cppcoro::net::recv_buffer_pool::recv_buffer_pool(
+	io_service& ioService,
+	std::uint32_t bufferCount,
+	std::size_t bufferSize)
+	: m_ioQueue(ioService.native_io_uring_queue())
+	, m_groupId(local::allocate_group_id())
+	, m_bufferCount(bufferCount)
+	, m_bufferSize(bufferSize)
+	, m_ring(nullptr)
+	, m_ringSize(bufferCount * sizeof(io_uring_buf))
+	, m_buffers(nullptr)
+	, m_buffersSize(bufferCount * bufferSize)
+	, m_ringTail(0)
+{
+	if (bufferCount == 0 || bufferCount > 32768 ||
+		(bufferCount & (bufferCount - 1)) != 0 ||
+		bufferSize == 0 || bufferSize > 0xFFFFFFFF)
+	{
+		throw std::system_error
+		{
+			EINVAL,
+			std::system_category(),
+			"Error creating receive buffer pool"
+		};
+	}
+
+	// The ring must be page-aligned, which mmap() guarantees.
+	m_ring = local::map_anonymous(m_ringSize);
+
+	try
+	{
+		m_buffers = static_cast<std::byte*>(local::map_anonymous(m_buffersSize));
+	}
+	catch (...)
+	{
+		::munmap(m_ring, m_ringSize);
+		throw;
+	}
+
+	const int result = m_ioQueue.register_buffer_ring(m_ring, m_bufferCount, m_groupId);
+	if (result < 0)
+	{
+		::munmap(m_buffers, m_buffersSize);
+		::munmap(m_ring, m_ringSize);
+		throw std::system_error
+		{
+			-result,
+			std::system_category(),
+			"Error creating receive buffer pool: io_uring_register"
+		};
+	}
+
+	for (std::uint32_t i = 0; i < m_bufferCount; ++i)
+	{
+		provide(static_cast<std::uint16_t>(i));
+	}
+}
+
+cppcoro::net::recv_buffer_pool::~recv_buffer_pool()
+{
+	(void)m_ioQueue.unregister_buffer_ring(m_groupId);
+	::munmap(m_buffers, m_buffersSize);
+	::munmap(m_ring, m_ringSize);
+}
+
+void cppcoro::net::recv_buffer_pool::provide(std::uint16_t bufferId) noexcept
+{
+	assert(bufferId < m_bufferCount);
+
+	// Don't use io_uring_buf_ring::bufs as, when compiled as C++, the empty
+	// struct that <linux/io_uring.h> uses to declare the flexible array
+	// member moves it away from the start of the ring. The tail overlays
+	// the 'resv' field of the first entry.
+	auto* entries = static_cast<io_uring_buf*>(m_ring);
+
+	std::lock_guard lock{ m_mutex };
+
+	io_uring_buf& entry = entries[m_ringTail & (m_bufferCount - 1)];
+	entry.addr = reinterpret_cast<std::uintptr_t>(buffer(bufferId));
+	entry.len = static_cast<std::uint32_t>(m_bufferSize);
+	entry.bid = bufferId;
+
+	// Publish the entry to the kernel.
+	++m_ringTail;
+	std::atomic_ref<std::uint16_t>{ entries[0].resv }.store(m_ringTail, std::memory_order_release);
+}
+
+#endif
@@ -10,8 +10,10 @@
 #include <cppcoro/net/socket_disconnect_operation.hpp>
 #include <cppcoro/net/socket_recv_operation.hpp>
 #include <cppcoro/net/socket_send_operation.hpp>
+#include <cppcoro/net/socket_send_file_operation.hpp>
 
 #include <cppcoro/io_service.hpp>
+#include <cppcoro/readable_file.hpp>
 #include <cppcoro/on_scope_exit.hpp>
 
 #include "socket_helpers.hpp"
@@ -372,6 +374,319 @@ void cppcoro::net::socket::listen(std::uint32_t backlog)
 	}
 }
 
+void cppcoro::net::socket::close_send()
+{
+	int result = ::shutdown(m_handle, SD_SEND);
+	if (result == SOCKET_ERROR)
+	{
+		int errorCode = ::WSAGetLastError();
+		throw std::system_error(
+			errorCode,
+			std::system_category(),
+			"failed to close socket send stream: shutdown(SD_SEND)");
+	}
+}
+
+void cppcoro::net::socket::close_recv()
+{
+	int result = ::shutdown(m_handle, SD_RECEIVE);
+	if (result == SOCKET_ERROR)
+	{
+		int errorCode = ::WSAGetLastError();
+		throw std::system_error(
+			errorCode,
+			std::system_category(),
+			"failed to close socket receive stream: shutdown(SD_RECEIVE)");
+	}
+}
+
+cppcoro::net::socket::socket(
+	cppcoro::detail::win32::socket_t handle,
+	bool skipCompletionOnSuccess) noexcept
+	: m_handle(handle)
+	, m_skipCompletionOnSuccess(skipCompletionOnSuccess)
+{
+}
+
+
+#elif CPPCORO_OS_LINUX
+# include <cerrno>
+# include <cstring>
+# include <system_error>
+
+# include <netinet/in.h>
+# include <netinet/udp.h>
+# include <sys/socket.h>
+# include <unistd.h>
+
+namespace
+{
+	namespace local
+	{
+		cppcoro::detail::lnx::fd_t create_socket(
+			int addressFamily,
+			int socketType,
+			int protocol)
+		{
+			const int socketHandle = ::socket(addressFamily, socketType | SOCK_CLOEXEC, protocol);
+			if (socketHandle == -1)
+			{
+				throw std::system_error(
+					errno,
+					std::system_category(),
+					"Error creating socket: socket");
+			}
+
+			return socketHandle;
+		}
+	}
+}
+
+cppcoro::net::socket cppcoro::net::socket::create_tcpv4(io_service& ioSvc)
+{
+	socket result(local::create_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP), ioSvc);
+	result.m_localEndPoint = ipv4_endpoint();
+	result.m_remoteEndPoint = ipv4_endpoint();
+	return result;
+}
+
+cppcoro::net::socket cppcoro::net::socket::create_tcpv6(io_service& ioSvc)
+{
+	socket result(local::create_socket(AF_INET6, SOCK_STREAM, IPPROTO_TCP), ioSvc);
+	result.m_localEndPoint = ipv6_endpoint();
+	result.m_remoteEndPoint = ipv6_endpoint();
+	return result;
+}
+
+cppcoro::net::socket cppcoro::net::socket::create_udpv4(io_service& ioSvc)
+{
+	socket result(local::create_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP), ioSvc);
+	result.m_localEndPoint = ipv4_endpoint();
+	result.m_remoteEndPoint = ipv4_endpoint();
+	return result;
+}
+
+cppcoro::net::socket cppcoro::net::socket::create_udpv6(io_service& ioSvc)
+{
+	socket result(local::create_socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP), ioSvc);
+	result.m_localEndPoint = ipv6_endpoint();
+	result.m_remoteEndPoint = ipv6_endpoint();
+	return result;
+}
+
+cppcoro::net::socket cppcoro::net::socket::create_unix_stream(io_service& ioSvc)
+{
+	return socket(local::create_socket(AF_UNIX, SOCK_STREAM, 0), ioSvc);
+}
+
+cppcoro::net::socket cppcoro::net::socket::create_unix_datagram(io_service& ioSvc)
+{
+	return socket(local::create_socket(AF_UNIX, SOCK_DGRAM, 0), ioSvc);
+}
+
+cppcoro::net::socket cppcoro::net::socket::create_unix_seqpacket(io_service& ioSvc)
+{
+	return socket(local::create_socket(AF_UNIX, SOCK_SEQPACKET, 0), ioSvc);
+}
+
+cppcoro::net::socket::socket(socket&& other) noexcept
+	: m_handle(std::exchange(other.m_handle, -1))
+	, m_ioService(other.m_ioService)
+	, m_localEndPoint(std::move(other.m_localEndPoint))
+	, m_remoteEndPoint(std::move(other.m_remoteEndPoint))
+{}
+
+cppcoro::net::socket::~socket()
+{
+	if (m_handle != -1)
+	{
+		::close(m_handle);
+	}
+}
+
+cppcoro::net::socket&
+cppcoro::net::socket::operator=(socket&& other) noexcept
+{
+	auto handle = std::exchange(other.m_handle, -1);
+	if (m_handle != -1)
+	{
+		::close(m_handle);
+	}
+
+	m_handle = handle;
+	m_ioService = other.m_ioService;
+	m_localEndPoint = other.m_localEndPoint;
+	m_remoteEndPoint = other.m_remoteEndPoint;
+
+	return *this;
+}
+
+cppcoro::detail::lnx::io_uring_queue& cppcoro::net::socket::io_queue() noexcept
+{
+	return m_ioService->native_io_uring_queue();
+}
+
+void cppcoro::net::socket::bind(const ip_endpoint& localEndPoint)
+{
+	sockaddr_storage sockaddrStorage;
+	const int sockaddrLength = cppcoro::net::detail::ip_endpoint_to_sockaddr(
+		localEndPoint, std::ref(sockaddrStorage));
+
+	sockaddr* address = reinterpret_cast<sockaddr*>(&sockaddrStorage);
+	int result = ::bind(m_handle, address, static_cast<socklen_t>(sockaddrLength));
+	if (result != 0)
+	{
+		throw std::system_error(
+			errno,
+			std::system_category(),
+			"Error binding to endpoint: bind()");
+	}
+
+	socklen_t boundLength = sizeof(sockaddrStorage);
+	result = ::getsockname(m_handle, address, &boundLength);
+	if (result == 0)
+	{
+		m_localEndPoint = cppcoro::net::detail::sockaddr_to_ip_endpoint(*address);
+	}
+	else
+	{
+		m_localEndPoint = localEndPoint;
+	}
+}
+
+void cppcoro::net::socket::bind(const unix_endpoint& localEndPoint)
+{
+	sockaddr_storage sockaddrStorage;
+	const int sockaddrLength = cppcoro::net::detail::unix_endpoint_to_sockaddr(
+		localEndPoint, std::ref(sockaddrStorage));
+	if (sockaddrLength < 0)
+	{
+		throw std::system_error(
+			ENAMETOOLONG,
+			std::system_category(),
+			"Error binding to endpoint: bind()");
+	}
+
+	const int result = ::bind(
+		m_handle,
+		reinterpret_cast<const sockaddr*>(&sockaddrStorage),
+		static_cast<socklen_t>(sockaddrLength));
+	if (result != 0)
+	{
+		throw std::system_error(
+			errno,
+			std::system_category(),
+			"Error binding to endpoint: bind()");
+	}
+}
+
+cppcoro::net::unix_endpoint cppcoro::net::socket::local_unix_endpoint() const
+{
+	sockaddr_storage sockaddrStorage;
+	socklen_t sockaddrLength = sizeof(sockaddrStorage);
+	const int result = ::getsockname(
+		m_handle, reinterpret_cast<sockaddr*>(&sockaddrStorage), &sockaddrLength);
+	if (result != 0)
+	{
+		throw std::system_error(
+			errno,
+			std::system_category(),
+			"Error getting local endpoint: getsockname()");
+	}
+
+	return cppcoro::net::detail::sockaddr_to_unix_endpoint(
+		*reinterpret_cast<const sockaddr*>(&sockaddrStorage), sockaddrLength);
+}
+
+cppcoro::net::unix_endpoint cppcoro::net::socket::remote_unix_endpoint() const
+{
+	sockaddr_storage sockaddrStorage;
+	socklen_t sockaddrLength = sizeof(sockaddrStorage);
+	const int result = ::getpeername(
+		m_handle, reinterpret_cast<sockaddr*>(&sockaddrStorage), &sockaddrLength);
+	if (result != 0)
+	{
+		throw std::system_error(
+			errno,
+			std::system_category(),
+			"Error getting remote endpoint: getpeername()");
+	}
+
+	return cppcoro::net::detail::sockaddr_to_unix_endpoint(
+		*reinterpret_cast<const sockaddr*>(&sockaddrStorage), sockaddrLength);
+}
+
+void cppcoro::net::socket::listen()
+{
+	listen(SOMAXCONN);
+}
+
+void cppcoro::net::socket::listen(std::uint32_t backlog)
+{
+	if (backlog > 0x7FFFFFFF)
+	{
+		backlog = 0x7FFFFFFF;
+	}
+
+	int result = ::listen(m_handle, (int)backlog);
+	if (result != 0)
+	{
+		throw std::system_error(
+			errno,
+			std::system_category(),
+			"Failed to start listening on bound endpoint: listen");
+	}
+}
+
+void cppcoro::net::socket::close_send()
+{
+	int result = ::shutdown(m_handle, SHUT_WR);
+	if (result == -1)
+	{
+		throw std::system_error(
+			errno,
+			std::system_category(),
+			"failed to close socket send stream: shutdown(SHUT_WR)");
+	}
+}
+
+void cppcoro::net::socket::close_recv()
+{
+	int result = ::shutdown(m_handle, SHUT_RD);
+	if (result == -1)
+	{
+		throw std::system_error(
+			errno,
+			std::system_category(),
+			"failed to close socket receive stream: shutdown(SHUT_RD)");
+	}
+}
+
+void cppcoro::net::socket::set_udp_gro(bool enabled)
+{
+	const int value = enabled ? 1 : 0;
+	const int result = ::setsockopt(m_handle, SOL_UDP, UDP_GRO, &value, sizeof(value));
+	if (result != 0)
+	{
+		throw std::system_error(
+			errno,
+			std::system_category(),
+			"failed to set UDP_GRO socket option: setsockopt");
+	}
+}
+
+cppcoro::net::socket::socket(
+	cppcoro::detail::lnx::fd_t handle,
+	io_service& ioService) noexcept
+	: m_handle(handle)
+	, m_ioService(&ioService)
+{
+}
+
+#endif
+
+#if CPPCORO_OS_WINNT || CPPCORO_OS_LINUX
+
 cppcoro::net::socket_accept_operation
 cppcoro::net::socket::accept(socket& acceptingSocket) noexcept
 {
@@ -420,6 +735,30 @@ cppcoro::net::socket::send(const void* buffer, std::size_t byteCount, cancellati
 	return socket_send_operation_cancellable{ *this, buffer, byteCount, std::move(ct) };
 }
 
+cppcoro::net::socket_send_vectored_operation
+cppcoro::net::socket::send(std::span<const const_buffer> buffers) noexcept
+{
+	return socket_send_vectored_operation{ *this, buffers };
+}
+
+cppcoro::net::socket_send_vectored_operation_cancellable
+cppcoro::net::socket::send(std::span<const const_buffer> buffers, cancellation_token ct) noexcept
+{
+	return socket_send_vectored_operation_cancellable{ *this, buffers, std::move(ct) };
+}
+
+cppcoro::net::socket_send_file_operation
+cppcoro::net::socket::send_file(readable_file& file, std::uint64_t offset, std::size_t byteCount) noexcept
+{
+	return socket_send_file_operation{ *this, file.native_handle(), offset, byteCount };
+}
+
+cppcoro::net::socket_send_file_operation_cancellable
+cppcoro::net::socket::send_file(readable_file& file, std::uint64_t offset, std::size_t byteCount, cancellation_token ct) noexcept
+{
+	return socket_send_file_operation_cancellable{ *this, file.native_handle(), offset, byteCount, std::move(ct) };
+}
+
 cppcoro::net::socket_recv_operation
 cppcoro::net::socket::recv(void* buffer, std::size_t byteCount) noexcept
 {
@@ -432,6 +771,18 @@ cppcoro::net::socket::recv(void* buffer, std::size_t byteCount, cancellation_tok
 	return socket_recv_operation_cancellable{ *this, buffer, byteCount, std::move(ct) };
 }
 
+cppcoro::net::socket_recv_vectored_operation
+cppcoro::net::socket::recv(std::span<const mutable_buffer> buffers) noexcept
+{
+	return socket_recv_vectored_operation{ *this, buffers };
+}
+
+cppcoro::net::socket_recv_vectored_operation_cancellable
+cppcoro::net::socket::recv(std::span<const mutable_buffer> buffers, cancellation_token ct) noexcept
+{
+	return socket_recv_vectored_operation_cancellable{ *this, buffers, std::move(ct) };
+}
+
 cppcoro::net::socket_recv_from_operation
 cppcoro::net::socket::recv_from(void* buffer, std::size_t byteCount) noexcept
 {
@@ -456,38 +807,132 @@ cppcoro::net::socket::send_to(const ip_endpoint& destination, const void* buffer
 	return socket_send_to_operation_cancellable{ *this, destination, buffer, byteCount, std::move(ct) };
 }
 
-void cppcoro::net::socket::close_send()
+#if CPPCORO_OS_LINUX
+cppcoro::net::socket_connect_operation
+cppcoro::net::socket::connect(const unix_endpoint& remoteEndPoint) noexcept
 {
-	int result = ::shutdown(m_handle, SD_SEND);
-	if (result == SOCKET_ERROR)
-	{
-		int errorCode = ::WSAGetLastError();
-		throw std::system_error(
-			errorCode,
-			std::system_category(),
-			"failed to close socket send stream: shutdown(SD_SEND)");
-	}
+	return socket_connect_operation{ *this, remoteEndPoint };
 }
 
-void cppcoro::net::socket::close_recv()
+cppcoro::net::socket_connect_operation_cancellable
+cppcoro::net::socket::connect(const unix_endpoint& remoteEndPoint, cancellation_token ct) noexcept
 {
-	int result = ::shutdown(m_handle, SD_RECEIVE);
-	if (result == SOCKET_ERROR)
-	{
-		int errorCode = ::WSAGetLastError();
-		throw std::system_error(
-			errorCode,
-			std::system_category(),
-			"failed to close socket receive stream: shutdown(SD_RECEIVE)");
-	}
+	return socket_connect_operation_cancellable{ *this, remoteEndPoint, std::move(ct) };
 }
 
-cppcoro::net::socket::socket(
-	cppcoro::detail::win32::socket_t handle,
-	bool skipCompletionOnSuccess) noexcept
-	: m_handle(handle)
-	, m_skipCompletionOnSuccess(skipCompletionOnSuccess)
+cppcoro::net::socket_recv_from_many_operation
+cppcoro::net::socket::recv_from_many(std::span<datagram_buffer> buffers) noexcept
+{
+	return socket_recv_from_many_operation{ *this, buffers };
+}
+
+cppcoro::net::socket_recv_from_many_operation_cancellable
+cppcoro::net::socket::recv_from_many(std::span<datagram_buffer> buffers, cancellation_token ct) noexcept
+{
+	return socket_recv_from_many_operation_cancellable{ *this, buffers, std::move(ct) };
+}
+
+cppcoro::net::socket_send_to_many_operation
+cppcoro::net::socket::send_to_many(std::span<const datagram> datagrams) noexcept
+{
+	return socket_send_to_many_operation{ *this, datagrams };
+}
+
+cppcoro::net::socket_send_to_many_operation_cancellable
+cppcoro::net::socket::send_to_many(std::span<const datagram> datagrams, cancellation_token ct) noexcept
 {
+	return socket_send_to_many_operation_cancellable{ *this, datagrams, std::move(ct) };
 }
 
+cppcoro::net::socket_send_to_operation
+cppcoro::net::socket::send_to_segmented(
+	const ip_endpoint& destination,
+	const void* buffer,
+	std::size_t byteCount,
+	std::uint16_t segmentSize) noexcept
+{
+	return socket_send_to_operation{ *this, destination, buffer, byteCount, segmentSize };
+}
+
+cppcoro::net::socket_send_to_operation_cancellable
+cppcoro::net::socket::send_to_segmented(
+	const ip_endpoint& destination,
+	const void* buffer,
+	std::size_t byteCount,
+	std::uint16_t segmentSize,
+	cancellation_token ct) noexcept
+{
+	return socket_send_to_operation_cancellable{
+		*this, destination, buffer, byteCount, std::move(ct), segmentSize };
+}
+
+cppcoro::net::socket_recv_from_segmented_operation
+cppcoro::net::socket::recv_from_segmented(void* buffer, std::size_t byteCount) noexcept
+{
+	return socket_recv_from_segmented_operation{ *this, buffer, byteCount };
+}
+
+cppcoro::net::socket_recv_from_segmented_operation_cancellable
+cppcoro::net::socket::recv_from_segmented(void* buffer, std::size_t byteCount, cancellation_token ct) noexcept
+{
+	return socket_recv_from_segmented_operation_cancellable{ *this, buffer, byteCount, std::move(ct) };
+}
+
+cppcoro::net::socket_recv_pooled_operation
+cppcoro::net::socket::recv(recv_buffer_pool& pool) noexcept
+{
+	return socket_recv_pooled_operation{ *this, pool };
+}
+
+cppcoro::net::socket_recv_pooled_operation_cancellable
+cppcoro::net::socket::recv(recv_buffer_pool& pool, cancellation_token ct) noexcept
+{
+	return socket_recv_pooled_operation_cancellable{ *this, pool, std::move(ct) };
+}
+
+cppcoro::net::socket_send_zero_copy_operation
+cppcoro::net::socket::send_zero_copy(const void* buffer, std::size_t byteCount) noexcept
+{
+	return socket_send_zero_copy_operation{ *this, buffer, byteCount };
+}
+
+cppcoro::net::socket_send_zero_copy_operation_cancellable
+cppcoro::net::socket::send_zero_copy(const void* buffer, std::size_t byteCount, cancellation_token ct) noexcept
+{
+	return socket_send_zero_copy_operation_cancellable{ *this, buffer, byteCount, std::move(ct) };
+}
+
+cppcoro::net::socket_send_fds_operation
+cppcoro::net::socket::send_fds(const void* buffer, std::size_t byteCount, std::span<const int> fds) noexcept
+{
+	return socket_send_fds_operation{ *this, buffer, byteCount, fds };
+}
+
+cppcoro::net::socket_send_fds_operation_cancellable
+cppcoro::net::socket::send_fds(
+	const void* buffer,
+	std::size_t byteCount,
+	std::span<const int> fds,
+	cancellation_token ct) noexcept
+{
+	return socket_send_fds_operation_cancellable{ *this, buffer, byteCount, fds, std::move(ct) };
+}
+
+cppcoro::net::socket_recv_fds_operation
+cppcoro::net::socket::recv_fds(void* buffer, std::size_t byteCount, std::span<int> fds) noexcept
+{
+	return socket_recv_fds_operation{ *this, buffer, byteCount, fds };
+}
+
+cppcoro::net::socket_recv_fds_operation_cancellable
+cppcoro::net::socket::recv_fds(
+	void* buffer,
+	std::size_t byteCount,
+	std::span<int> fds,
+	cancellation_token ct) noexcept
+{
+	return socket_recv_fds_operation_cancellable{ *this, buffer, byteCount, fds, std::move(ct) };
+}
+#endif
+
 #endif
@@ -126,4 +126,77 @@ void cppcoro::net::socket_accept_operation_impl::get_result(
 	}
 }
 
+#elif CPPCORO_OS_LINUX
+# include <linux/io_uring.h>
+# include <sys/socket.h>
+# include <unistd.h>
+
+bool cppcoro::net::socket_accept_operation_impl::try_start(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	m_remoteAddressLength = sizeof(m_remoteAddress);
+
+	const int result = m_listeningSocket.io_queue().submit([&](io_uring_sqe& sqe)
+	{
+		sqe.opcode = IORING_OP_ACCEPT;
+		sqe.fd = m_listeningSocket.native_handle();
+		sqe.addr = reinterpret_cast<std::uintptr_t>(&m_remoteAddress);
+		sqe.addr2 = reinterpret_cast<std::uintptr_t>(&m_remoteAddressLength);
+		sqe.accept_flags = SOCK_CLOEXEC;
+		sqe.user_data = operation.get_user_data();
+	});
+	if (result < 0)
+	{
+		operation.m_result = result;
+		return false;
+	}
+
+	return true;
+}
+
+void cppcoro::net::socket_accept_operation_impl::cancel(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	m_listeningSocket.io_queue().cancel(operation.get_user_data());
+}
+
+void cppcoro::net::socket_accept_operation_impl::get_result(
+	cppcoro::detail::io_uring_operation_base& operation)
+{
+	if (operation.m_result < 0)
+	{
+		throw std::system_error{
+			-operation.m_result,
+			std::system_category(),
+			"Accepting a connection failed: accept"
+		};
+	}
+
+	// Unlike AcceptEx(), accept() creates the socket for the connection
+	// so it replaces the socket that was created up-front by the caller.
+	if (m_acceptingSocket.m_handle != -1)
+	{
+		::close(m_acceptingSocket.m_handle);
+	}
+	m_acceptingSocket.m_handle = operation.m_result;
+
+	m_acceptingSocket.m_remoteEndPoint =
+		detail::sockaddr_to_ip_endpoint(*reinterpret_cast<const sockaddr*>(&m_remoteAddress));
+
+	sockaddr_storage localAddress;
+	socklen_t localAddressLength = sizeof(localAddress);
+	if (::getsockname(
+		m_acceptingSocket.m_handle,
+		reinterpret_cast<sockaddr*>(&localAddress),
+		&localAddressLength) == 0)
+	{
+		m_acceptingSocket.m_localEndPoint =
+			detail::sockaddr_to_ip_endpoint(*reinterpret_cast<const sockaddr*>(&localAddress));
+	}
+	else
+	{
+		m_acceptingSocket.m_localEndPoint = m_listeningSocket.m_localEndPoint;
+	}
+}
+
 #endif
@@ -0,0 +1,370 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/net/socket.hpp>
+
+#include <cppcoro/io_service.hpp>
+#include <cppcoro/on_scope_exit.hpp>
+#include <cppcoro/operation_cancelled.hpp>
+
+#if CPPCORO_OS_LINUX
+# include <cppcoro/cancellation_registration.hpp>
+# include <cppcoro/coroutine.hpp>
+
+# include "socket_helpers.hpp"
+
+# include <cerrno>
+# include <cstddef>
+# include <deque>
+# include <mutex>
+# include <system_error>
+# include <utility>
+
+# include <linux/io_uring.h>
+# include <sys/socket.h>
+# include <unistd.h>
+
+namespace
+{
+	namespace local
+	{
+		/// The number of queued completions at which a multishot accept stops
+		/// accepting, leaving further connections in the listen backlog.
+		constexpr std::size_t max_queued_accepts = 64;
+
+		/// State of a multishot accept, which completes once for each accepted
+		/// connection until it is cancelled or fails.
+		///
+		/// Completions are queued until the accept_stream() generator asks for
+		/// them. Once max_queued_accepts are queued the accept is cancelled,
+		/// so that the listen backlog applies backpressure again, and the
+		/// generator re-arms it after it has drained the queue.
+		///
+		/// If the generator is destroyed while the accept is still armed
+		/// then the state is abandoned: it cancels the accept and deletes
+		/// itself on the final completion, closing any connections accepted
+		/// in the meantime.
+		class multishot_accept_state : public cppcoro::detail::lnx::io_state
+		{
+		public:
+
+			multishot_accept_state(
+				cppcoro::detail::lnx::io_uring_queue& ioQueue,
+				cppcoro::detail::lnx::fd_t listeningSocket) noexcept
+				: io_state(&multishot_accept_state::on_completion)
+				, m_ioQueue(ioQueue)
+				, m_listeningSocket(listeningSocket)
+			{}
+
+			~multishot_accept_state()
+			{
+				for (const std::int32_t result : m_results)
+				{
+					if (result >= 0)
+					{
+						::close(result);
+					}
+				}
+			}
+
+			/// Submit the multishot accept.
+			///
+			/// \return
+			/// Zero on success or a negative errno value if the submission failed.
+			int arm() noexcept
+			{
+				std::lock_guard lock{ m_mutex };
+				m_armed = true;
+				m_paused = false;
+
+				const int result = m_ioQueue.submit([&](io_uring_sqe& sqe)
+				{
+					sqe.opcode = IORING_OP_ACCEPT;
+					sqe.fd = m_listeningSocket;
+					sqe.ioprio = IORING_ACCEPT_MULTISHOT;
+					sqe.accept_flags = SOCK_CLOEXEC;
+					sqe.user_data = user_data();
+				});
+				if (result < 0)
+				{
+					m_armed = false;
+				}
+
+				return result;
+			}
+
+			/// Request that the accept stop, if it is armed.
+			void cancel() noexcept
+			{
+				std::lock_guard lock{ m_mutex };
+				if (m_armed)
+				{
+					m_ioQueue.cancel(user_data());
+				}
+			}
+
+			/// Take the oldest queued completion, if there is one.
+			///
+			/// \param armed
+			/// Set to whether the accept is still armed.
+			bool try_dequeue(std::int32_t& result, bool& armed) noexcept
+			{
+				std::lock_guard lock{ m_mutex };
+				armed = m_armed;
+				if (m_results.empty())
+				{
+					return false;
+				}
+
+				result = m_results.front();
+				m_results.pop_front();
+				return true;
+			}
+
+			/// Wait until there is a completion queued or the accept is no longer armed.
+			auto operator co_await() noexcept
+			{
+				class awaiter
+				{
+				public:
+
+					explicit awaiter(multishot_accept_state& state) noexcept
+						: m_state(state)
+					{}
+
+					bool await_ready() const noexcept { return false; }
+
+					bool await_suspend(cppcoro::coroutine_handle<> awaitingCoroutine) noexcept
+					{
+						std::lock_guard lock{ m_state.m_mutex };
+						if (!m_state.m_results.empty() || !m_state.m_armed)
+						{
+							return false;
+						}
+
+						m_state.m_awaitingCoroutine = awaitingCoroutine;
+						return true;
+					}
+
+					void await_resume() const noexcept {}
+
+				private:
+
+					multishot_accept_state& m_state;
+
+				};
+
+				return awaiter{ *this };
+			}
+
+			/// Called by the generator instead of deleting the state.
+			void abandon() noexcept
+			{
+				{
+					std::lock_guard lock{ m_mutex };
+					if (m_armed)
+					{
+						// Must cancel while holding the lock so that the final
+						// completion can't delete the state before we're done.
+						m_abandoned = true;
+						m_ioQueue.cancel(user_data());
+						return;
+					}
+				}
+
+				delete this;
+			}
+
+		private:
+
+			std::uint64_t user_data() noexcept
+			{
+				return reinterpret_cast<std::uintptr_t>(static_cast<io_state*>(this));
+			}
+
+			static void on_completion(
+				cppcoro::detail::lnx::io_state* ioState,
+				std::int32_t result,
+				std::uint32_t flags) noexcept
+			{
+				auto* state = static_cast<multishot_accept_state*>(ioState);
+
+				std::unique_lock lock{ state->m_mutex };
+				if ((flags & IORING_CQE_F_MORE) == 0)
+				{
+					state->m_armed = false;
+				}
+
+				if (state->m_abandoned)
+				{
+					if (result >= 0)
+					{
+						::close(result);
+					}
+
+					if (!state->m_armed)
+					{
+						lock.unlock();
+						delete state;
+					}
+
+					return;
+				}
+
+				// The cancellation we requested when the queue filled up isn't
+				// an error. If the stream's cancellation token was also
+				// triggered then the generator will notice that itself.
+				if (!(state->m_paused && result == -ECANCELED))
+				{
+					state->m_results.push_back(result);
+				}
+
+				if (state->m_armed &&
+					!state->m_paused &&
+					state->m_results.size() >= max_queued_accepts)
+				{
+					state->m_paused = true;
+					state->m_ioQueue.cancel(state->user_data());
+				}
+
+				// Also wake the generator if the accept has stopped with nothing
+				// queued, so that it can re-arm it.
+				auto awaitingCoroutine = std::exchange(state->m_awaitingCoroutine, {});
+				lock.unlock();
+
+				if (awaitingCoroutine)
+				{
+					awaitingCoroutine.resume();
+				}
+			}
+
+			cppcoro::detail::lnx::io_uring_queue& m_ioQueue;
+			const cppcoro::detail::lnx::fd_t m_listeningSocket;
+
+			std::mutex m_mutex;
+			std::deque<std::int32_t> m_results;
+			cppcoro::coroutine_handle<> m_awaitingCoroutine;
+			bool m_armed = false;
+			bool m_paused = false;
+			bool m_abandoned = false;
+		};
+	}
+}
+
+cppcoro::async_generator<cppcoro::net::socket>
+cppcoro::net::socket::accept_stream(io_service& ioSvc, cancellation_token ct)
+{
+	bool acceptedAny = false;
+
+	{
+		auto* state = new local::multishot_accept_state(io_queue(), m_handle);
+		auto abandonOnExit = on_scope_exit([state] { state->abandon(); });
+
+		cancellation_registration cancelOnRequest(ct, [state] { state->cancel(); });
+
+		while (true)
+		{
+			ct.throw_if_cancellation_requested();
+
+			std::int32_t result;
+			bool armed;
+			if (!state->try_dequeue(result, armed))
+			{
+				if (armed)
+				{
+					co_await *state;
+				}
+				else
+				{
+					// Either we've not started yet, we stopped the accept because
+					// too many connections were queued, or the kernel has stopped
+					// it, eg. because the completion queue overflowed.
+					const int armResult = state->arm();
+					if (armResult < 0)
+					{
+						throw std::system_error{
+							-armResult,
+							std::system_category(),
+							"Accepting a connection failed: io_uring_enter"
+						};
+					}
+				}
+
+				continue;
+			}
+
+			if (result < 0)
+			{
+				if (result == -ECANCELED && ct.is_cancellation_requested())
+				{
+					throw operation_cancelled{};
+				}
+
+				if (result == -EINVAL && !acceptedAny)
+				{
+					// The kernel doesn't support multishot accept.
+					break;
+				}
+
+				throw std::system_error{
+					-result,
+					std::system_category(),
+					"Accepting a connection failed: accept"
+				};
+			}
+
+			acceptedAny = true;
+
+			socket acceptedSocket(result, ioSvc);
+
+			sockaddr_storage address;
+			socklen_t addressLength = sizeof(address);
+			if (::getsockname(result, reinterpret_cast<sockaddr*>(&address), &addressLength) == 0)
+			{
+				acceptedSocket.m_localEndPoint = detail::sockaddr_to_ip_endpoint(
+					*reinterpret_cast<const sockaddr*>(&address));
+			}
+			else
+			{
+				acceptedSocket.m_localEndPoint = m_localEndPoint;
+			}
+
+			addressLength = sizeof(address);
+			if (::getpeername(result, reinterpret_cast<sockaddr*>(&address), &addressLength) == 0)
+			{
+				acceptedSocket.m_remoteEndPoint = detail::sockaddr_to_ip_endpoint(
+					*reinterpret_cast<const sockaddr*>(&address));
+			}
+
+			co_yield std::move(acceptedSocket);
+		}
+	}
+
+	while (true)
+	{
+		auto acceptingSocket = m_localEndPoint.is_ipv4() ?
+			socket::create_tcpv4(ioSvc) : socket::create_tcpv6(ioSvc);
+		co_await accept(acceptingSocket, ct);
+		co_yield std::move(acceptingSocket);
+	}
+}
+
+#elif CPPCORO_OS_WINNT
+
+cppcoro::async_generator<cppcoro::net::socket>
+cppcoro::net::socket::accept_stream(io_service& ioSvc, cancellation_token ct)
+{
+	// AcceptEx() has no equivalent of a multishot accept so just keep
+	// a single accept outstanding at a time.
+	while (true)
+	{
+		auto acceptingSocket = m_localEndPoint.is_ipv4() ?
+			socket::create_tcpv4(ioSvc) : socket::create_tcpv6(ioSvc);
+		co_await accept(acceptingSocket, ct);
+		co_yield std::move(acceptingSocket);
+	}
+}
+
+#endif
@@ -175,4 +175,110 @@ void cppcoro::net::socket_connect_operation_impl::get_result(
 	}
 }
 
+#elif CPPCORO_OS_LINUX
+# include <cerrno>
+
+# include <linux/io_uring.h>
+# include <sys/socket.h>
+
+cppcoro::net::socket_connect_operation_impl::socket_connect_operation_impl(
+	socket& socket,
+	const unix_endpoint& remoteEndPoint) noexcept
+	: m_socket(socket)
+	, m_remoteEndPoint()
+	, m_remoteAddressLength(cppcoro::net::detail::unix_endpoint_to_sockaddr(
+		remoteEndPoint,
+		std::ref(*reinterpret_cast<sockaddr_storage*>(&m_remoteAddress))))
+{
+}
+
+bool cppcoro::net::socket_connect_operation_impl::try_start(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	if (m_remoteAddressLength == 0)
+	{
+		m_remoteAddressLength = cppcoro::net::detail::ip_endpoint_to_sockaddr(
+			m_remoteEndPoint,
+			std::ref(*reinterpret_cast<sockaddr_storage*>(&m_remoteAddress)));
+	}
+	else if (m_remoteAddressLength < 0)
+	{
+		operation.m_result = -ENAMETOOLONG;
+		return false;
+	}
+
+	const int result = m_socket.io_queue().submit([&](io_uring_sqe& sqe)
+	{
+		sqe.opcode = IORING_OP_CONNECT;
+		sqe.fd = m_socket.native_handle();
+		sqe.addr = reinterpret_cast<std::uintptr_t>(&m_remoteAddress);
+		sqe.off = static_cast<std::uint64_t>(m_remoteAddressLength);
+		sqe.user_data = operation.get_user_data();
+	});
+	if (result < 0)
+	{
+		// Failed synchronously.
+		operation.m_result = result;
+		return false;
+	}
+
+	return true;
+}
+
+void cppcoro::net::socket_connect_operation_impl::cancel(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	m_socket.io_queue().cancel(operation.get_user_data());
+}
+
+void cppcoro::net::socket_connect_operation_impl::get_result(
+	cppcoro::detail::io_uring_operation_base& operation)
+{
+	if (operation.m_result < 0)
+	{
+		if (operation.m_result == -ECANCELED)
+		{
+			throw operation_cancelled{};
+		}
+
+		throw std::system_error{
+			-operation.m_result,
+			std::system_category(),
+			"Connect operation failed: connect"
+		};
+	}
+
+	{
+		sockaddr_storage localSockaddr;
+		socklen_t nameLength = sizeof(localSockaddr);
+		const int result = ::getsockname(
+			m_socket.native_handle(),
+			reinterpret_cast<sockaddr*>(&localSockaddr),
+			&nameLength);
+		if (result == 0)
+		{
+			m_socket.m_localEndPoint = cppcoro::net::detail::sockaddr_to_ip_endpoint(
+				*reinterpret_cast<const sockaddr*>(&localSockaddr));
+		}
+	}
+
+	{
+		sockaddr_storage remoteSockaddr;
+		socklen_t nameLength = sizeof(remoteSockaddr);
+		const int result = ::getpeername(
+			m_socket.native_handle(),
+			reinterpret_cast<sockaddr*>(&remoteSockaddr),
+			&nameLength);
+		if (result == 0)
+		{
+			m_socket.m_remoteEndPoint = cppcoro::net::detail::sockaddr_to_ip_endpoint(
+				*reinterpret_cast<const sockaddr*>(&remoteSockaddr));
+		}
+		else
+		{
+			m_socket.m_remoteEndPoint = m_remoteEndPoint;
+		}
+	}
+}
+
 #endif
@@ -104,4 +104,41 @@ void cppcoro::net::socket_disconnect_operation_impl::get_result(
 	}
 }
 
+#elif CPPCORO_OS_LINUX
+# include <cerrno>
+
+# include <sys/socket.h>
+
+bool cppcoro::net::socket_disconnect_operation_impl::try_start(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	// shutdown() doesn't block, so there is no need to submit it to the
+	// io_uring. It just queues a FIN after any data that is still to be sent.
+	const int result = ::shutdown(m_socket.native_handle(), SHUT_RDWR);
+
+	// ENOTCONN means that both ends have already shut down the connection.
+	operation.m_result = (result == 0 || errno == ENOTCONN) ? 0 : -errno;
+
+	return false;
+}
+
+void cppcoro::net::socket_disconnect_operation_impl::cancel(
+	cppcoro::detail::io_uring_operation_base&) noexcept
+{
+	// The operation always completes synchronously.
+}
+
+void cppcoro::net::socket_disconnect_operation_impl::get_result(
+	cppcoro::detail::io_uring_operation_base& operation)
+{
+	if (operation.m_result < 0)
+	{
+		throw std::system_error{
+			-operation.m_result,
+			std::system_category(),
+			"Disconnect operation failed: shutdown"
+		};
+	}
+}
+
 #endif
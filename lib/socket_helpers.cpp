@@ -82,4 +82,163 @@ int cppcoro::net::detail::ip_endpoint_to_sockaddr(
 	}
 }
 
-#endif // CPPCORO_OS_WINNT
+#elif CPPCORO_OS_LINUX
+#include <cstring>
+#include <cassert>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+
+#include <cppcoro/detail/linux.hpp>
+#include <cppcoro/net/unix_endpoint.hpp>
+
+#include <algorithm>
+#include <cstddef>
+
+// The socket operations store these in place of the system types so check
+// that they really can be used interchangeably.
+static_assert(sizeof(cppcoro::detail::lnx::iovec_t) == sizeof(::iovec));
+static_assert(offsetof(cppcoro::detail::lnx::iovec_t, iov_len) == offsetof(::iovec, iov_len));
+static_assert(sizeof(cppcoro::detail::lnx::msghdr_t) == sizeof(::msghdr));
+static_assert(offsetof(cppcoro::detail::lnx::msghdr_t, msg_namelen) == offsetof(::msghdr, msg_namelen));
+static_assert(offsetof(cppcoro::detail::lnx::msghdr_t, msg_iov) == offsetof(::msghdr, msg_iov));
+static_assert(offsetof(cppcoro::detail::lnx::msghdr_t, msg_iovlen) == offsetof(::msghdr, msg_iovlen));
+static_assert(offsetof(cppcoro::detail::lnx::msghdr_t, msg_control) == offsetof(::msghdr, msg_control));
+static_assert(offsetof(cppcoro::detail::lnx::msghdr_t, msg_controllen) == offsetof(::msghdr, msg_controllen));
+static_assert(offsetof(cppcoro::detail::lnx::msghdr_t, msg_flags) == offsetof(::msghdr, msg_flags));
+static_assert(sizeof(cppcoro::detail::lnx::mmsghdr_t) == sizeof(::mmsghdr));
+static_assert(offsetof(cppcoro::detail::lnx::mmsghdr_t, msg_len) == offsetof(::mmsghdr, msg_len));
+static_assert(sizeof(cppcoro::detail::lnx::sockaddr_storage_t) >= sizeof(::sockaddr_storage));
+static_assert(alignof(cppcoro::detail::lnx::sockaddr_storage_t) >= alignof(::sockaddr_storage));
+
+cppcoro::net::ip_endpoint
+cppcoro::net::detail::sockaddr_to_ip_endpoint(const sockaddr& address) noexcept
+{
+	if (address.sa_family == AF_INET)
+	{
+		sockaddr_in ipv4Address;
+		std::memcpy(&ipv4Address, &address, sizeof(ipv4Address));
+
+		std::uint8_t addressBytes[4];
+		std::memcpy(addressBytes, &ipv4Address.sin_addr, 4);
+
+		return ipv4_endpoint{
+			ipv4_address{ addressBytes },
+			ntohs(ipv4Address.sin_port)
+		};
+	}
+	else if (address.sa_family == AF_INET6)
+	{
+		sockaddr_in6 ipv6Address;
+		std::memcpy(&ipv6Address, &address, sizeof(ipv6Address));
+
+		return ipv6_endpoint{
+			ipv6_address{ ipv6Address.sin6_addr.s6_addr },
+			ntohs(ipv6Address.sin6_port)
+		};
+	}
+	else
+	{
+		// Unix domain sockets have no IP end-points.
+		assert(address.sa_family == AF_UNIX);
+		return ip_endpoint{};
+	}
+}
+
+int cppcoro::net::detail::ip_endpoint_to_sockaddr(
+	const ip_endpoint& endPoint,
+	std::reference_wrapper<sockaddr_storage> address) noexcept
+{
+	if (endPoint.is_ipv4())
+	{
+		const auto& ipv4EndPoint = endPoint.to_ipv4();
+
+		sockaddr_in ipv4Address;
+		std::memset(&ipv4Address, 0, sizeof(ipv4Address));
+		ipv4Address.sin_family = AF_INET;
+		std::memcpy(&ipv4Address.sin_addr, ipv4EndPoint.address().bytes(), 4);
+		ipv4Address.sin_port = htons(ipv4EndPoint.port());
+
+		std::memcpy(&address.get(), &ipv4Address, sizeof(ipv4Address));
+
+		return sizeof(sockaddr_in);
+	}
+	else
+	{
+		const auto& ipv6EndPoint = endPoint.to_ipv6();
+
+		sockaddr_in6 ipv6Address;
+		std::memset(&ipv6Address, 0, sizeof(ipv6Address));
+		ipv6Address.sin6_family = AF_INET6;
+		std::memcpy(&ipv6Address.sin6_addr, ipv6EndPoint.address().bytes(), 16);
+		ipv6Address.sin6_port = htons(ipv6EndPoint.port());
+
+		std::memcpy(&address.get(), &ipv6Address, sizeof(ipv6Address));
+
+		return sizeof(sockaddr_in6);
+	}
+}
+
+cppcoro::net::unix_endpoint
+cppcoro::net::detail::sockaddr_to_unix_endpoint(
+	const sockaddr& address,
+	std::uint32_t length)
+{
+	assert(address.sa_family == AF_UNIX);
+
+	const auto& unixAddress = reinterpret_cast<const sockaddr_un&>(address);
+	const std::size_t pathOffset = offsetof(sockaddr_un, sun_path);
+	if (length <= pathOffset)
+	{
+		return unix_endpoint{};
+	}
+
+	const std::size_t pathLength = std::min<std::size_t>(
+		length - pathOffset, sizeof(unixAddress.sun_path));
+	if (unixAddress.sun_path[0] == '\0')
+	{
+		// Abstract names are not null-terminated; the length says where they end.
+		return unix_endpoint{ std::string(unixAddress.sun_path, pathLength) };
+	}
+
+	return unix_endpoint{ std::string(unixAddress.sun_path, ::strnlen(unixAddress.sun_path, pathLength)) };
+}
+
+int cppcoro::net::detail::unix_endpoint_to_sockaddr(
+	const unix_endpoint& endPoint,
+	std::reference_wrapper<sockaddr_storage> address) noexcept
+{
+	static_assert(unix_endpoint::max_path_length + 1 == sizeof(sockaddr_un::sun_path));
+
+	const std::string& path = endPoint.path();
+
+	// A path in the filesystem needs room for its null terminator whereas the
+	// length of an abstract name is given by the length of the address.
+	const std::size_t maxLength = endPoint.is_abstract()
+		? sizeof(sockaddr_un::sun_path)
+		: unix_endpoint::max_path_length;
+	if (path.size() > maxLength)
+	{
+		return -1;
+	}
+
+	sockaddr_un unixAddress;
+	std::memset(&unixAddress, 0, sizeof(unixAddress));
+	unixAddress.sun_family = AF_UNIX;
+	std::memcpy(unixAddress.sun_path, path.data(), path.size());
+
+	std::memcpy(&address.get(), &unixAddress, sizeof(unixAddress));
+
+	std::size_t length = offsetof(sockaddr_un, sun_path) + path.size();
+	if (!endPoint.is_unnamed() && !endPoint.is_abstract())
+	{
+		++length;
+	}
+
+	return static_cast<int>(length);
+}
+
+#endif
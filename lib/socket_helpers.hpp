@@ -11,17 +11,24 @@
 # include <cppcoro/detail/win32.hpp>
 struct sockaddr;
 struct sockaddr_storage;
+#elif CPPCORO_OS_LINUX
+struct sockaddr;
+struct sockaddr_storage;
 #endif
 
+#include <cstdint>
+#include <functional>
+
 namespace cppcoro
 {
 	namespace net
 	{
 		class ip_endpoint;
+		class unix_endpoint;
 
 		namespace detail
 		{
-#if CPPCORO_OS_WINNT
+#if CPPCORO_OS_WINNT || CPPCORO_OS_LINUX
 			/// Convert a sockaddr to an IP endpoint.
 			ip_endpoint sockaddr_to_ip_endpoint(const sockaddr& address) noexcept;
 
@@ -39,6 +46,20 @@ namespace cppcoro
 				const ip_endpoint& endPoint,
 				std::reference_wrapper<sockaddr_storage> address) noexcept;
 
+#endif
+
+#if CPPCORO_OS_LINUX
+			/// Convert a sockaddr_un of the given length to a Unix domain end-point.
+			unix_endpoint sockaddr_to_unix_endpoint(const sockaddr& address, std::uint32_t length);
+
+			/// Converts a unix_endpoint to a sockaddr_un structure.
+			///
+			/// \return
+			/// The length of the sockaddr structure that was populated, or -1 if
+			/// the path of the end-point is too long to fit.
+			int unix_endpoint_to_sockaddr(
+				const unix_endpoint& endPoint,
+				std::reference_wrapper<sockaddr_storage> address) noexcept;
 #endif
 		}
 	}
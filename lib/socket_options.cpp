@@ -0,0 +1,365 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/net/socket.hpp>
+
+#include <climits>
+#include <system_error>
+
+#if CPPCORO_OS_WINNT
+# include <WinSock2.h>
+# include <WS2tcpip.h>
+# include <MSWSock.h>
+# include <Windows.h>
+
+namespace
+{
+	namespace local
+	{
+		void set_int_option(SOCKET s, int level, int name, int value, const char* description)
+		{
+			const int result = ::setsockopt(
+				s, level, name, reinterpret_cast<const char*>(&value), sizeof(value));
+			if (result == SOCKET_ERROR)
+			{
+				throw std::system_error(
+					::WSAGetLastError(),
+					std::system_category(),
+					description);
+			}
+		}
+
+		int get_int_option(SOCKET s, int level, int name, const char* description)
+		{
+			int value = 0;
+			int length = sizeof(value);
+			const int result = ::getsockopt(
+				s, level, name, reinterpret_cast<char*>(&value), &length);
+			if (result == SOCKET_ERROR)
+			{
+				throw std::system_error(
+					::WSAGetLastError(),
+					std::system_category(),
+					description);
+			}
+
+			return value;
+		}
+
+		int clamp_to_int(std::size_t value) noexcept
+		{
+			return value <= INT_MAX ? static_cast<int>(value) : INT_MAX;
+		}
+	}
+}
+
+void cppcoro::net::socket::set_tcp_no_delay(bool enabled)
+{
+	local::set_int_option(
+		m_handle, IPPROTO_TCP, TCP_NODELAY, enabled ? 1 : 0,
+		"failed to set TCP_NODELAY socket option: setsockopt");
+}
+
+bool cppcoro::net::socket::tcp_no_delay() const
+{
+	return local::get_int_option(
+		m_handle, IPPROTO_TCP, TCP_NODELAY,
+		"failed to get TCP_NODELAY socket option: getsockopt") != 0;
+}
+
+void cppcoro::net::socket::set_reuse_port(bool)
+{
+	// SO_REUSEADDR on Windows allows a socket to steal another's port
+	// rather than sharing the load between them, so don't pretend.
+	throw std::system_error(
+		std::make_error_code(std::errc::operation_not_supported),
+		"SO_REUSEPORT socket option is not supported on Windows");
+}
+
+bool cppcoro::net::socket::reuse_port() const
+{
+	return false;
+}
+
+void cppcoro::net::socket::set_receive_buffer_size(std::size_t size)
+{
+	local::set_int_option(
+		m_handle, SOL_SOCKET, SO_RCVBUF, local::clamp_to_int(size),
+		"failed to set SO_RCVBUF socket option: setsockopt");
+}
+
+std::size_t cppcoro::net::socket::receive_buffer_size() const
+{
+	return static_cast<std::size_t>(local::get_int_option(
+		m_handle, SOL_SOCKET, SO_RCVBUF,
+		"failed to get SO_RCVBUF socket option: getsockopt"));
+}
+
+void cppcoro::net::socket::set_send_buffer_size(std::size_t size)
+{
+	local::set_int_option(
+		m_handle, SOL_SOCKET, SO_SNDBUF, local::clamp_to_int(size),
+		"failed to set SO_SNDBUF socket option: setsockopt");
+}
+
+std::size_t cppcoro::net::socket::send_buffer_size() const
+{
+	return static_cast<std::size_t>(local::get_int_option(
+		m_handle, SOL_SOCKET, SO_SNDBUF,
+		"failed to get SO_SNDBUF socket option: getsockopt"));
+}
+
+void cppcoro::net::socket::set_busy_poll(std::chrono::microseconds)
+{
+}
+
+std::chrono::microseconds cppcoro::net::socket::busy_poll() const
+{
+	return std::chrono::microseconds{ 0 };
+}
+
+void cppcoro::net::socket::set_tcp_quick_ack(bool)
+{
+}
+
+bool cppcoro::net::socket::tcp_quick_ack() const
+{
+	return false;
+}
+
+void cppcoro::net::socket::set_tcp_cork(bool)
+{
+}
+
+bool cppcoro::net::socket::tcp_cork() const
+{
+	return false;
+}
+
+void cppcoro::net::socket::set_tcp_fast_open(std::uint32_t queueLength)
+{
+	local::set_int_option(
+		m_handle, IPPROTO_TCP, TCP_FASTOPEN, queueLength != 0 ? 1 : 0,
+		"failed to set TCP_FASTOPEN socket option: setsockopt");
+}
+
+bool cppcoro::net::socket::tcp_fast_open() const
+{
+	return local::get_int_option(
+		m_handle, IPPROTO_TCP, TCP_FASTOPEN,
+		"failed to get TCP_FASTOPEN socket option: getsockopt") != 0;
+}
+
+void cppcoro::net::socket::set_tcp_fast_open_connect(bool enabled)
+{
+	local::set_int_option(
+		m_handle, IPPROTO_TCP, TCP_FASTOPEN, enabled ? 1 : 0,
+		"failed to set TCP_FASTOPEN socket option: setsockopt");
+}
+
+bool cppcoro::net::socket::tcp_fast_open_connect() const
+{
+	return local::get_int_option(
+		m_handle, IPPROTO_TCP, TCP_FASTOPEN,
+		"failed to get TCP_FASTOPEN socket option: getsockopt") != 0;
+}
+
+void cppcoro::net::socket::set_incoming_cpu(int)
+{
+}
+
+int cppcoro::net::socket::incoming_cpu() const
+{
+	return -1;
+}
+
+#elif CPPCORO_OS_LINUX
+# include <cerrno>
+
+# include <netinet/in.h>
+# include <netinet/tcp.h>
+# include <sys/socket.h>
+
+namespace
+{
+	namespace local
+	{
+		void set_int_option(int fd, int level, int name, int value, const char* description)
+		{
+			const int result = ::setsockopt(fd, level, name, &value, sizeof(value));
+			if (result != 0)
+			{
+				throw std::system_error(
+					errno,
+					std::system_category(),
+					description);
+			}
+		}
+
+		int get_int_option(int fd, int level, int name, const char* description)
+		{
+			int value = 0;
+			socklen_t length = sizeof(value);
+			const int result = ::getsockopt(fd, level, name, &value, &length);
+			if (result != 0)
+			{
+				throw std::system_error(
+					errno,
+					std::system_category(),
+					description);
+			}
+
+			return value;
+		}
+
+		int clamp_to_int(std::size_t value) noexcept
+		{
+			return value <= INT_MAX ? static_cast<int>(value) : INT_MAX;
+		}
+	}
+}
+
+void cppcoro::net::socket::set_tcp_no_delay(bool enabled)
+{
+	local::set_int_option(
+		m_handle, IPPROTO_TCP, TCP_NODELAY, enabled ? 1 : 0,
+		"failed to set TCP_NODELAY socket option: setsockopt");
+}
+
+bool cppcoro::net::socket::tcp_no_delay() const
+{
+	return local::get_int_option(
+		m_handle, IPPROTO_TCP, TCP_NODELAY,
+		"failed to get TCP_NODELAY socket option: getsockopt") != 0;
+}
+
+void cppcoro::net::socket::set_reuse_port(bool enabled)
+{
+	local::set_int_option(
+		m_handle, SOL_SOCKET, SO_REUSEPORT, enabled ? 1 : 0,
+		"failed to set SO_REUSEPORT socket option: setsockopt");
+}
+
+bool cppcoro::net::socket::reuse_port() const
+{
+	return local::get_int_option(
+		m_handle, SOL_SOCKET, SO_REUSEPORT,
+		"failed to get SO_REUSEPORT socket option: getsockopt") != 0;
+}
+
+void cppcoro::net::socket::set_receive_buffer_size(std::size_t size)
+{
+	local::set_int_option(
+		m_handle, SOL_SOCKET, SO_RCVBUF, local::clamp_to_int(size),
+		"failed to set SO_RCVBUF socket option: setsockopt");
+}
+
+std::size_t cppcoro::net::socket::receive_buffer_size() const
+{
+	return static_cast<std::size_t>(local::get_int_option(
+		m_handle, SOL_SOCKET, SO_RCVBUF,
+		"failed to get SO_RCVBUF socket option: getsockopt"));
+}
+
+void cppcoro::net::socket::set_send_buffer_size(std::size_t size)
+{
+	local::set_int_option(
+		m_handle, SOL_SOCKET, SO_SNDBUF, local::clamp_to_int(size),
+		"failed to set SO_SNDBUF socket option: setsockopt");
+}
+
+std::size_t cppcoro::net::socket::send_buffer_size() const
+{
+	return static_cast<std::size_t>(local::get_int_option(
+		m_handle, SOL_SOCKET, SO_SNDBUF,
+		"failed to get SO_SNDBUF socket option: getsockopt"));
+}
+
+void cppcoro::net::socket::set_busy_poll(std::chrono::microseconds duration)
+{
+	local::set_int_option(
+		m_handle, SOL_SOCKET, SO_BUSY_POLL,
+		duration.count() <= 0 ? 0 : local::clamp_to_int(static_cast<std::size_t>(duration.count())),
+		"failed to set SO_BUSY_POLL socket option: setsockopt");
+}
+
+std::chrono::microseconds cppcoro::net::socket::busy_poll() const
+{
+	return std::chrono::microseconds{ local::get_int_option(
+		m_handle, SOL_SOCKET, SO_BUSY_POLL,
+		"failed to get SO_BUSY_POLL socket option: getsockopt") };
+}
+
+void cppcoro::net::socket::set_tcp_quick_ack(bool enabled)
+{
+	local::set_int_option(
+		m_handle, IPPROTO_TCP, TCP_QUICKACK, enabled ? 1 : 0,
+		"failed to set TCP_QUICKACK socket option: setsockopt");
+}
+
+bool cppcoro::net::socket::tcp_quick_ack() const
+{
+	return local::get_int_option(
+		m_handle, IPPROTO_TCP, TCP_QUICKACK,
+		"failed to get TCP_QUICKACK socket option: getsockopt") != 0;
+}
+
+void cppcoro::net::socket::set_tcp_cork(bool enabled)
+{
+	local::set_int_option(
+		m_handle, IPPROTO_TCP, TCP_CORK, enabled ? 1 : 0,
+		"failed to set TCP_CORK socket option: setsockopt");
+}
+
+bool cppcoro::net::socket::tcp_cork() const
+{
+	return local::get_int_option(
+		m_handle, IPPROTO_TCP, TCP_CORK,
+		"failed to get TCP_CORK socket option: getsockopt") != 0;
+}
+
+void cppcoro::net::socket::set_tcp_fast_open(std::uint32_t queueLength)
+{
+	local::set_int_option(
+		m_handle, IPPROTO_TCP, TCP_FASTOPEN, local::clamp_to_int(queueLength),
+		"failed to set TCP_FASTOPEN socket option: setsockopt");
+}
+
+bool cppcoro::net::socket::tcp_fast_open() const
+{
+	return local::get_int_option(
+		m_handle, IPPROTO_TCP, TCP_FASTOPEN,
+		"failed to get TCP_FASTOPEN socket option: getsockopt") != 0;
+}
+
+void cppcoro::net::socket::set_tcp_fast_open_connect(bool enabled)
+{
+	local::set_int_option(
+		m_handle, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, enabled ? 1 : 0,
+		"failed to set TCP_FASTOPEN_CONNECT socket option: setsockopt");
+}
+
+bool cppcoro::net::socket::tcp_fast_open_connect() const
+{
+	return local::get_int_option(
+		m_handle, IPPROTO_TCP, TCP_FASTOPEN_CONNECT,
+		"failed to get TCP_FASTOPEN_CONNECT socket option: getsockopt") != 0;
+}
+
+void cppcoro::net::socket::set_incoming_cpu(int cpu)
+{
+	local::set_int_option(
+		m_handle, SOL_SOCKET, SO_INCOMING_CPU, cpu,
+		"failed to set SO_INCOMING_CPU socket option: setsockopt");
+}
+
+int cppcoro::net::socket::incoming_cpu() const
+{
+	return local::get_int_option(
+		m_handle, SOL_SOCKET, SO_INCOMING_CPU,
+		"failed to get SO_INCOMING_CPU socket option: getsockopt");
+}
+
+#endif
@@ -0,0 +1,118 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/net/socket_recv_fds_operation.hpp>
+#include <cppcoro/net/socket.hpp>
+
+#if CPPCORO_OS_LINUX
+# include <algorithm>
+# include <cerrno>
+# include <cstring>
+# include <system_error>
+
+# include <linux/io_uring.h>
+# include <sys/socket.h>
+# include <unistd.h>
+
+bool cppcoro::net::socket_recv_fds_operation_impl::try_start(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	static_assert(
+		CMSG_SPACE(sizeof(int) * max_fds_per_message) <= sizeof(m_control),
+		"m_control is too small for max_fds_per_message");
+
+	const std::size_t maxFds = std::min(m_fds.size(), max_fds_per_message);
+
+	std::memset(&m_message, 0, sizeof(m_message));
+	m_message.msg_iov = &m_buffer;
+	m_message.msg_iovlen = 1;
+
+	// Only leave room for as many descriptors as the caller has room for.
+	// The kernel closes any more that were sent and sets MSG_CTRUNC. This is
+	// CMSG_LEN() rather than CMSG_SPACE() as the padding of the latter could
+	// fit another descriptor.
+	if (maxFds > 0)
+	{
+		m_message.msg_control = m_control;
+		m_message.msg_controllen = CMSG_LEN(maxFds * sizeof(int));
+	}
+
+	const int result = m_socket.io_queue().submit([&](io_uring_sqe& sqe)
+	{
+		sqe.opcode = IORING_OP_RECVMSG;
+		sqe.fd = m_socket.native_handle();
+		sqe.addr = reinterpret_cast<std::uintptr_t>(&m_message);
+		sqe.len = 1;
+		sqe.msg_flags = MSG_CMSG_CLOEXEC;
+		sqe.user_data = operation.get_user_data();
+	});
+	if (result < 0)
+	{
+		// Failed synchronously.
+		operation.m_result = result;
+		return false;
+	}
+
+	// Operation will complete asynchronously.
+	return true;
+}
+
+void cppcoro::net::socket_recv_fds_operation_impl::cancel(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	m_socket.io_queue().cancel(operation.get_user_data());
+}
+
+std::tuple<std::size_t, std::size_t>
+cppcoro::net::socket_recv_fds_operation_impl::get_result(
+	cppcoro::detail::io_uring_operation_base& operation)
+{
+	if (operation.m_result < 0)
+	{
+		throw std::system_error(
+			-operation.m_result,
+			std::system_category(),
+			"Error receiving message on socket: recvmsg");
+	}
+
+	std::size_t fdCount = 0;
+
+	auto* message = reinterpret_cast<msghdr*>(&m_message);
+	if (message->msg_controllen > 0)
+	{
+		for (cmsghdr* control = CMSG_FIRSTHDR(message);
+			control != nullptr;
+			control = CMSG_NXTHDR(message, control))
+		{
+			if (control->cmsg_level == SOL_SOCKET && control->cmsg_type == SCM_RIGHTS)
+			{
+				const std::size_t count = std::min(
+					(control->cmsg_len - CMSG_LEN(0)) / sizeof(int),
+					m_fds.size() - fdCount);
+				std::memcpy(m_fds.data() + fdCount, CMSG_DATA(control), count * sizeof(int));
+				fdCount += count;
+			}
+		}
+	}
+
+	if ((message->msg_flags & MSG_CTRUNC) != 0)
+	{
+		// Some of the descriptors were discarded. Close the ones that were
+		// received too rather than leaking them when reporting the error.
+		for (std::size_t i = 0; i < fdCount; ++i)
+		{
+			::close(m_fds[i]);
+		}
+
+		throw std::system_error(
+			EMSGSIZE,
+			std::system_category(),
+			"Error receiving file descriptors on socket: recvmsg");
+	}
+
+	return std::make_tuple(static_cast<std::size_t>(operation.m_result), fdCount);
+}
+
+#endif
@@ -0,0 +1,227 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/net/socket_recv_from_many_operation.hpp>
+#include <cppcoro/net/socket.hpp>
+
+#if CPPCORO_OS_LINUX
+# include "socket_helpers.hpp"
+
+# include <algorithm>
+# include <cerrno>
+# include <cstring>
+# include <mutex>
+# include <new>
+# include <system_error>
+
+# include <linux/io_uring.h>
+# include <poll.h>
+# include <sys/socket.h>
+# include <sys/uio.h>
+
+cppcoro::net::socket_recv_from_many_operation_impl::socket_recv_from_many_operation_impl(
+	socket& s,
+	std::span<datagram_buffer> buffers) noexcept
+	: m_socket(s)
+	// recvmmsg() receives at most UIO_MAXIOV datagrams per call.
+	, m_buffers(buffers.first(std::min<std::size_t>(buffers.size(), UIO_MAXIOV)))
+	, m_headers(nullptr)
+	, m_messages(nullptr)
+	, m_pollState(&socket_recv_from_many_operation_impl::on_poll_completed)
+	, m_operation(nullptr)
+	, m_cancelRequested(false)
+{
+}
+
+cppcoro::net::socket_recv_from_many_operation_impl::~socket_recv_from_many_operation_impl()
+{
+}
+
+bool cppcoro::net::socket_recv_from_many_operation_impl::try_start(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	m_operation = &operation;
+	m_pollState.m_impl = this;
+
+	if (m_buffers.empty())
+	{
+		operation.m_result = 0;
+		return false;
+	}
+
+	m_headers = m_inlineHeaders;
+	m_messages = m_inlineMessages;
+	if (m_buffers.size() > inline_message_count)
+	{
+		m_allocatedHeaders.reset(new (std::nothrow) cppcoro::detail::lnx::mmsghdr_t[m_buffers.size()]);
+		m_allocatedMessages.reset(new (std::nothrow) message[m_buffers.size()]);
+		if (!m_allocatedHeaders || !m_allocatedMessages)
+		{
+			operation.m_result = -ENOMEM;
+			return false;
+		}
+
+		m_headers = m_allocatedHeaders.get();
+		m_messages = m_allocatedMessages.get();
+	}
+
+	for (std::size_t i = 0; i < m_buffers.size(); ++i)
+	{
+		auto& header = m_headers[i];
+		auto& m = m_messages[i];
+		std::memset(&header, 0, sizeof(header));
+		m.m_buffer.iov_base = m_buffers[i].buffer;
+		m.m_buffer.iov_len = m_buffers[i].size;
+		header.msg_hdr.msg_name = &m.m_sourceAddress;
+		header.msg_hdr.msg_namelen = sizeof(m.m_sourceAddress);
+		header.msg_hdr.msg_iov = &m.m_buffer;
+		header.msg_hdr.msg_iovlen = 1;
+	}
+
+	// Datagrams are often already queued on a busy socket so try to receive
+	// them straight away rather than waiting for a poll to complete first.
+	const int result = try_receive();
+	if (result != -EAGAIN)
+	{
+		operation.m_result = result;
+		return false;
+	}
+
+	const int pollResult = start_poll();
+	if (pollResult < 0)
+	{
+		operation.m_result = pollResult;
+		return false;
+	}
+
+	// Operation will complete asynchronously.
+	return true;
+}
+
+void cppcoro::net::socket_recv_from_many_operation_impl::cancel(
+	cppcoro::detail::io_uring_operation_base&) noexcept
+{
+	// Hold the submission mutex while setting the flag and submitting the
+	// cancellation so that this can't slip in between start_poll() checking
+	// the flag and submitting a new poll, which would leave that poll armed.
+	auto& ioQueue = m_socket.io_queue();
+	std::lock_guard lock{ ioQueue.submission_mutex() };
+	m_cancelRequested = true;
+
+	// We intentionally ignore failure here as there is nothing more we can
+	// do. The operation will just run to completion instead.
+	if (io_uring_sqe* sqe = ioQueue.get_sqe(); sqe != nullptr)
+	{
+		sqe->opcode = IORING_OP_ASYNC_CANCEL;
+		sqe->fd = -1;
+		sqe->addr = reinterpret_cast<std::uintptr_t>(
+			static_cast<cppcoro::detail::lnx::io_state*>(&m_pollState));
+		sqe->user_data = cppcoro::detail::lnx::io_uring_queue::ignored_user_data;
+		ioQueue.submit_pending();
+	}
+}
+
+std::size_t cppcoro::net::socket_recv_from_many_operation_impl::get_result(
+	cppcoro::detail::io_uring_operation_base& operation)
+{
+	if (operation.m_result < 0)
+	{
+		throw std::system_error(
+			-operation.m_result,
+			std::system_category(),
+			"Error receiving messages on socket: recvmmsg");
+	}
+
+	const auto count = static_cast<std::size_t>(operation.m_result);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const auto& header = m_headers[i];
+		const auto& m = m_messages[i];
+		auto& b = m_buffers[i];
+		b.bytesReceived = header.msg_len;
+		b.source = detail::sockaddr_to_ip_endpoint(
+			*reinterpret_cast<const sockaddr*>(&m.m_sourceAddress));
+		b.truncated = (header.msg_hdr.msg_flags & MSG_TRUNC) != 0;
+	}
+
+	return count;
+}
+
+void cppcoro::net::socket_recv_from_many_operation_impl::on_poll_completed(
+	cppcoro::detail::lnx::io_state* state,
+	std::int32_t result,
+	std::uint32_t) noexcept
+{
+	auto* impl = static_cast<poll_state*>(state)->m_impl;
+	auto& operation = *impl->m_operation;
+
+	if (result < 0)
+	{
+		operation.complete(result, 0);
+		return;
+	}
+
+	result = impl->try_receive();
+	if (result == -EAGAIN)
+	{
+		// Another reader of the socket got to the datagrams first.
+		result = impl->start_poll();
+		if (result == 0)
+		{
+			return;
+		}
+	}
+
+	operation.complete(result, 0);
+}
+
+int cppcoro::net::socket_recv_from_many_operation_impl::try_receive() noexcept
+{
+	int result;
+	do
+	{
+		result = ::recvmmsg(
+			m_socket.native_handle(),
+			reinterpret_cast<::mmsghdr*>(m_headers),
+			static_cast<unsigned int>(m_buffers.size()),
+			MSG_DONTWAIT,
+			nullptr);
+	} while (result < 0 && errno == EINTR);
+
+	if (result < 0)
+	{
+		return errno == EWOULDBLOCK ? -EAGAIN : -errno;
+	}
+
+	return result;
+}
+
+int cppcoro::net::socket_recv_from_many_operation_impl::start_poll() noexcept
+{
+	// See cancel() for why the flag is checked under the submission mutex.
+	auto& ioQueue = m_socket.io_queue();
+	std::lock_guard lock{ ioQueue.submission_mutex() };
+	if (m_cancelRequested)
+	{
+		return -ECANCELED;
+	}
+
+	io_uring_sqe* sqe = ioQueue.get_sqe();
+	if (sqe == nullptr)
+	{
+		return -EBUSY;
+	}
+
+	sqe->opcode = IORING_OP_POLL_ADD;
+	sqe->fd = m_socket.native_handle();
+	sqe->poll32_events = POLLIN;
+	sqe->user_data = reinterpret_cast<std::uintptr_t>(
+		static_cast<cppcoro::detail::lnx::io_state*>(&m_pollState));
+	ioQueue.submit_pending();
+
+	return 0;
+}
+
+#endif
@@ -93,4 +93,112 @@ cppcoro::net::socket_recv_from_operation_impl::get_result(
 			*reinterpret_cast<SOCKADDR*>(&m_sourceSockaddrStorage)));
 }
 
+#elif CPPCORO_OS_LINUX
+# include "socket_helpers.hpp"
+
+# include <cerrno>
+# include <cstring>
+# include <system_error>
+
+# include <linux/io_uring.h>
+# include <netinet/udp.h>
+# include <sys/socket.h>
+
+static_assert(
+	CMSG_SPACE(sizeof(int)) <= 32,
+	"socket_recv_from_operation_impl::m_control is too small for UDP_GRO");
+
+bool cppcoro::net::socket_recv_from_operation_impl::try_start(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	// The message header must remain valid until the operation completes
+	// as the kernel writes the source address into it on completion.
+	std::memset(&m_message, 0, sizeof(m_message));
+	m_message.msg_name = &m_sourceAddress;
+	m_message.msg_namelen = sizeof(m_sourceAddress);
+	m_message.msg_iov = &m_buffer;
+	m_message.msg_iovlen = 1;
+
+	// Only used if UDP_GRO has been enabled on the socket.
+	m_message.msg_control = m_control;
+	m_message.msg_controllen = sizeof(m_control);
+
+	const int result = m_socket.io_queue().submit([&](io_uring_sqe& sqe)
+	{
+		sqe.opcode = IORING_OP_RECVMSG;
+		sqe.fd = m_socket.native_handle();
+		sqe.addr = reinterpret_cast<std::uintptr_t>(&m_message);
+		sqe.len = 1;
+		sqe.user_data = operation.get_user_data();
+	});
+	if (result < 0)
+	{
+		// Failed synchronously.
+		operation.m_result = result;
+		return false;
+	}
+
+	// Operation will complete asynchronously.
+	return true;
+}
+
+void cppcoro::net::socket_recv_from_operation_impl::cancel(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	m_socket.io_queue().cancel(operation.get_user_data());
+}
+
+std::tuple<std::size_t, cppcoro::net::ip_endpoint>
+cppcoro::net::socket_recv_from_operation_impl::get_result(
+	cppcoro::detail::io_uring_operation_base& operation)
+{
+	if (operation.m_result < 0)
+	{
+		throw std::system_error(
+			-operation.m_result,
+			std::system_category(),
+			"Error receiving message on socket: recvmsg");
+	}
+
+	if ((m_message.msg_flags & MSG_TRUNC) != 0)
+	{
+		// The rest of the datagram has been discarded. Report this as an
+		// error, the same as WSARecvFrom() does on Windows.
+		throw std::system_error(
+			EMSGSIZE,
+			std::system_category(),
+			"Error receiving message on socket: recvmsg");
+	}
+
+	return std::make_tuple(
+		static_cast<std::size_t>(operation.m_result),
+		detail::sockaddr_to_ip_endpoint(
+			*reinterpret_cast<const sockaddr*>(&m_sourceAddress)));
+}
+
+std::tuple<std::size_t, cppcoro::net::ip_endpoint, std::size_t>
+cppcoro::net::socket_recv_from_operation_impl::get_segmented_result(
+	cppcoro::detail::io_uring_operation_base& operation)
+{
+	auto [bytesReceived, sourceEndPoint] = get_result(operation);
+
+	// Without a UDP_GRO control message the data is a single datagram.
+	std::size_t segmentSize = bytesReceived;
+
+	auto* message = reinterpret_cast<msghdr*>(&m_message);
+	for (cmsghdr* control = CMSG_FIRSTHDR(message);
+		control != nullptr;
+		control = CMSG_NXTHDR(message, control))
+	{
+		if (control->cmsg_level == SOL_UDP && control->cmsg_type == UDP_GRO)
+		{
+			int size;
+			std::memcpy(&size, CMSG_DATA(control), sizeof(size));
+			segmentSize = static_cast<std::size_t>(size);
+		}
+	}
+
+	return std::make_tuple(bytesReceived, sourceEndPoint, segmentSize);
+}
+
 #endif
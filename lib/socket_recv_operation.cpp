@@ -63,4 +63,39 @@ void cppcoro::net::socket_recv_operation_impl::cancel(
 		operation.get_overlapped());
 }
 
+#elif CPPCORO_OS_LINUX
+# include <linux/io_uring.h>
+
+bool cppcoro::net::socket_recv_operation_impl::try_start(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	const std::uint32_t numberOfBytesToReceive =
+		m_byteCount <= 0xFFFFFFFF ?
+		static_cast<std::uint32_t>(m_byteCount) : std::uint32_t(0xFFFFFFFF);
+
+	const int result = m_socket.io_queue().submit([&](io_uring_sqe& sqe)
+	{
+		sqe.opcode = IORING_OP_RECV;
+		sqe.fd = m_socket.native_handle();
+		sqe.addr = reinterpret_cast<std::uintptr_t>(m_buffer);
+		sqe.len = numberOfBytesToReceive;
+		sqe.user_data = operation.get_user_data();
+	});
+	if (result < 0)
+	{
+		// Failed synchronously.
+		operation.m_result = result;
+		return false;
+	}
+
+	// Operation will complete asynchronously.
+	return true;
+}
+
+void cppcoro::net::socket_recv_operation_impl::cancel(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	m_socket.io_queue().cancel(operation.get_user_data());
+}
+
 #endif
@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/net/socket_recv_pooled_operation.hpp>
+#include <cppcoro/net/socket.hpp>
+
+#if CPPCORO_OS_LINUX
+# include <system_error>
+
+# include <linux/io_uring.h>
+
+bool cppcoro::net::socket_recv_pooled_operation_impl::try_start(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	const int result = m_socket.io_queue().submit([&](io_uring_sqe& sqe)
+	{
+		sqe.opcode = IORING_OP_RECV;
+		sqe.flags = IOSQE_BUFFER_SELECT;
+		sqe.fd = m_socket.native_handle();
+		sqe.len = static_cast<std::uint32_t>(m_pool.buffer_size());
+		sqe.buf_group = m_pool.m_groupId;
+		sqe.user_data = operation.get_user_data();
+	});
+	if (result < 0)
+	{
+		// Failed synchronously.
+		operation.m_result = result;
+		return false;
+	}
+
+	// Operation will complete asynchronously.
+	return true;
+}
+
+void cppcoro::net::socket_recv_pooled_operation_impl::cancel(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	m_socket.io_queue().cancel(operation.get_user_data());
+}
+
+cppcoro::net::recv_buffer_lease
+cppcoro::net::socket_recv_pooled_operation_impl::get_result(
+	cppcoro::detail::io_uring_operation_base& operation)
+{
+	// Take ownership of the selected buffer first so that it goes back to
+	// the pool even if the operation failed.
+	recv_buffer_lease lease;
+	if ((operation.m_flags & IORING_CQE_F_BUFFER) != 0)
+	{
+		lease = recv_buffer_lease{
+			m_pool,
+			static_cast<std::uint16_t>(operation.m_flags >> IORING_CQE_BUFFER_SHIFT),
+			operation.m_result > 0 ? static_cast<std::size_t>(operation.m_result) : 0
+		};
+	}
+
+	if (operation.m_result < 0)
+	{
+		// ENOBUFS means that every buffer in the pool is leased.
+		throw std::system_error{
+			-operation.m_result,
+			std::system_category(),
+			"Error receiving on socket: recv"
+		};
+	}
+
+	return lease;
+}
+
+#endif
@@ -0,0 +1,151 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/net/socket_recv_vectored_operation.hpp>
+#include <cppcoro/net/socket.hpp>
+
+#include <iterator>
+#include <new>
+
+#if CPPCORO_OS_WINNT
+# include <WinSock2.h>
+# include <WS2tcpip.h>
+# include <MSWSock.h>
+# include <Windows.h>
+
+bool cppcoro::net::socket_recv_vectored_operation_impl::try_start(
+	cppcoro::detail::win32_overlapped_operation_base& operation) noexcept
+{
+	cppcoro::detail::win32::wsabuf* wsaBuffers = m_inlineWsaBuffers;
+	if (m_buffers.size() > std::size(m_inlineWsaBuffers))
+	{
+		m_wsaBuffers.reset(new (std::nothrow) cppcoro::detail::win32::wsabuf[m_buffers.size()]);
+		if (!m_wsaBuffers)
+		{
+			operation.m_errorCode = ERROR_NOT_ENOUGH_MEMORY;
+			operation.m_numberOfBytesTransferred = 0;
+			return false;
+		}
+
+		wsaBuffers = m_wsaBuffers.get();
+	}
+
+	for (std::size_t i = 0; i < m_buffers.size(); ++i)
+	{
+		wsaBuffers[i] = cppcoro::detail::win32::wsabuf{
+			m_buffers[i].buffer, m_buffers[i].size };
+	}
+
+	// Need to read this flag before starting the operation, otherwise
+	// it may be possible that the operation will complete immediately
+	// on another thread and then destroy the socket before we get a
+	// chance to read it.
+	const bool skipCompletionOnSuccess = m_socket.skip_completion_on_success();
+
+	DWORD numberOfBytesReceived = 0;
+	DWORD flags = 0;
+	int result = ::WSARecv(
+		m_socket.native_handle(),
+		reinterpret_cast<WSABUF*>(wsaBuffers),
+		static_cast<DWORD>(m_buffers.size()),
+		&numberOfBytesReceived,
+		&flags,
+		operation.get_overlapped(),
+		nullptr);
+	if (result == SOCKET_ERROR)
+	{
+		int errorCode = ::WSAGetLastError();
+		if (errorCode != WSA_IO_PENDING)
+		{
+			// Failed synchronously.
+			operation.m_errorCode = static_cast<DWORD>(errorCode);
+			operation.m_numberOfBytesTransferred = numberOfBytesReceived;
+			return false;
+		}
+	}
+	else if (skipCompletionOnSuccess)
+	{
+		// Completed synchronously, no completion event will be posted to the IOCP.
+		operation.m_errorCode = ERROR_SUCCESS;
+		operation.m_numberOfBytesTransferred = numberOfBytesReceived;
+		return false;
+	}
+
+	// Operation will complete asynchronously.
+	return true;
+}
+
+void cppcoro::net::socket_recv_vectored_operation_impl::cancel(
+	cppcoro::detail::win32_overlapped_operation_base& operation) noexcept
+{
+	(void)::CancelIoEx(
+		reinterpret_cast<HANDLE>(m_socket.native_handle()),
+		operation.get_overlapped());
+}
+
+#elif CPPCORO_OS_LINUX
+# include <algorithm>
+# include <cerrno>
+# include <cstring>
+
+# include <linux/io_uring.h>
+# include <sys/socket.h>
+# include <sys/uio.h>
+
+bool cppcoro::net::socket_recv_vectored_operation_impl::try_start(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	// recvmsg() receives into at most UIO_MAXIOV buffers per call.
+	const std::size_t bufferCount = std::min<std::size_t>(m_buffers.size(), UIO_MAXIOV);
+
+	cppcoro::detail::lnx::iovec_t* iovecs = m_inlineIovecs;
+	if (bufferCount > std::size(m_inlineIovecs))
+	{
+		m_iovecs.reset(new (std::nothrow) cppcoro::detail::lnx::iovec_t[bufferCount]);
+		if (!m_iovecs)
+		{
+			operation.m_result = -ENOMEM;
+			return false;
+		}
+
+		iovecs = m_iovecs.get();
+	}
+
+	for (std::size_t i = 0; i < bufferCount; ++i)
+	{
+		iovecs[i].iov_base = m_buffers[i].buffer;
+		iovecs[i].iov_len = m_buffers[i].size;
+	}
+
+	std::memset(&m_message, 0, sizeof(m_message));
+	m_message.msg_iov = iovecs;
+	m_message.msg_iovlen = bufferCount;
+
+	const int result = m_socket.io_queue().submit([&](io_uring_sqe& sqe)
+	{
+		sqe.opcode = IORING_OP_RECVMSG;
+		sqe.fd = m_socket.native_handle();
+		sqe.addr = reinterpret_cast<std::uintptr_t>(&m_message);
+		sqe.len = 1;
+		sqe.user_data = operation.get_user_data();
+	});
+	if (result < 0)
+	{
+		// Failed synchronously.
+		operation.m_result = result;
+		return false;
+	}
+
+	// Operation will complete asynchronously.
+	return true;
+}
+
+void cppcoro::net::socket_recv_vectored_operation_impl::cancel(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	m_socket.io_queue().cancel(operation.get_user_data());
+}
+
+#endif
@@ -0,0 +1,75 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/net/socket_send_fds_operation.hpp>
+#include <cppcoro/net/socket.hpp>
+
+#if CPPCORO_OS_LINUX
+# include <cerrno>
+# include <cstring>
+
+# include <linux/io_uring.h>
+# include <sys/socket.h>
+
+bool cppcoro::net::socket_send_fds_operation_impl::try_start(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	static_assert(
+		CMSG_SPACE(sizeof(int) * max_fds_per_message) <= sizeof(m_control),
+		"m_control is too small for max_fds_per_message");
+
+	if (m_fds.size() > max_fds_per_message)
+	{
+		operation.m_result = -EINVAL;
+		return false;
+	}
+
+	std::memset(&m_message, 0, sizeof(m_message));
+	m_message.msg_iov = &m_buffer;
+	m_message.msg_iovlen = 1;
+
+	if (!m_fds.empty())
+	{
+		const std::size_t fdsSize = m_fds.size() * sizeof(int);
+
+		std::memset(m_control, 0, sizeof(m_control));
+		m_message.msg_control = m_control;
+		m_message.msg_controllen = CMSG_SPACE(fdsSize);
+
+		cmsghdr* control = CMSG_FIRSTHDR(reinterpret_cast<msghdr*>(&m_message));
+		control->cmsg_level = SOL_SOCKET;
+		control->cmsg_type = SCM_RIGHTS;
+		control->cmsg_len = CMSG_LEN(fdsSize);
+		std::memcpy(CMSG_DATA(control), m_fds.data(), fdsSize);
+	}
+
+	const int result = m_socket.io_queue().submit([&](io_uring_sqe& sqe)
+	{
+		sqe.opcode = IORING_OP_SENDMSG;
+		sqe.fd = m_socket.native_handle();
+		sqe.addr = reinterpret_cast<std::uintptr_t>(&m_message);
+		sqe.len = 1;
+		// Fail with EPIPE rather than raising SIGPIPE if the connection is closed.
+		sqe.msg_flags = MSG_NOSIGNAL;
+		sqe.user_data = operation.get_user_data();
+	});
+	if (result < 0)
+	{
+		// Failed synchronously.
+		operation.m_result = result;
+		return false;
+	}
+
+	// Operation will complete asynchronously.
+	return true;
+}
+
+void cppcoro::net::socket_send_fds_operation_impl::cancel(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	m_socket.io_queue().cancel(operation.get_user_data());
+}
+
+#endif
@@ -0,0 +1,325 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/net/socket_send_file_operation.hpp>
+#include <cppcoro/net/socket.hpp>
+
+#if CPPCORO_OS_WINNT
+# include <WinSock2.h>
+# include <WS2tcpip.h>
+# include <MSWSock.h>
+# include <Windows.h>
+
+bool cppcoro::net::socket_send_file_operation_impl::try_start(
+	cppcoro::detail::win32_overlapped_operation_base& operation) noexcept
+{
+	// TransmitFile() interprets a byte count of zero as 'send the rest of
+	// the file' so we need to handle empty requests ourselves.
+	if (m_byteCount == 0)
+	{
+		operation.m_errorCode = ERROR_SUCCESS;
+		operation.m_numberOfBytesTransferred = 0;
+		return false;
+	}
+
+	// Lookup the address of the TransmitFile function pointer for this socket.
+	LPFN_TRANSMITFILE transmitFilePtr;
+	{
+		GUID transmitFileGuid = WSAID_TRANSMITFILE;
+		DWORD byteCount = 0;
+		const int result = ::WSAIoctl(
+			m_socket.native_handle(),
+			SIO_GET_EXTENSION_FUNCTION_POINTER,
+			static_cast<void*>(&transmitFileGuid),
+			sizeof(transmitFileGuid),
+			static_cast<void*>(&transmitFilePtr),
+			sizeof(transmitFilePtr),
+			&byteCount,
+			nullptr,
+			nullptr);
+		if (result == SOCKET_ERROR)
+		{
+			operation.m_errorCode = static_cast<DWORD>(::WSAGetLastError());
+			return false;
+		}
+	}
+
+	// TransmitFile() can send at most 2^31 - 2 bytes per call.
+	// Larger requests complete after a partial transfer, the same as send().
+	const DWORD numberOfBytesToSend =
+		m_byteCount <= 0x7FFFFFFE ?
+		static_cast<DWORD>(m_byteCount) : DWORD(0x7FFFFFFE);
+
+	// Need to read this flag before starting the operation, otherwise
+	// it may be possible that the operation will complete immediately
+	// on another thread and then destroy the socket before we get a
+	// chance to read it.
+	const bool skipCompletionOnSuccess = m_socket.skip_completion_on_success();
+
+	// The file offset to start sending from is taken from the OVERLAPPED
+	// structure, which was initialised with it when the operation was created.
+	const BOOL ok = transmitFilePtr(
+		m_socket.native_handle(),
+		m_fileHandle,
+		numberOfBytesToSend,
+		0, // use the default send size
+		operation.get_overlapped(),
+		nullptr, // no header/trailer buffers
+		0); // flags
+	if (!ok)
+	{
+		const int errorCode = ::WSAGetLastError();
+		if (errorCode != ERROR_IO_PENDING && errorCode != WSA_IO_PENDING)
+		{
+			// Failed synchronously.
+			operation.m_errorCode = static_cast<DWORD>(errorCode);
+			operation.m_numberOfBytesTransferred = 0;
+			return false;
+		}
+	}
+	else if (skipCompletionOnSuccess)
+	{
+		// Completed synchronously, no completion event will be posted to the IOCP.
+		// TransmitFile() doesn't report the number of bytes sent directly.
+		DWORD numberOfBytesSent = 0;
+		DWORD flags = 0;
+		(void)::WSAGetOverlappedResult(
+			m_socket.native_handle(),
+			operation.get_overlapped(),
+			&numberOfBytesSent,
+			FALSE,
+			&flags);
+		operation.m_errorCode = ERROR_SUCCESS;
+		operation.m_numberOfBytesTransferred = numberOfBytesSent;
+		return false;
+	}
+
+	// Operation will complete asynchronously.
+	return true;
+}
+
+void cppcoro::net::socket_send_file_operation_impl::cancel(
+	cppcoro::detail::win32_overlapped_operation_base& operation) noexcept
+{
+	(void)::CancelIoEx(
+		reinterpret_cast<HANDLE>(m_socket.native_handle()),
+		operation.get_overlapped());
+}
+
+#elif CPPCORO_OS_LINUX
+# include <algorithm>
+# include <cerrno>
+# include <new>
+# include <utility>
+# include <vector>
+
+# include <fcntl.h>
+# include <linux/io_uring.h>
+# include <unistd.h>
+
+namespace
+{
+	namespace local
+	{
+		// Size to try to grow the pipe to so that large sends need fewer
+		// round-trips. Unprivileged processes can grow pipes up to 1MB by default.
+		constexpr int preferred_pipe_size = 1024 * 1024;
+
+		// Enough for a few sends to be in flight at once from each thread
+		// without holding on to an unbounded number of file descriptors.
+		constexpr std::size_t max_cached_pipes = 4;
+
+		struct splice_pipe
+		{
+			cppcoro::detail::lnx::safe_fd m_readEnd;
+			cppcoro::detail::lnx::safe_fd m_writeEnd;
+			int m_size = 0;
+		};
+
+		// Empty pipes ready to be reused by the next send_file() on this thread.
+		thread_local std::vector<splice_pipe> cachedPipes;
+
+		/// Take a pipe from this thread's cache, or create a new one.
+		///
+		/// \return
+		/// Zero on success, otherwise a negative errno value.
+		int acquire_pipe(splice_pipe& pipe) noexcept
+		{
+			if (!cachedPipes.empty())
+			{
+				pipe = std::move(cachedPipes.back());
+				cachedPipes.pop_back();
+				return 0;
+			}
+
+			int pipeFds[2];
+			if (::pipe2(pipeFds, O_CLOEXEC) == -1)
+			{
+				return -errno;
+			}
+
+			pipe.m_readEnd = cppcoro::detail::lnx::safe_fd{ pipeFds[0] };
+			pipe.m_writeEnd = cppcoro::detail::lnx::safe_fd{ pipeFds[1] };
+
+			pipe.m_size = ::fcntl(pipeFds[1], F_SETPIPE_SZ, preferred_pipe_size);
+			if (pipe.m_size == -1)
+			{
+				pipe.m_size = ::fcntl(pipeFds[1], F_GETPIPE_SZ);
+				if (pipe.m_size == -1)
+				{
+					return -errno;
+				}
+			}
+
+			return 0;
+		}
+	}
+}
+
+bool cppcoro::net::socket_send_file_operation_impl::try_start(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	m_operation = &operation;
+	m_fillState.m_impl = this;
+	m_drainState.m_impl = this;
+
+	if (m_byteCount == 0)
+	{
+		operation.m_result = 0;
+		return false;
+	}
+
+	{
+		local::splice_pipe pipe;
+		const int result = local::acquire_pipe(pipe);
+		if (result < 0)
+		{
+			operation.m_result = result;
+			return false;
+		}
+
+		m_pipeReadEnd = std::move(pipe.m_readEnd);
+		m_pipeWriteEnd = std::move(pipe.m_writeEnd);
+		m_pipeSize = pipe.m_size;
+	}
+
+	// Splicing into the pipe waits for room once the pipe is full and nothing
+	// drains the pipe until the first splice completes, so we mustn't ask for
+	// more than will fit. Larger requests complete after a partial transfer.
+	const std::uint32_t numberOfBytesToSend = static_cast<std::uint32_t>(
+		std::min<std::size_t>(m_byteCount, static_cast<std::size_t>(m_pipeSize)));
+
+	const int result = m_socket.io_queue().submit([&](io_uring_sqe& sqe)
+	{
+		sqe.opcode = IORING_OP_SPLICE;
+		sqe.fd = m_pipeWriteEnd.fd();
+		sqe.off = std::uint64_t(-1);
+		sqe.splice_fd_in = m_fileDescriptor;
+		sqe.splice_off_in = m_fileOffset;
+		sqe.len = numberOfBytesToSend;
+		sqe.user_data = reinterpret_cast<std::uintptr_t>(
+			static_cast<cppcoro::detail::lnx::io_state*>(&m_fillState));
+	});
+	if (result < 0)
+	{
+		// Failed synchronously. Nothing was spliced so the pipe is still empty.
+		release_pipe();
+		operation.m_result = result;
+		return false;
+	}
+
+	// Operation will complete asynchronously.
+	return true;
+}
+
+void cppcoro::net::socket_send_file_operation_impl::cancel(
+	cppcoro::detail::io_uring_operation_base&) noexcept
+{
+	// We don't know which of the two splices is in flight so try to cancel both.
+	auto& ioQueue = m_socket.io_queue();
+	ioQueue.cancel(reinterpret_cast<std::uintptr_t>(
+		static_cast<cppcoro::detail::lnx::io_state*>(&m_fillState)));
+	ioQueue.cancel(reinterpret_cast<std::uintptr_t>(
+		static_cast<cppcoro::detail::lnx::io_state*>(&m_drainState)));
+}
+
+void cppcoro::net::socket_send_file_operation_impl::on_fill_completed(
+	cppcoro::detail::lnx::io_state* state,
+	std::int32_t result,
+	std::uint32_t flags) noexcept
+{
+	auto* impl = static_cast<splice_state*>(state)->m_impl;
+	auto& operation = *impl->m_operation;
+
+	if (result <= 0)
+	{
+		// Failed, or the offset was at or past the end of the file.
+		// Either way nothing was spliced into the pipe.
+		impl->release_pipe();
+		operation.complete(result, flags);
+		return;
+	}
+
+	impl->m_bytesInPipe = result;
+
+	const int submitResult = impl->m_socket.io_queue().submit([&](io_uring_sqe& sqe)
+	{
+		sqe.opcode = IORING_OP_SPLICE;
+		sqe.fd = impl->m_socket.native_handle();
+		sqe.off = std::uint64_t(-1);
+		sqe.splice_fd_in = impl->m_pipeReadEnd.fd();
+		sqe.splice_off_in = std::uint64_t(-1);
+		sqe.len = static_cast<std::uint32_t>(result);
+		sqe.user_data = reinterpret_cast<std::uintptr_t>(
+			static_cast<cppcoro::detail::lnx::io_state*>(&impl->m_drainState));
+	});
+	if (submitResult < 0)
+	{
+		operation.complete(submitResult, 0);
+	}
+}
+
+void cppcoro::net::socket_send_file_operation_impl::on_drain_completed(
+	cppcoro::detail::lnx::io_state* state,
+	std::int32_t result,
+	std::uint32_t flags) noexcept
+{
+	auto* impl = static_cast<splice_state*>(state)->m_impl;
+
+	// Only reuse the pipe if everything read from the file was sent. Any data
+	// left behind is discarded along with the pipe and the caller resends it
+	// from the file.
+	if (result == impl->m_bytesInPipe)
+	{
+		impl->release_pipe();
+	}
+
+	// NOTE: The operation may be destroyed as soon as it is completed.
+	impl->m_operation->complete(result, flags);
+}
+
+void cppcoro::net::socket_send_file_operation_impl::release_pipe() noexcept
+{
+	if (local::cachedPipes.size() >= local::max_cached_pipes)
+	{
+		return;
+	}
+
+	local::splice_pipe pipe;
+	pipe.m_readEnd = std::move(m_pipeReadEnd);
+	pipe.m_writeEnd = std::move(m_pipeWriteEnd);
+	pipe.m_size = m_pipeSize;
+
+	try
+	{
+		local::cachedPipes.push_back(std::move(pipe));
+	}
+	catch (const std::bad_alloc&)
+	{
+		// Just close the pipe instead.
+	}
+}
+
+#endif
@@ -61,4 +61,135 @@ void cppcoro::net::socket_send_operation_impl::cancel(
 		operation.get_overlapped());
 }
 
+#elif CPPCORO_OS_LINUX
+# include <cerrno>
+
+# include <linux/io_uring.h>
+# include <sys/socket.h>
+
+bool cppcoro::net::socket_send_operation_impl::try_start(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	const std::uint32_t numberOfBytesToSend =
+		m_byteCount <= 0xFFFFFFFF ?
+		static_cast<std::uint32_t>(m_byteCount) : std::uint32_t(0xFFFFFFFF);
+
+	const int result = m_socket.io_queue().submit([&](io_uring_sqe& sqe)
+	{
+		sqe.opcode = IORING_OP_SEND;
+		sqe.fd = m_socket.native_handle();
+		sqe.addr = reinterpret_cast<std::uintptr_t>(m_buffer);
+		sqe.len = numberOfBytesToSend;
+		// Fail with EPIPE rather than raising SIGPIPE if the connection is closed.
+		sqe.msg_flags = MSG_NOSIGNAL;
+		sqe.user_data = operation.get_user_data();
+	});
+	if (result < 0)
+	{
+		// Failed synchronously.
+		operation.m_result = result;
+		return false;
+	}
+
+	// Operation will complete asynchronously.
+	return true;
+}
+
+void cppcoro::net::socket_send_operation_impl::cancel(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	m_socket.io_queue().cancel(operation.get_user_data());
+}
+
+bool cppcoro::net::socket_send_zero_copy_operation_impl::try_start(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	m_operation = &operation;
+	m_sendState.m_impl = this;
+
+	const int result = submit_send(IORING_OP_SEND_ZC);
+	if (result < 0)
+	{
+		// Failed synchronously.
+		operation.m_result = result;
+		return false;
+	}
+
+	// Operation will complete asynchronously.
+	return true;
+}
+
+void cppcoro::net::socket_send_zero_copy_operation_impl::cancel(
+	cppcoro::detail::io_uring_operation_base&) noexcept
+{
+	m_socket.io_queue().cancel(reinterpret_cast<std::uintptr_t>(
+		static_cast<cppcoro::detail::lnx::io_state*>(&m_sendState)));
+}
+
+void cppcoro::net::socket_send_zero_copy_operation_impl::on_send_completed(
+	cppcoro::detail::lnx::io_state* state,
+	std::int32_t result,
+	std::uint32_t flags) noexcept
+{
+	auto* impl = static_cast<send_state*>(state)->m_impl;
+	auto& operation = *impl->m_operation;
+
+	if ((flags & IORING_CQE_F_NOTIF) != 0)
+	{
+		// The notification can be processed by another thread before the
+		// first completion, so whichever is processed last completes the
+		// operation.
+		if (impl->m_pendingCompletions.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			operation.complete(impl->m_result, 0);
+		}
+
+		return;
+	}
+
+	if ((flags & IORING_CQE_F_MORE) == 0)
+	{
+		if (result == -EINVAL && impl->m_pendingCompletions.load(std::memory_order_relaxed) == 2)
+		{
+			// The kernel doesn't support IORING_OP_SEND_ZC (Linux 6.0), or
+			// the socket doesn't support zero-copy. Fall back to a normal send,
+			// whose buffer can be reused as soon as it completes.
+			impl->m_pendingCompletions.store(1, std::memory_order_relaxed);
+			result = impl->submit_send(IORING_OP_SEND);
+			if (result == 0)
+			{
+				return;
+			}
+		}
+
+		// No notification will follow.
+		operation.complete(result, 0);
+		return;
+	}
+
+	impl->m_result = result;
+	if (impl->m_pendingCompletions.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		operation.complete(result, 0);
+	}
+}
+
+int cppcoro::net::socket_send_zero_copy_operation_impl::submit_send(std::uint8_t opcode) noexcept
+{
+	const std::uint32_t numberOfBytesToSend =
+		m_byteCount <= 0xFFFFFFFF ?
+		static_cast<std::uint32_t>(m_byteCount) : std::uint32_t(0xFFFFFFFF);
+
+	return m_socket.io_queue().submit([&](io_uring_sqe& sqe)
+	{
+		sqe.opcode = opcode;
+		sqe.fd = m_socket.native_handle();
+		sqe.addr = reinterpret_cast<std::uintptr_t>(m_buffer);
+		sqe.len = numberOfBytesToSend;
+		sqe.msg_flags = MSG_NOSIGNAL;
+		sqe.user_data = reinterpret_cast<std::uintptr_t>(
+			static_cast<cppcoro::detail::lnx::io_state*>(&m_sendState));
+	});
+}
+
 #endif
@@ -0,0 +1,200 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/net/socket_send_to_many_operation.hpp>
+#include <cppcoro/net/socket.hpp>
+
+#if CPPCORO_OS_LINUX
+# include "socket_helpers.hpp"
+
+# include <algorithm>
+# include <cerrno>
+# include <cstring>
+# include <mutex>
+# include <new>
+
+# include <linux/io_uring.h>
+# include <poll.h>
+# include <sys/socket.h>
+# include <sys/uio.h>
+
+cppcoro::net::socket_send_to_many_operation_impl::socket_send_to_many_operation_impl(
+	socket& s,
+	std::span<const datagram> datagrams) noexcept
+	: m_socket(s)
+	// sendmmsg() sends at most UIO_MAXIOV datagrams per call.
+	, m_datagrams(datagrams.first(std::min<std::size_t>(datagrams.size(), UIO_MAXIOV)))
+	, m_headers(nullptr)
+	, m_messages(nullptr)
+	, m_pollState(&socket_send_to_many_operation_impl::on_poll_completed)
+	, m_operation(nullptr)
+	, m_cancelRequested(false)
+{
+}
+
+cppcoro::net::socket_send_to_many_operation_impl::~socket_send_to_many_operation_impl()
+{
+}
+
+bool cppcoro::net::socket_send_to_many_operation_impl::try_start(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	m_operation = &operation;
+	m_pollState.m_impl = this;
+
+	if (m_datagrams.empty())
+	{
+		operation.m_result = 0;
+		return false;
+	}
+
+	m_headers = m_inlineHeaders;
+	m_messages = m_inlineMessages;
+	if (m_datagrams.size() > inline_message_count)
+	{
+		m_allocatedHeaders.reset(new (std::nothrow) cppcoro::detail::lnx::mmsghdr_t[m_datagrams.size()]);
+		m_allocatedMessages.reset(new (std::nothrow) message[m_datagrams.size()]);
+		if (!m_allocatedHeaders || !m_allocatedMessages)
+		{
+			operation.m_result = -ENOMEM;
+			return false;
+		}
+
+		m_headers = m_allocatedHeaders.get();
+		m_messages = m_allocatedMessages.get();
+	}
+
+	for (std::size_t i = 0; i < m_datagrams.size(); ++i)
+	{
+		auto& header = m_headers[i];
+		auto& m = m_messages[i];
+		std::memset(&header, 0, sizeof(header));
+		m.m_buffer.iov_base = const_cast<void*>(m_datagrams[i].buffer);
+		m.m_buffer.iov_len = m_datagrams[i].size;
+		header.msg_hdr.msg_name = &m.m_destinationAddress;
+		header.msg_hdr.msg_namelen = static_cast<socklen_t>(
+			detail::ip_endpoint_to_sockaddr(m_datagrams[i].destination, std::ref(*reinterpret_cast<sockaddr_storage*>(&m.m_destinationAddress))));
+		header.msg_hdr.msg_iov = &m.m_buffer;
+		header.msg_hdr.msg_iovlen = 1;
+	}
+
+	// The socket's send buffer usually has room so try to send straight away
+	// rather than waiting for a poll to complete first.
+	const int result = try_send();
+	if (result != -EAGAIN)
+	{
+		operation.m_result = result;
+		return false;
+	}
+
+	const int pollResult = start_poll();
+	if (pollResult < 0)
+	{
+		operation.m_result = pollResult;
+		return false;
+	}
+
+	// Operation will complete asynchronously.
+	return true;
+}
+
+void cppcoro::net::socket_send_to_many_operation_impl::cancel(
+	cppcoro::detail::io_uring_operation_base&) noexcept
+{
+	// Hold the submission mutex while setting the flag and submitting the
+	// cancellation so that this can't slip in between start_poll() checking
+	// the flag and submitting a new poll, which would leave that poll armed.
+	auto& ioQueue = m_socket.io_queue();
+	std::lock_guard lock{ ioQueue.submission_mutex() };
+	m_cancelRequested = true;
+
+	// We intentionally ignore failure here as there is nothing more we can
+	// do. The operation will just run to completion instead.
+	if (io_uring_sqe* sqe = ioQueue.get_sqe(); sqe != nullptr)
+	{
+		sqe->opcode = IORING_OP_ASYNC_CANCEL;
+		sqe->fd = -1;
+		sqe->addr = reinterpret_cast<std::uintptr_t>(
+			static_cast<cppcoro::detail::lnx::io_state*>(&m_pollState));
+		sqe->user_data = cppcoro::detail::lnx::io_uring_queue::ignored_user_data;
+		ioQueue.submit_pending();
+	}
+}
+
+void cppcoro::net::socket_send_to_many_operation_impl::on_poll_completed(
+	cppcoro::detail::lnx::io_state* state,
+	std::int32_t result,
+	std::uint32_t) noexcept
+{
+	auto* impl = static_cast<poll_state*>(state)->m_impl;
+	auto& operation = *impl->m_operation;
+
+	if (result < 0)
+	{
+		operation.complete(result, 0);
+		return;
+	}
+
+	result = impl->try_send();
+	if (result == -EAGAIN)
+	{
+		// Another writer to the socket filled the send buffer first.
+		result = impl->start_poll();
+		if (result == 0)
+		{
+			return;
+		}
+	}
+
+	operation.complete(result, 0);
+}
+
+int cppcoro::net::socket_send_to_many_operation_impl::try_send() noexcept
+{
+	int result;
+	do
+	{
+		result = ::sendmmsg(
+			m_socket.native_handle(),
+			reinterpret_cast<::mmsghdr*>(m_headers),
+			static_cast<unsigned int>(m_datagrams.size()),
+			MSG_DONTWAIT | MSG_NOSIGNAL);
+	} while (result < 0 && errno == EINTR);
+
+	if (result < 0)
+	{
+		return errno == EWOULDBLOCK ? -EAGAIN : -errno;
+	}
+
+	return result;
+}
+
+int cppcoro::net::socket_send_to_many_operation_impl::start_poll() noexcept
+{
+	// See cancel() for why the flag is checked under the submission mutex.
+	auto& ioQueue = m_socket.io_queue();
+	std::lock_guard lock{ ioQueue.submission_mutex() };
+	if (m_cancelRequested)
+	{
+		return -ECANCELED;
+	}
+
+	io_uring_sqe* sqe = ioQueue.get_sqe();
+	if (sqe == nullptr)
+	{
+		return -EBUSY;
+	}
+
+	sqe->opcode = IORING_OP_POLL_ADD;
+	sqe->fd = m_socket.native_handle();
+	sqe->poll32_events = POLLOUT;
+	sqe->user_data = reinterpret_cast<std::uintptr_t>(
+		static_cast<cppcoro::detail::lnx::io_state*>(&m_pollState));
+	ioQueue.submit_pending();
+
+	return 0;
+}
+
+#endif
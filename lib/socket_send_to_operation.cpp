@@ -69,4 +69,70 @@ void cppcoro::net::socket_send_to_operation_impl::cancel(
 		operation.get_overlapped());
 }
 
+#elif CPPCORO_OS_LINUX
+# include "socket_helpers.hpp"
+
+# include <cstring>
+
+# include <linux/io_uring.h>
+# include <netinet/udp.h>
+# include <sys/socket.h>
+
+static_assert(
+	CMSG_SPACE(sizeof(std::uint16_t)) <= 32,
+	"socket_send_to_operation_impl::m_control is too small for UDP_SEGMENT");
+
+bool cppcoro::net::socket_send_to_operation_impl::try_start(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	const int destinationLength = detail::ip_endpoint_to_sockaddr(
+		m_destination, std::ref(*reinterpret_cast<sockaddr_storage*>(&m_destinationAddress)));
+
+	// The message header must remain valid until the operation completes
+	// as the kernel may not read it until then.
+	std::memset(&m_message, 0, sizeof(m_message));
+	m_message.msg_name = &m_destinationAddress;
+	m_message.msg_namelen = static_cast<socklen_t>(destinationLength);
+	m_message.msg_iov = &m_buffer;
+	m_message.msg_iovlen = 1;
+
+	if (m_segmentSize != 0)
+	{
+		m_message.msg_control = m_control;
+		m_message.msg_controllen = CMSG_SPACE(sizeof(std::uint16_t));
+
+		auto* message = reinterpret_cast<msghdr*>(&m_message);
+		cmsghdr* control = CMSG_FIRSTHDR(message);
+		control->cmsg_level = SOL_UDP;
+		control->cmsg_type = UDP_SEGMENT;
+		control->cmsg_len = CMSG_LEN(sizeof(std::uint16_t));
+		std::memcpy(CMSG_DATA(control), &m_segmentSize, sizeof(m_segmentSize));
+	}
+
+	const int result = m_socket.io_queue().submit([&](io_uring_sqe& sqe)
+	{
+		sqe.opcode = IORING_OP_SENDMSG;
+		sqe.fd = m_socket.native_handle();
+		sqe.addr = reinterpret_cast<std::uintptr_t>(&m_message);
+		sqe.len = 1;
+		sqe.msg_flags = MSG_NOSIGNAL;
+		sqe.user_data = operation.get_user_data();
+	});
+	if (result < 0)
+	{
+		// Failed synchronously.
+		operation.m_result = result;
+		return false;
+	}
+
+	// Operation will complete asynchronously.
+	return true;
+}
+
+void cppcoro::net::socket_send_to_operation_impl::cancel(
+	cppcoro::detail::io_uring_operation_base& operation) noexcept
+{
+	m_socket.io_queue().cancel(operation.get_user_data());
+}
+
 #endif
@@ -4,6 +4,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <cppcoro/writable_file.hpp>
+#include <cppcoro/io_service.hpp>
 
 #include <system_error>
 
@@ -72,4 +73,153 @@ cppcoro::file_write_operation_cancellable cppcoro::writable_file::write(
 	};
 }
 
+cppcoro::file_write_vectored_operation cppcoro::writable_file::write(
+	std::uint64_t offset,
+	std::span<const file_write_buffer> buffers) noexcept
+{
+	return file_write_vectored_operation{
+		m_fileHandle.handle(),
+		offset,
+		buffers
+	};
+}
+
+cppcoro::file_write_vectored_operation_cancellable cppcoro::writable_file::write(
+	std::uint64_t offset,
+	std::span<const file_write_buffer> buffers,
+	cancellation_token ct) noexcept
+{
+	return file_write_vectored_operation_cancellable{
+		m_fileHandle.handle(),
+		offset,
+		buffers,
+		std::move(ct)
+	};
+}
+
+cppcoro::file_sync_operation cppcoro::writable_file::flush() noexcept
+{
+	return file_sync_operation{ m_fileHandle.handle(), false };
+}
+
+cppcoro::file_sync_operation cppcoro::writable_file::sync_data() noexcept
+{
+	return file_sync_operation{ m_fileHandle.handle(), true };
+}
+
+cppcoro::file_allocate_operation cppcoro::writable_file::preallocate(
+	std::uint64_t offset,
+	std::uint64_t length) noexcept
+{
+	return file_allocate_operation{ m_fileHandle.handle(), offset, length, false };
+}
+
+cppcoro::file_allocate_operation cppcoro::writable_file::punch_hole(
+	std::uint64_t offset,
+	std::uint64_t length) noexcept
+{
+	return file_allocate_operation{ m_fileHandle.handle(), offset, length, true };
+}
+
+#elif CPPCORO_OS_LINUX
+# include <unistd.h>
+
+void cppcoro::writable_file::set_size(
+	std::uint64_t fileSize)
+{
+	if (::ftruncate(m_fileDescriptor.fd(), static_cast<off_t>(fileSize)) == -1)
+	{
+		throw std::system_error
+		{
+			errno,
+			std::system_category(),
+			"error setting file size: ftruncate"
+		};
+	}
+}
+
+cppcoro::file_write_operation cppcoro::writable_file::write(
+	std::uint64_t offset,
+	const void* buffer,
+	std::size_t byteCount) noexcept
+{
+	return file_write_operation{
+		m_ioService->native_io_uring_queue(),
+		m_fileDescriptor.fd(),
+		offset,
+		buffer,
+		byteCount
+	};
+}
+
+cppcoro::file_write_operation_cancellable cppcoro::writable_file::write(
+	std::uint64_t offset,
+	const void* buffer,
+	std::size_t byteCount,
+	cancellation_token ct) noexcept
+{
+	return file_write_operation_cancellable{
+		m_ioService->native_io_uring_queue(),
+		m_fileDescriptor.fd(),
+		offset,
+		buffer,
+		byteCount,
+		std::move(ct)
+	};
+}
+
+cppcoro::file_write_vectored_operation cppcoro::writable_file::write(
+	std::uint64_t offset,
+	std::span<const file_write_buffer> buffers) noexcept
+{
+	return file_write_vectored_operation{
+		m_ioService->native_io_uring_queue(),
+		m_fileDescriptor.fd(),
+		offset,
+		buffers
+	};
+}
+
+cppcoro::file_write_vectored_operation_cancellable cppcoro::writable_file::write(
+	std::uint64_t offset,
+	std::span<const file_write_buffer> buffers,
+	cancellation_token ct) noexcept
+{
+	return file_write_vectored_operation_cancellable{
+		m_ioService->native_io_uring_queue(),
+		m_fileDescriptor.fd(),
+		offset,
+		buffers,
+		std::move(ct)
+	};
+}
+
+cppcoro::file_sync_operation cppcoro::writable_file::flush() noexcept
+{
+	return file_sync_operation{
+		m_ioService->native_io_uring_queue(), m_fileDescriptor.fd(), false };
+}
+
+cppcoro::file_sync_operation cppcoro::writable_file::sync_data() noexcept
+{
+	return file_sync_operation{
+		m_ioService->native_io_uring_queue(), m_fileDescriptor.fd(), true };
+}
+
+cppcoro::file_allocate_operation cppcoro::writable_file::preallocate(
+	std::uint64_t offset,
+	std::uint64_t length) noexcept
+{
+	return file_allocate_operation{
+		m_ioService->native_io_uring_queue(), m_fileDescriptor.fd(), offset, length, false };
+}
+
+cppcoro::file_allocate_operation cppcoro::writable_file::punch_hole(
+	std::uint64_t offset,
+	std::uint64_t length) noexcept
+{
+	return file_allocate_operation{
+		m_ioService->native_io_uring_queue(), m_fileDescriptor.fd(), offset, length, true };
+}
+
 #endif
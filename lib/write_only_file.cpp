@@ -3,7 +3,8 @@
 // Licenced under MIT license. See LICENSE.txt for details.
 ///////////////////////////////////////////////////////////////////////////////
 
-#include <cppcoro\write_only_file.hpp>
+#include <cppcoro/write_only_file.hpp>
+#include <cppcoro/io_service.hpp>
 
 #if CPPCORO_OS_WINNT
 # ifndef WIN32_LEAN_AND_MEAN
@@ -34,4 +35,32 @@ cppcoro::write_only_file::write_only_file(
 {
 }
 
+#elif CPPCORO_OS_LINUX
+# include <fcntl.h>
+
+cppcoro::write_only_file cppcoro::write_only_file::open(
+	io_service& ioService,
+	const cppcoro::filesystem::path& path,
+	file_open_mode openMode,
+	file_share_mode shareMode,
+	file_buffering_mode bufferingMode)
+{
+	return write_only_file(file::open(
+		O_WRONLY,
+		ioService,
+		path,
+		openMode,
+		shareMode,
+		bufferingMode),
+		ioService);
+}
+
+cppcoro::write_only_file::write_only_file(
+	detail::lnx::safe_fd&& fileDescriptor,
+	io_service& ioService) noexcept
+	: file(std::move(fileDescriptor), &ioService)
+	, writable_file(detail::lnx::safe_fd{}, &ioService)
+{
+}
+
 #endif
@@ -0,0 +1,184 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/net/buffered_socket_reader.hpp>
+#include <cppcoro/net/buffered_socket_writer.hpp>
+#include <cppcoro/net/socket.hpp>
+
+#include <cppcoro/io_service.hpp>
+#include <cppcoro/on_scope_exit.hpp>
+#include <cppcoro/sync_wait.hpp>
+#include <cppcoro/task.hpp>
+#include <cppcoro/when_all.hpp>
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include <ostream>
+#include "doctest/cppcoro_doctest.h"
+
+using namespace cppcoro;
+using namespace cppcoro::net;
+
+TEST_SUITE_BEGIN("buffered_socket");
+
+namespace
+{
+	std::string_view as_string(std::span<const std::byte> bytes)
+	{
+		return std::string_view{ reinterpret_cast<const char*>(bytes.data()), bytes.size() };
+	}
+
+	/// Connect a pair of TCP sockets over loopback and run \a sender on one
+	/// and \a receiver on the other.
+	void run_connected(
+		std::function<task<>(socket&)> sender,
+		std::function<task<>(socket&)> receiver)
+	{
+		io_service ioSvc;
+
+		auto listeningSocket = socket::create_tcpv4(ioSvc);
+		listeningSocket.bind(ipv4_endpoint{ ipv4_address::loopback(), 0 });
+		listeningSocket.listen(1);
+
+		auto server = [&]() -> task<>
+		{
+			auto s = socket::create_tcpv4(ioSvc);
+			co_await listeningSocket.accept(s);
+			co_await sender(s);
+			s.close_send();
+		};
+
+		auto client = [&]() -> task<>
+		{
+			auto s = socket::create_tcpv4(ioSvc);
+			s.bind(ipv4_endpoint{ ipv4_address::loopback(), 0 });
+			co_await s.connect(listeningSocket.local_endpoint());
+			co_await receiver(s);
+		};
+
+		(void)sync_wait(when_all(
+			[&]() -> task<>
+			{
+				auto stopOnExit = on_scope_exit([&] { ioSvc.stop(); });
+				(void)co_await when_all(server(), client());
+			}(),
+			[&]() -> task<>
+			{
+				ioSvc.process_events();
+				co_return;
+			}()));
+	}
+}
+
+TEST_CASE("buffered reader parses messages sent by buffered writer")
+{
+	const std::string largeMessage(100, 'x');
+
+	run_connected(
+		[&](socket& s) -> task<>
+		{
+			buffered_socket_writer writer{ s, 32 };
+			CHECK(writer.high_water_mark() == 32);
+
+			co_await writer.write("first line\r\n");
+			CHECK(writer.buffered_size() == 12);
+
+			co_await writer.write("second\r\nthird\r\n");
+
+			const unsigned char prefix[2] = { 0x00, 0x05 };
+			co_await writer.write(prefix, sizeof(prefix));
+			co_await writer.write("hello");
+
+			// Doesn't fit, so is sent along with everything buffered so far.
+			co_await writer.write(largeMessage);
+			CHECK(writer.buffered_size() == 0);
+
+			co_await writer.write("tail");
+			co_await writer.flush();
+			CHECK(writer.buffered_size() == 0);
+		},
+		[&](socket& s) -> task<>
+		{
+			// Small enough that the buffer has to be compacted.
+			buffered_socket_reader reader{ s, 128 };
+			CHECK(reader.capacity() == 128);
+
+			CHECK(co_await reader.read_until("\r\n") == "first line\r\n");
+			CHECK(co_await reader.read_until("\r\n") == "second\r\n");
+			CHECK(co_await reader.read_until("\r\n") == "third\r\n");
+			CHECK(as_string(co_await reader.read_length_prefixed<std::uint16_t>()) == "hello");
+			CHECK(as_string(co_await reader.read_exact(100)) == largeMessage);
+			CHECK(as_string(co_await reader.read_exact(4)) == "tail");
+
+			// Peer closed the connection at a message boundary.
+			CHECK((co_await reader.read_until("\r\n")).empty());
+			CHECK(reader.buffered_size() == 0);
+		});
+}
+
+TEST_CASE("buffered reader reports a message cut short by the peer closing")
+{
+	run_connected(
+		[&](socket& s) -> task<>
+		{
+			buffered_socket_writer writer{ s };
+			co_await writer.write("no delimiter");
+			co_await writer.flush();
+		},
+		[&](socket& s) -> task<>
+		{
+			buffered_socket_reader reader{ s };
+			try
+			{
+				(void)co_await reader.read_until("\n");
+				FAIL("expected read_until() to throw");
+			}
+			catch (const std::system_error& ex)
+			{
+				CHECK(ex.code() == std::errc::connection_aborted);
+			}
+		});
+}
+
+TEST_CASE("buffered reader rejects messages larger than its capacity")
+{
+	run_connected(
+		[&](socket& s) -> task<>
+		{
+			buffered_socket_writer writer{ s };
+			const unsigned char prefix[1] = { 200 };
+			co_await writer.write(prefix, sizeof(prefix));
+			co_await writer.write("0123456789abcdef\n");
+			co_await writer.flush();
+		},
+		[&](socket& s) -> task<>
+		{
+			buffered_socket_reader reader{ s, 8 };
+			try
+			{
+				(void)co_await reader.read_length_prefixed<std::uint8_t>();
+				FAIL("expected read_length_prefixed() to throw");
+			}
+			catch (const std::system_error& ex)
+			{
+				CHECK(ex.code() == std::errc::message_size);
+			}
+
+			try
+			{
+				(void)co_await reader.read_until("\n");
+				FAIL("expected read_until() to throw");
+			}
+			catch (const std::system_error& ex)
+			{
+				CHECK(ex.code() == std::errc::message_size);
+			}
+		});
+}
+
+TEST_SUITE_END();
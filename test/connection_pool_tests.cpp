@@ -0,0 +1,263 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/net/connection_pool.hpp>
+#include <cppcoro/net/socket.hpp>
+
+#include <cppcoro/cancellation_source.hpp>
+#include <cppcoro/io_service.hpp>
+#include <cppcoro/on_scope_exit.hpp>
+#include <cppcoro/operation_cancelled.hpp>
+#include <cppcoro/sync_wait.hpp>
+#include <cppcoro/task.hpp>
+#include <cppcoro/when_all.hpp>
+
+#include <chrono>
+#include <functional>
+#include <vector>
+
+#include <ostream>
+#include "doctest/cppcoro_doctest.h"
+
+using namespace cppcoro;
+using namespace cppcoro::net;
+using namespace std::chrono_literals;
+
+TEST_SUITE_BEGIN("connection_pool");
+
+namespace
+{
+	/// Accepts connections on a loopback port, keeping them open until they
+	/// are closed with close_all().
+	class test_server
+	{
+	public:
+
+		explicit test_server(io_service& ioSvc)
+			: m_ioService(ioSvc)
+			, m_listeningSocket(socket::create_tcpv4(ioSvc))
+		{
+			m_listeningSocket.bind(ipv4_endpoint{ ipv4_address::loopback(), 0 });
+			m_listeningSocket.listen();
+		}
+
+		ip_endpoint endpoint() const { return m_listeningSocket.local_endpoint(); }
+
+		std::size_t accept_count() const { return m_connections.size(); }
+
+		task<> accept(std::size_t count)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				auto s = socket::create_tcpv4(m_ioService);
+				co_await m_listeningSocket.accept(s);
+				m_connections.push_back(std::move(s));
+			}
+		}
+
+		void close_all() { m_connections.clear(); }
+
+	private:
+
+		io_service& m_ioService;
+		socket m_listeningSocket;
+		std::vector<socket> m_connections;
+
+	};
+
+	void run(io_service& ioSvc, std::function<task<>()> body)
+	{
+		(void)sync_wait(when_all(
+			[&]() -> task<>
+			{
+				auto stopOnExit = on_scope_exit([&] { ioSvc.stop(); });
+				co_await body();
+			}(),
+			[&]() -> task<>
+			{
+				ioSvc.process_events();
+				co_return;
+			}()));
+	}
+}
+
+TEST_CASE("released connections are reused")
+{
+	io_service ioSvc;
+	test_server server{ ioSvc };
+	connection_pool pool{ ioSvc };
+
+	run(ioSvc, [&]() -> task<>
+	{
+		ip_endpoint firstLocalEndPoint;
+
+		auto first = [&]() -> task<>
+		{
+			auto connection = co_await pool.acquire(server.endpoint());
+			CHECK(connection);
+			CHECK(connection.remote_endpoint() == server.endpoint());
+			firstLocalEndPoint = connection->local_endpoint();
+		};
+
+		(void)co_await when_all(server.accept(1), first());
+		CHECK(pool.idle_count() == 1);
+
+		{
+			auto connection = co_await pool.acquire(server.endpoint());
+			CHECK(connection->local_endpoint() == firstLocalEndPoint);
+			CHECK(pool.idle_count() == 0);
+
+			// A discarded connection is not returned to the pool.
+			connection.discard();
+		}
+
+		CHECK(pool.idle_count() == 0);
+		CHECK(server.accept_count() == 1);
+	});
+}
+
+TEST_CASE("idle connections closed by the peer are not reused")
+{
+	io_service ioSvc;
+	test_server server{ ioSvc };
+	connection_pool pool{ ioSvc };
+
+	run(ioSvc, [&]() -> task<>
+	{
+		ip_endpoint firstLocalEndPoint;
+
+		auto first = [&]() -> task<>
+		{
+			auto connection = co_await pool.acquire(server.endpoint());
+			firstLocalEndPoint = connection->local_endpoint();
+		};
+
+		(void)co_await when_all(server.accept(1), first());
+		CHECK(pool.idle_count() == 1);
+
+		server.close_all();
+
+		// Give the FIN time to arrive.
+		co_await ioSvc.schedule_after(50ms);
+
+		auto second = [&]() -> task<>
+		{
+			auto connection = co_await pool.acquire(server.endpoint());
+			CHECK(connection->local_endpoint() != firstLocalEndPoint);
+		};
+
+		(void)co_await when_all(server.accept(1), second());
+		CHECK(server.accept_count() == 1);
+	});
+}
+
+TEST_CASE("idle connections time out")
+{
+	io_service ioSvc;
+	test_server server{ ioSvc };
+	connection_pool pool{ ioSvc, 8, 4, 10ms };
+
+	run(ioSvc, [&]() -> task<>
+	{
+		auto acquireAndRelease = [&]() -> task<>
+		{
+			(void)co_await pool.acquire(server.endpoint());
+		};
+
+		(void)co_await when_all(server.accept(1), acquireAndRelease());
+		CHECK(pool.idle_count() == 1);
+
+		co_await ioSvc.schedule_after(50ms);
+
+		(void)co_await when_all(server.accept(1), acquireAndRelease());
+		CHECK(server.accept_count() == 2);
+		CHECK(pool.idle_count() == 1);
+	});
+}
+
+TEST_CASE("idle connections are limited per end-point")
+{
+	io_service ioSvc;
+	test_server server{ ioSvc };
+	connection_pool pool{ ioSvc, 2 };
+
+	run(ioSvc, [&]() -> task<>
+	{
+		auto acquireAll = [&]() -> task<>
+		{
+			auto a = co_await pool.acquire(server.endpoint());
+			auto b = co_await pool.acquire(server.endpoint());
+			auto c = co_await pool.acquire(server.endpoint());
+		};
+
+		(void)co_await when_all(server.accept(3), acquireAll());
+		CHECK(pool.idle_count() == 2);
+
+		pool.close_idle();
+		CHECK(pool.idle_count() == 0);
+	});
+}
+
+TEST_CASE("connects beyond the limit wait for a connect to finish")
+{
+	io_service ioSvc;
+	test_server server{ ioSvc };
+	connection_pool pool{ ioSvc, 8, 1 };
+
+	run(ioSvc, [&]() -> task<>
+	{
+		std::vector<pooled_connection> connections;
+
+		auto acquireOne = [&]() -> task<>
+		{
+			connections.push_back(co_await pool.acquire(server.endpoint()));
+		};
+
+		(void)co_await when_all(server.accept(3), acquireOne(), acquireOne(), acquireOne());
+		CHECK(connections.size() == 3);
+		CHECK(server.accept_count() == 3);
+
+		connections.clear();
+		CHECK(pool.idle_count() == 3);
+	});
+}
+
+TEST_CASE("a waiting acquire can be cancelled")
+{
+	io_service ioSvc;
+	test_server server{ ioSvc };
+	connection_pool pool{ ioSvc, 8, 1 };
+
+	run(ioSvc, [&]() -> task<>
+	{
+		cancellation_source source;
+		source.request_cancellation();
+
+		auto holder = [&]() -> task<>
+		{
+			(void)co_await pool.acquire(server.endpoint());
+		};
+
+		// Started while the holder's connect is in progress, so it has to
+		// wait, and is then cancelled straight away.
+		auto waiter = [&]() -> task<>
+		{
+			try
+			{
+				(void)co_await pool.acquire(server.endpoint(), source.token());
+				FAIL("expected acquire() to be cancelled");
+			}
+			catch (const operation_cancelled&)
+			{
+			}
+		};
+
+		(void)co_await when_all(server.accept(1), holder(), waiter());
+		CHECK(server.accept_count() == 1);
+		CHECK(pool.idle_count() == 1);
+	});
+}
+
+TEST_SUITE_END();
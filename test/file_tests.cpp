@@ -7,6 +7,10 @@
 #include <cppcoro/read_only_file.hpp>
 #include <cppcoro/write_only_file.hpp>
 #include <cppcoro/read_write_file.hpp>
+#include <cppcoro/append_log.hpp>
+#include <cppcoro/copy_file.hpp>
+#include <cppcoro/block_cache.hpp>
+#include <cppcoro/static_thread_pool.hpp>
 #include <cppcoro/task.hpp>
 #include <cppcoro/sync_wait.hpp>
 #include <cppcoro/when_all.hpp>
@@ -16,7 +20,11 @@
 #include <random>
 #include <thread>
 #include <cassert>
+#include <cstring>
+#include <memory>
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include "io_service_fixture.hpp"
 
@@ -212,4 +220,552 @@ TEST_CASE_FIXTURE(temp_dir_with_io_service_fixture, "cancel read")
 	}());
 }
 
+TEST_CASE_FIXTURE(temp_dir_with_io_service_fixture, "read_many")
+{
+	cppcoro::sync_wait([&]() -> cppcoro::task<>
+	{
+		cppcoro::io_work_scope ioScope{ io_service() };
+
+		auto f = cppcoro::read_write_file::open(io_service(), temp_dir() / "foo.dat");
+
+		std::uint8_t contents[1000];
+		for (std::size_t i = 0; i < sizeof(contents); ++i)
+		{
+			contents[i] = static_cast<std::uint8_t>(i % 256);
+		}
+
+		co_await f.write(0, contents, sizeof(contents));
+
+		std::uint8_t buffers[4][20];
+		cppcoro::file_read_request requests[4];
+		const std::uint64_t offsets[4] = { 900, 0, 333, 990 };
+		for (int i = 0; i < 4; ++i)
+		{
+			requests[i].offset = offsets[i];
+			requests[i].buffer = buffers[i];
+			requests[i].byteCount = sizeof(buffers[i]);
+		}
+
+		co_await f.read_many(requests);
+
+		for (int i = 0; i < 3; ++i)
+		{
+			CHECK(!requests[i].error);
+			CHECK(requests[i].bytesRead == 20);
+			CHECK(std::memcmp(buffers[i], contents + offsets[i], 20) == 0);
+		}
+
+		// Last read straddles the end of the file.
+		CHECK(!requests[3].error);
+		CHECK(requests[3].bytesRead == 10);
+		CHECK(std::memcmp(buffers[3], contents + 990, 10) == 0);
+	}());
+}
+
+TEST_CASE_FIXTURE(temp_dir_with_io_service_fixture, "read_chunks with read-ahead")
+{
+	cppcoro::sync_wait([&]() -> cppcoro::task<>
+	{
+		cppcoro::io_work_scope ioScope{ io_service() };
+
+		auto f = cppcoro::read_write_file::open(io_service(), temp_dir() / "chunks.dat");
+
+		// Not a multiple of the chunk size so the last chunk is short.
+		constexpr std::size_t fileSize = 100 * 1000 + 17;
+		auto contents = std::make_unique<std::uint8_t[]>(fileSize);
+		for (std::size_t i = 0; i < fileSize; ++i)
+		{
+			contents[i] = static_cast<std::uint8_t>(i % 251);
+		}
+
+		co_await f.write(0, contents.get(), fileSize);
+
+		std::uint64_t offset = 0;
+		std::size_t chunkCount = 0;
+		auto chunks = f.read_chunks(4096, 3);
+		for (auto it = co_await chunks.begin(); it != chunks.end(); co_await ++it)
+		{
+			auto chunk = *it;
+			CHECK(chunk.size() == std::min<std::uint64_t>(4096, fileSize - offset));
+			CHECK(std::memcmp(chunk.data(), contents.get() + offset, chunk.size()) == 0);
+			offset += chunk.size();
+			++chunkCount;
+		}
+
+		CHECK(offset == fileSize);
+		CHECK(chunkCount == (fileSize + 4095) / 4096);
+	}());
+}
+
+TEST_CASE_FIXTURE(temp_dir_with_io_service_fixture, "read_chunks unbuffered")
+{
+	cppcoro::sync_wait([&]() -> cppcoro::task<>
+	{
+		cppcoro::io_work_scope ioScope{ io_service() };
+
+		// Not a multiple of the chunk size so that the read of the last chunk
+		// comes up short at end-of-file.
+		constexpr std::size_t fileSize = 5 * 4096 + 123;
+		auto contents = std::make_unique<std::uint8_t[]>(fileSize);
+		for (std::size_t i = 0; i < fileSize; ++i)
+		{
+			contents[i] = static_cast<std::uint8_t>(i % 251);
+		}
+
+		{
+			auto f = cppcoro::write_only_file::open(io_service(), temp_dir() / "unbuffered.dat");
+			co_await f.write(0, contents.get(), fileSize);
+		}
+
+		auto f = cppcoro::read_only_file::open(
+			io_service(),
+			temp_dir() / "unbuffered.dat",
+			cppcoro::file_share_mode::read,
+			cppcoro::file_buffering_mode::unbuffered);
+
+		std::uint64_t offset = 0;
+		auto chunks = f.read_chunks(4096, 2);
+		for (auto it = co_await chunks.begin(); it != chunks.end(); co_await ++it)
+		{
+			auto chunk = *it;
+			CHECK(chunk.size() == std::min<std::uint64_t>(4096, fileSize - offset));
+			CHECK(std::memcmp(chunk.data(), contents.get() + offset, chunk.size()) == 0);
+			offset += chunk.size();
+		}
+
+		CHECK(offset == fileSize);
+	}());
+}
+
+TEST_CASE_FIXTURE(temp_dir_with_io_service_fixture, "read_chunks stopped early")
+{
+	cppcoro::sync_wait([&]() -> cppcoro::task<>
+	{
+		cppcoro::io_work_scope ioScope{ io_service() };
+
+		auto f = cppcoro::read_write_file::open(io_service(), temp_dir() / "chunks.dat");
+		f.set_size(1024 * 1024);
+
+		std::size_t chunkCount = 0;
+		{
+			auto chunks = f.read_chunks(64 * 1024, 8);
+			for (auto it = co_await chunks.begin(); it != chunks.end(); co_await ++it)
+			{
+				if (++chunkCount == 2)
+				{
+					break;
+				}
+			}
+		}
+
+		CHECK(chunkCount == 2);
+	}());
+}
+
+TEST_CASE_FIXTURE(temp_dir_with_io_service_fixture, "write gathered from multiple buffers")
+{
+	cppcoro::sync_wait([&]() -> cppcoro::task<>
+	{
+		cppcoro::io_work_scope ioScope{ io_service() };
+
+		auto f = cppcoro::read_write_file::open(io_service(), temp_dir() / "gather.dat");
+
+		const char header[] = "header:";
+		const char body[] = "body";
+		const char trailer[] = ":trailer";
+		const cppcoro::file_write_buffer buffers[] = {
+			{ header, sizeof(header) - 1 },
+			{ body, sizeof(body) - 1 },
+			{ trailer, sizeof(trailer) - 1 },
+		};
+
+		const std::size_t bytesWritten = co_await f.write(10, buffers);
+		CHECK(bytesWritten == 19);
+		CHECK(f.size() == 29);
+
+		char contents[19];
+		const std::size_t bytesRead = co_await f.read(10, contents, sizeof(contents));
+		CHECK(bytesRead == sizeof(contents));
+		CHECK(std::memcmp(contents, "header:body:trailer", sizeof(contents)) == 0);
+	}());
+}
+
+TEST_CASE_FIXTURE(temp_dir_with_io_service_fixture, "flush, preallocate and punch_hole")
+{
+	auto run = [&]() -> cppcoro::task<>
+	{
+		cppcoro::io_work_scope ioScope{ io_service() };
+		auto f = cppcoro::read_write_file::open(io_service(), temp_dir() / "foo.bin");
+
+		std::vector<unsigned char> data(64 * 1024, 0xAB);
+		co_await f.write(0, data.data(), data.size());
+
+		co_await f.flush();
+		co_await f.sync_data();
+
+		// Neither preallocate() nor punch_hole() change the size of the file.
+		co_await f.preallocate(0, 1024 * 1024);
+		CHECK(f.size() == data.size());
+
+		co_await f.punch_hole(4096, 8192);
+		CHECK(f.size() == data.size());
+
+		std::vector<unsigned char> readBack(data.size());
+		CHECK(co_await f.read(0, readBack.data(), readBack.size()) == readBack.size());
+		CHECK(std::all_of(readBack.begin(), readBack.begin() + 4096, [](auto b) { return b == 0xAB; }));
+		CHECK(std::all_of(readBack.begin() + 4096, readBack.begin() + 12288, [](auto b) { return b == 0; }));
+		CHECK(std::all_of(readBack.begin() + 12288, readBack.end(), [](auto b) { return b == 0xAB; }));
+	};
+
+	cppcoro::sync_wait(run());
+}
+
+TEST_CASE_FIXTURE(temp_dir_with_io_service_fixture, "copy_file")
+{
+	cppcoro::static_thread_pool blockingPool{ 1 };
+
+	auto run = [&]() -> cppcoro::task<>
+	{
+		cppcoro::io_work_scope ioScope{ io_service() };
+
+		// Several chunks with a partial chunk at the end.
+		const std::size_t fileSize = 3 * 1024 * 1024 + 1000;
+
+		std::vector<unsigned char> data(fileSize);
+		for (std::size_t i = 0; i < fileSize; ++i)
+		{
+			data[i] = static_cast<unsigned char>(i * 7);
+		}
+
+		auto source = cppcoro::read_write_file::open(io_service(), temp_dir() / "source.bin");
+		std::size_t bytesWritten = 0;
+		while (bytesWritten < fileSize)
+		{
+			bytesWritten += co_await source.write(
+				bytesWritten, data.data() + bytesWritten, fileSize - bytesWritten);
+		}
+
+		auto destination = cppcoro::read_write_file::open(io_service(), temp_dir() / "copy.bin");
+
+		// Copy a range from the middle of the file.
+		CHECK(co_await cppcoro::copy_file(
+			io_service(), blockingPool, source, destination, 100, 2 * 1024 * 1024) == 2 * 1024 * 1024);
+		CHECK(destination.size() == 100 + 2 * 1024 * 1024);
+
+		// Copying past the end of the source stops at the end of the source.
+		std::vector<std::uint64_t> progress;
+		auto copyOperation = cppcoro::copy_file_with_progress(
+			io_service(), blockingPool, source, destination, 0, fileSize + 4096);
+		for (auto it = co_await copyOperation.begin(); it != copyOperation.end();)
+		{
+			progress.push_back(*it);
+			(void)co_await ++it;
+		}
+
+		REQUIRE(!progress.empty());
+		CHECK(std::is_sorted(progress.begin(), progress.end()));
+		CHECK(progress.back() == fileSize);
+		CHECK(destination.size() == fileSize);
+
+		std::vector<unsigned char> readBack(fileSize);
+		std::size_t bytesRead = 0;
+		while (bytesRead < fileSize)
+		{
+			bytesRead += co_await destination.read(
+				bytesRead, readBack.data() + bytesRead, fileSize - bytesRead);
+		}
+		CHECK(readBack == data);
+	};
+
+	cppcoro::sync_wait(run());
+}
+
+TEST_CASE_FIXTURE(temp_dir_with_io_service_fixture, "copy_file cancellation")
+{
+	cppcoro::static_thread_pool blockingPool{ 1 };
+
+	auto run = [&]() -> cppcoro::task<>
+	{
+		cppcoro::io_work_scope ioScope{ io_service() };
+
+		const std::size_t fileSize = 4 * 1024 * 1024;
+		std::vector<unsigned char> data(fileSize, 0xCD);
+
+		auto source = cppcoro::read_write_file::open(io_service(), temp_dir() / "source.bin");
+		std::size_t bytesWritten = 0;
+		while (bytesWritten < fileSize)
+		{
+			bytesWritten += co_await source.write(
+				bytesWritten, data.data() + bytesWritten, fileSize - bytesWritten);
+		}
+
+		auto destination = cppcoro::read_write_file::open(io_service(), temp_dir() / "copy.bin");
+
+		// Cancel after the first chunk has been copied.
+		cppcoro::cancellation_source canceller;
+		auto copyOperation = cppcoro::copy_file_with_progress(
+			io_service(), blockingPool, source, destination, 0, fileSize, canceller.token());
+		auto it = co_await copyOperation.begin();
+		REQUIRE(it != copyOperation.end());
+		const std::uint64_t bytesCopied = *it;
+		CHECK(bytesCopied < fileSize);
+
+		canceller.request_cancellation();
+		CHECK_THROWS_AS((void)co_await ++it, const cppcoro::operation_cancelled&);
+		CHECK(destination.size() == bytesCopied);
+	};
+
+	cppcoro::sync_wait(run());
+}
+
+TEST_CASE_FIXTURE(temp_dir_with_io_service_fixture, "copy_file unbuffered")
+{
+	cppcoro::static_thread_pool blockingPool{ 1 };
+
+	auto run = [&]() -> cppcoro::task<>
+	{
+		cppcoro::io_work_scope ioScope{ io_service() };
+
+		// Not a multiple of the block size, so the last chunk can't be read
+		// or written as-is.
+		const std::size_t fileSize = 1024 * 1024 + 3 * 4096 + 123;
+
+		std::vector<unsigned char> data(fileSize);
+		for (std::size_t i = 0; i < fileSize; ++i)
+		{
+			data[i] = static_cast<unsigned char>(i * 11);
+		}
+
+		{
+			auto f = cppcoro::write_only_file::open(io_service(), temp_dir() / "source.bin");
+			std::size_t bytesWritten = 0;
+			while (bytesWritten < fileSize)
+			{
+				bytesWritten += co_await f.write(
+					bytesWritten, data.data() + bytesWritten, fileSize - bytesWritten);
+			}
+		}
+
+		auto source = cppcoro::read_only_file::open(
+			io_service(),
+			temp_dir() / "source.bin",
+			cppcoro::file_share_mode::read,
+			cppcoro::file_buffering_mode::unbuffered);
+		auto destination = cppcoro::write_only_file::open(
+			io_service(),
+			temp_dir() / "copy.bin",
+			cppcoro::file_open_mode::create_always,
+			cppcoro::file_share_mode::none,
+			cppcoro::file_buffering_mode::unbuffered);
+
+		CHECK(co_await cppcoro::copy_file(
+			io_service(), blockingPool, source, destination, 0, fileSize) == fileSize);
+		CHECK(destination.size() == fileSize);
+
+		// Asking for more than the source holds stops at the end of the source.
+		CHECK(co_await cppcoro::copy_file(
+			io_service(), blockingPool, source, destination, 4096, fileSize) == fileSize - 4096);
+		CHECK(destination.size() == fileSize);
+
+		auto copy = cppcoro::read_only_file::open(io_service(), temp_dir() / "copy.bin");
+		std::vector<unsigned char> readBack(fileSize);
+		std::size_t bytesRead = 0;
+		while (bytesRead < fileSize)
+		{
+			bytesRead += co_await copy.read(
+				bytesRead, readBack.data() + bytesRead, fileSize - bytesRead);
+		}
+		CHECK(readBack == data);
+	};
+
+	cppcoro::sync_wait(run());
+}
+
+TEST_CASE_FIXTURE(temp_dir_with_io_service_fixture, "block_cache")
+{
+	auto run = [&]() -> cppcoro::task<>
+	{
+		cppcoro::io_work_scope ioScope{ io_service() };
+
+		const std::size_t fileSize = 10000;
+		std::vector<unsigned char> data(fileSize);
+		for (std::size_t i = 0; i < fileSize; ++i)
+		{
+			data[i] = static_cast<unsigned char>(i * 13);
+		}
+
+		auto f = cppcoro::read_write_file::open(io_service(), temp_dir() / "blocks.bin");
+		std::size_t bytesWritten = 0;
+		while (bytesWritten < fileSize)
+		{
+			bytesWritten += co_await f.write(
+				bytesWritten, data.data() + bytesWritten, fileSize - bytesWritten);
+		}
+
+		// Room for two 4K blocks in a single shard.
+		cppcoro::block_cache cache{ f, 4096, 2, 1 };
+
+		std::vector<unsigned char> buffer(8192);
+
+		// A read spanning two blocks misses on both of them.
+		CHECK(co_await cache.read(100, buffer.data(), 5000) == 5000);
+		CHECK(std::equal(buffer.begin(), buffer.begin() + 5000, data.begin() + 100));
+		CHECK(cache.stats().misses == 2);
+		CHECK(cache.stats().hits == 0);
+
+		// Reading the same range again is served from the cache.
+		CHECK(co_await cache.read(4000, buffer.data(), 200) == 200);
+		CHECK(std::equal(buffer.begin(), buffer.begin() + 200, data.begin() + 4000));
+		CHECK(cache.stats().misses == 2);
+		CHECK(cache.stats().hits == 2);
+
+		// Reads are truncated at the end of the file.
+		CHECK(co_await cache.read(9000, buffer.data(), 4096) == 1000);
+		CHECK(std::equal(buffer.begin(), buffer.begin() + 1000, data.begin() + 9000));
+		CHECK(co_await cache.read(fileSize, buffer.data(), 10) == 0);
+
+		// The cache only holds two blocks so the first block has been evicted.
+		const auto missesBefore = cache.stats().misses;
+		CHECK(co_await cache.read(0, buffer.data(), 10) == 10);
+		CHECK(std::equal(buffer.begin(), buffer.begin() + 10, data.begin()));
+		CHECK(cache.stats().misses == missesBefore + 1);
+	};
+
+	cppcoro::sync_wait(run());
+}
+
+TEST_CASE_FIXTURE(temp_dir_with_io_service_fixture, "block_cache unbuffered")
+{
+	auto run = [&]() -> cppcoro::task<>
+	{
+		cppcoro::io_work_scope ioScope{ io_service() };
+
+		// The last block is only partially filled.
+		const std::size_t fileSize = 2 * 4096 + 1000;
+		std::vector<unsigned char> data(fileSize);
+		for (std::size_t i = 0; i < fileSize; ++i)
+		{
+			data[i] = static_cast<unsigned char>(i * 13);
+		}
+
+		{
+			auto f = cppcoro::write_only_file::open(io_service(), temp_dir() / "blocks.bin");
+			co_await f.write(0, data.data(), fileSize);
+		}
+
+		auto f = cppcoro::read_only_file::open(
+			io_service(),
+			temp_dir() / "blocks.bin",
+			cppcoro::file_share_mode::read,
+			cppcoro::file_buffering_mode::unbuffered);
+
+		cppcoro::block_cache cache{ f, 4096, 4, 1 };
+
+		std::vector<unsigned char> buffer(4096);
+		CHECK(co_await cache.read(2 * 4096 + 10, buffer.data(), 4096) == 990);
+		CHECK(std::equal(buffer.begin(), buffer.begin() + 990, data.begin() + 2 * 4096 + 10));
+		CHECK(co_await cache.read(100, buffer.data(), 200) == 200);
+		CHECK(std::equal(buffer.begin(), buffer.begin() + 200, data.begin() + 100));
+	};
+
+	cppcoro::sync_wait(run());
+}
+
+TEST_CASE_FIXTURE(temp_dir_with_io_service_fixture, "block_cache coalesces concurrent reads of a block")
+{
+	auto run = [&]() -> cppcoro::task<>
+	{
+		cppcoro::io_work_scope ioScope{ io_service() };
+
+		std::vector<unsigned char> data(4096, 0x5A);
+		auto f = cppcoro::read_write_file::open(io_service(), temp_dir() / "blocks.bin");
+		CHECK(co_await f.write(0, data.data(), data.size()) == data.size());
+
+		cppcoro::block_cache cache{ f, 4096, 16 };
+
+		auto readByte = [&](std::uint64_t offset) -> cppcoro::task<unsigned char>
+		{
+			unsigned char value = 0;
+			CHECK(co_await cache.read(offset, &value, 1) == 1);
+			co_return value;
+		};
+
+		std::vector<cppcoro::task<unsigned char>> reads;
+		for (std::uint64_t i = 0; i < 10; ++i)
+		{
+			reads.push_back(readByte(i * 100));
+		}
+
+		const auto values = co_await cppcoro::when_all(std::move(reads));
+		CHECK(std::all_of(values.begin(), values.end(), [](auto b) { return b == 0x5A; }));
+
+		// Only the first read goes to the file. Depending on how quickly that
+		// read completes the others either wait for it or hit the cached block.
+		const auto stats = cache.stats();
+		CHECK(stats.misses == 1);
+		CHECK(stats.hits + stats.coalesced == 9);
+	};
+
+	cppcoro::sync_wait(run());
+}
+
+TEST_CASE_FIXTURE(temp_dir_with_io_service_fixture, "append_log group commit")
+{
+	const auto logPath = temp_dir() / "log.dat";
+
+	constexpr std::size_t recordSize = 16;
+	constexpr int writerCount = 50;
+
+	cppcoro::sync_wait([&]() -> cppcoro::task<>
+	{
+		cppcoro::io_work_scope ioScope{ io_service() };
+
+		std::vector<std::uint64_t> offsets(writerCount);
+
+		{
+			auto log = cppcoro::append_log::open(io_service(), logPath, 0, 64 * 1024);
+
+			auto writer = [&](int id) -> cppcoro::task<>
+			{
+				co_await io_service().schedule();
+
+				char record[recordSize];
+				std::memset(record, 'a' + (id % 26), recordSize);
+				offsets[id] = co_await log.append(record, recordSize);
+			};
+
+			std::vector<cppcoro::task<>> writers;
+			for (int i = 0; i < writerCount; ++i)
+			{
+				writers.push_back(writer(i));
+			}
+
+			co_await cppcoro::when_all(std::move(writers));
+
+			CHECK(log.write_offset() == writerCount * recordSize);
+		}
+
+		// Every record landed at a distinct offset and the log has no gaps.
+		auto sortedOffsets = offsets;
+		std::sort(sortedOffsets.begin(), sortedOffsets.end());
+		for (int i = 0; i < writerCount; ++i)
+		{
+			CHECK(sortedOffsets[i] == i * recordSize);
+		}
+
+		auto f = cppcoro::read_only_file::open(io_service(), logPath);
+		CHECK(f.size() == 64 * 1024);
+
+		for (int id = 0; id < writerCount; ++id)
+		{
+			char record[recordSize];
+			CHECK(co_await f.read(offsets[id], record, recordSize) == recordSize);
+			for (char c : record)
+			{
+				CHECK(c == 'a' + (id % 26));
+			}
+		}
+	}());
+}
+
 TEST_SUITE_END();
@@ -0,0 +1,148 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/io_service_group.hpp>
+#include <cppcoro/async_scope.hpp>
+#include <cppcoro/cancellation_source.hpp>
+#include <cppcoro/on_scope_exit.hpp>
+#include <cppcoro/operation_cancelled.hpp>
+#include <cppcoro/sync_wait.hpp>
+#include <cppcoro/task.hpp>
+#include <cppcoro/when_all.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#if CPPCORO_OS_LINUX
+# include <sched.h>
+#endif
+
+#include <ostream>
+#include "doctest/cppcoro_doctest.h"
+
+using namespace cppcoro;
+using namespace cppcoro::net;
+
+TEST_SUITE_BEGIN("io_service_group");
+
+TEST_CASE("each shard runs work on its own thread")
+{
+	io_service_group group{ 3 };
+	REQUIRE(group.size() == 3);
+
+	auto threadOf = [&](std::uint32_t index) -> task<std::thread::id>
+	{
+		co_await group[index].schedule();
+		co_return std::this_thread::get_id();
+	};
+
+	auto [a, b, c, a2] = sync_wait(when_all(threadOf(0), threadOf(1), threadOf(2), threadOf(0)));
+	CHECK(a != b);
+	CHECK(b != c);
+	CHECK(a != c);
+	CHECK(a == a2);
+	CHECK(a != std::this_thread::get_id());
+}
+
+#if CPPCORO_OS_LINUX
+TEST_CASE("shard threads are pinned to their CPU")
+{
+	io_service_group group;
+	REQUIRE(group.size() >= 1);
+
+	for (std::uint32_t i = 0; i < group.size(); ++i)
+	{
+		if (group.cpu(i) < 0)
+		{
+			continue;
+		}
+
+		const int cpu = sync_wait([&]() -> task<int>
+		{
+			co_await group[i].schedule();
+			co_return ::sched_getcpu();
+		}());
+		CHECK(cpu == group.cpu(i));
+	}
+}
+
+TEST_CASE("create_listening_sockets accepts on every shard")
+{
+	io_service_group group{ 2 };
+
+	auto listeners = group.create_listening_sockets(ipv4_endpoint{ ipv4_address::loopback(), 0 });
+	REQUIRE(listeners.size() == 2);
+	CHECK(listeners[0].local_endpoint().to_ipv4().port() != 0);
+	CHECK(listeners[0].local_endpoint() == listeners[1].local_endpoint());
+
+	constexpr int connectionCount = 16;
+
+	std::atomic<int> acceptedCount = 0;
+	cancellation_source canceller;
+
+	auto acceptOnShard = [&](std::uint32_t index) -> task<>
+	{
+		co_await group[index].schedule();
+		const auto shardThread = std::this_thread::get_id();
+
+		try
+		{
+			auto connections = listeners[index].accept_stream(group[index], canceller.token());
+			auto it = co_await connections.begin();
+			while (it != connections.end())
+			{
+				// The connection stays on the shard that accepted it.
+				CHECK(std::this_thread::get_id() == shardThread);
+				++acceptedCount;
+				(void)co_await ++it;
+			}
+		}
+		catch (const operation_cancelled&)
+		{
+		}
+	};
+
+	io_service clientService;
+
+	auto connectClients = [&]() -> task<>
+	{
+		std::vector<socket> clients;
+		for (int i = 0; i < connectionCount; ++i)
+		{
+			auto s = socket::create_tcpv4(clientService);
+			s.bind(ipv4_endpoint{});
+			co_await s.connect(listeners[0].local_endpoint());
+			clients.push_back(std::move(s));
+		}
+
+		while (acceptedCount.load() < connectionCount)
+		{
+			co_await clientService.schedule_after(std::chrono::milliseconds{ 1 });
+		}
+
+		canceller.request_cancellation();
+	};
+
+	(void)sync_wait(when_all(
+		acceptOnShard(0),
+		acceptOnShard(1),
+		[&]() -> task<>
+		{
+			auto stopOnExit = on_scope_exit([&] { clientService.stop(); });
+			co_await connectClients();
+		}(),
+		[&]() -> task<>
+		{
+			clientService.process_events();
+			co_return;
+		}()));
+
+	CHECK(acceptedCount.load() == connectionCount);
+}
+#endif
+
+TEST_SUITE_END();
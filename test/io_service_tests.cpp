@@ -92,6 +92,235 @@ TEST_CASE_FIXTURE(io_service_fixture_with_threads<2>, "multiple I/O threads serv
 	CHECK(completedCount == 1000);
 }
 
+TEST_CASE_FIXTURE(io_service_fixture_with_threads<1>, "rescheduling from an I/O thread does not starve other events")
+{
+	std::atomic<bool> done = false;
+	std::uint32_t yieldCount = 0;
+
+	auto yieldUntilDone = [&]() -> cppcoro::task<>
+	{
+		co_await io_service().schedule();
+		while (!done.load())
+		{
+			co_await io_service().schedule();
+			++yieldCount;
+		}
+	};
+
+	auto finishFromIoThread = [&]() -> cppcoro::task<>
+	{
+		using namespace std::literals::chrono_literals;
+		co_await io_service().schedule_after(1ms);
+		done = true;
+	};
+
+	cppcoro::sync_wait(cppcoro::when_all(yieldUntilDone(), finishFromIoThread()));
+
+	CHECK(yieldCount > 0);
+}
+
+TEST_CASE("operations rescheduled during process_one_event are not lost")
+{
+	cppcoro::io_service service;
+
+	int step = 0;
+	auto yieldTwice = [&]() -> cppcoro::task<>
+	{
+		co_await service.schedule();
+		step = 1;
+		co_await service.schedule();
+		step = 2;
+	};
+
+	cppcoro::sync_wait(cppcoro::when_all_ready(
+		yieldTwice(),
+		[&]() -> cppcoro::task<>
+		{
+			CHECK(service.process_one_event() == 1);
+			CHECK(step == 1);
+			CHECK(service.process_one_pending_event() == 1);
+			CHECK(step == 2);
+			co_return;
+		}()));
+}
+
+TEST_CASE("busy-polling event loop services schedule, timers and stop")
+{
+	using namespace std::literals::chrono_literals;
+
+	cppcoro::io_service ioService;
+	CHECK(ioService.busy_poll_duration() == 0us);
+
+	ioService.set_busy_poll_duration(-5us);
+	CHECK(ioService.busy_poll_duration() == 0us);
+
+	ioService.set_busy_poll_duration(2ms);
+	CHECK(ioService.busy_poll_duration() == 2ms);
+
+	std::thread ioThread{ [&] { ioService.process_events(); } };
+	auto joinOnExit = cppcoro::on_scope_exit([&]
+	{
+		ioService.stop();
+		ioThread.join();
+	});
+
+	auto runOnIoThread = [&]() -> cppcoro::task<std::thread::id>
+	{
+		co_await ioService.schedule();
+		co_return std::this_thread::get_id();
+	};
+
+	auto sleepOnIoThread = [&]() -> cppcoro::task<std::thread::id>
+	{
+		// Longer than the busy-poll duration so the thread blocks first.
+		co_await ioService.schedule_after(10ms);
+		co_return std::this_thread::get_id();
+	};
+
+	for (int i = 0; i < 100; ++i)
+	{
+		CHECK(cppcoro::sync_wait(runOnIoThread()) == ioThread.get_id());
+	}
+
+	CHECK(cppcoro::sync_wait(sleepOnIoThread()) == ioThread.get_id());
+}
+
+namespace
+{
+	std::uint64_t sample_count(const cppcoro::io_service_stats::histogram& h)
+	{
+		std::uint64_t count = 0;
+		for (auto bucket : h)
+		{
+			count += bucket;
+		}
+		return count;
+	}
+}
+
+TEST_CASE("io_service_stats::bucket_index")
+{
+	using stats = cppcoro::io_service_stats;
+	CHECK(stats::bucket_index(0) == 0);
+	CHECK(stats::bucket_index(1) == 1);
+	CHECK(stats::bucket_index(2) == 2);
+	CHECK(stats::bucket_index(3) == 2);
+	CHECK(stats::bucket_index(4) == 3);
+	CHECK(stats::bucket_index(~std::uint64_t(0)) == 64);
+}
+
+TEST_CASE("instrumentation is disabled by default")
+{
+	cppcoro::io_service service;
+	CHECK_FALSE(service.is_instrumentation_enabled());
+
+	cppcoro::io_work_scope work{ service };
+
+	cppcoro::sync_wait(cppcoro::when_all_ready(
+		[&]() -> cppcoro::task<>
+		{
+			co_await service.schedule();
+		}(),
+		[&]() -> cppcoro::task<>
+		{
+			service.process_pending_events();
+			co_return;
+		}()));
+
+	const auto stats = service.instrumentation_snapshot();
+	CHECK(sample_count(stats.schedule_latency_ns) == 0);
+	CHECK(sample_count(stats.event_processing_time_ns) == 0);
+	CHECK(stats.pending_timer_count == 0);
+	CHECK(stats.work_count == 1);
+}
+
+TEST_CASE("instrumentation records schedule latency and event processing time")
+{
+	using namespace std::literals::chrono_literals;
+
+	cppcoro::io_service service;
+	service.set_instrumentation_enabled(true);
+	CHECK(service.is_instrumentation_enabled());
+
+	constexpr int coroutineCount = 10;
+
+	auto yieldOnce = [&]() -> cppcoro::task<>
+	{
+		co_await service.schedule();
+	};
+
+	auto stall = [&]() -> cppcoro::task<>
+	{
+		co_await service.schedule();
+		std::this_thread::sleep_for(2ms);
+	};
+
+	std::vector<cppcoro::task<>> tasks;
+	for (int i = 0; i < coroutineCount; ++i)
+	{
+		tasks.push_back(yieldOnce());
+	}
+	tasks.push_back(stall());
+
+	cppcoro::sync_wait(cppcoro::when_all_ready(
+		cppcoro::when_all(std::move(tasks)),
+		[&]() -> cppcoro::task<>
+		{
+			service.process_pending_events();
+			co_return;
+		}()));
+
+	const auto stats = service.instrumentation_snapshot();
+	CHECK(sample_count(stats.schedule_latency_ns) == coroutineCount + 1);
+	CHECK(sample_count(stats.event_processing_time_ns) == coroutineCount + 1);
+
+	// The stalled coroutine shows up in the tail of the processing time.
+	const auto stallBucket = cppcoro::io_service_stats::bucket_index(1'000'000);
+	std::uint64_t slowEvents = 0;
+	for (auto i = stallBucket; i < stats.event_processing_time_ns.size(); ++i)
+	{
+		slowEvents += stats.event_processing_time_ns[i];
+	}
+	CHECK(slowEvents >= 1);
+
+	service.set_instrumentation_enabled(false);
+	CHECK_FALSE(service.is_instrumentation_enabled());
+	CHECK(sample_count(service.instrumentation_snapshot().schedule_latency_ns) == coroutineCount + 1);
+}
+
+TEST_CASE_FIXTURE(io_service_fixture_with_threads<1>, "instrumentation counts pending timers and wake-ups")
+{
+	using namespace std::literals::chrono_literals;
+
+	io_service().set_instrumentation_enabled(true);
+
+	cppcoro::cancellation_source canceller;
+
+	auto longTimer = [&]() -> cppcoro::task<>
+	{
+		try
+		{
+			co_await io_service().schedule_after(10s, canceller.token());
+		}
+		catch (const cppcoro::operation_cancelled&)
+		{
+		}
+	};
+
+	auto checkThenCancel = [&]() -> cppcoro::task<>
+	{
+		co_await io_service().schedule_after(1ms);
+		CHECK(io_service().instrumentation_snapshot().pending_timer_count == 1);
+		canceller.request_cancellation();
+	};
+
+	cppcoro::sync_wait(cppcoro::when_all(longTimer(), checkThenCancel()));
+
+	const auto stats = io_service().instrumentation_snapshot();
+	CHECK(stats.pending_timer_count == 0);
+	CHECK(sample_count(stats.events_per_wake_up) >= 1);
+}
+
 TEST_CASE("Multiple concurrent timers")
 {
 	cppcoro::io_service ioService;
@@ -6,6 +6,8 @@
 #include <cppcoro/config.hpp>
 #include <cppcoro/net/ip_endpoint.hpp>
 
+#include <string_view>
+
 #include "doctest/cppcoro_doctest.h"
 
 TEST_SUITE_BEGIN("ip_endpoint");
@@ -36,6 +38,37 @@ TEST_CASE("to_string" * doctest::skip{ isMsvc15_5X86Optimised })
 	CHECK(b.to_string() == "[2001:db8:85a3::8a2e:370:7334]:22");
 }
 
+TEST_CASE("to_chars" * doctest::skip{ isMsvc15_5X86Optimised })
+{
+	char buffer[ip_endpoint::max_string_length];
+
+	auto format = [&](const ip_endpoint& endpoint, std::size_t size)
+	{
+		const auto result = endpoint.to_chars(buffer, buffer + size);
+		return result.ec == std::errc{} ?
+			std::string_view(buffer, result.ptr - buffer) :
+			std::string_view("<too large>");
+	};
+
+	const ip_endpoint longestV4 = ipv4_endpoint{ ipv4_address{ 255, 255, 255, 255 }, 65535 };
+	const ip_endpoint longestV6 = ipv6_endpoint{
+		ipv6_address{ 0x1111222233334444, 0x5555666677778888 },
+		65535 };
+
+	CHECK(format(longestV4, sizeof(buffer)) == "255.255.255.255:65535");
+	CHECK(format(longestV4, ipv4_endpoint::max_string_length) == "255.255.255.255:65535");
+	CHECK(format(longestV4, ipv4_endpoint::max_string_length - 1) == "<too large>");
+
+	CHECK(format(longestV6, sizeof(buffer)) == "[1111:2222:3333:4444:5555:6666:7777:8888]:65535");
+	CHECK(format(longestV6, ipv6_endpoint::max_string_length - 1) == "<too large>");
+
+	const ip_endpoint shortV6 = ipv6_endpoint{ ipv6_address::loopback(), 1 };
+	CHECK(format(shortV6, 7) == "[::1]:1");
+	CHECK(format(shortV6, 6) == "<too large>");
+	CHECK(format(shortV6, 5) == "<too large>");
+	CHECK(format(shortV6, 0) == "<too large>");
+}
+
 TEST_CASE("from_string" * doctest::skip{ isMsvc15_5X86Optimised })
 {
 	CHECK(ip_endpoint::from_string("") == std::nullopt);
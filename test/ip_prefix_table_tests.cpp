@@ -0,0 +1,249 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/net/ip_prefix_table.hpp>
+
+#include <atomic>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "doctest/cppcoro_doctest.h"
+
+TEST_SUITE_BEGIN("ip_prefix_table");
+
+using namespace cppcoro::net;
+
+namespace
+{
+	ip_prefix prefix(std::string_view string)
+	{
+		return *ip_prefix::from_string(string);
+	}
+
+	ip_address address(std::string_view string)
+	{
+		return *ip_address::from_string(string);
+	}
+}
+
+TEST_CASE("empty table")
+{
+	ip_prefix_table<int> table;
+	CHECK(table.current()->empty());
+	CHECK(table.lookup(address("10.0.0.1")) == std::nullopt);
+	CHECK(table.lookup(address("::1")) == std::nullopt);
+}
+
+TEST_CASE("lookup finds the longest matching prefix")
+{
+	ip_prefix_table<std::string> table{ {
+		{ prefix("10.0.0.0/8"), "10/8" },
+		{ prefix("10.1.0.0/16"), "10.1/16" },
+		{ prefix("10.1.2.0/24"), "10.1.2/24" },
+		{ prefix("10.1.2.3/32"), "host" },
+		{ prefix("192.168.0.0/16"), "192.168/16" },
+		{ prefix("2001:db8::/32"), "doc" },
+		{ prefix("2001:db8:1::/48"), "doc:1" },
+	} };
+
+	CHECK(table.lookup(address("10.200.0.1")) == "10/8");
+	CHECK(table.lookup(address("10.1.200.1")) == "10.1/16");
+	CHECK(table.lookup(address("10.1.2.200")) == "10.1.2/24");
+	CHECK(table.lookup(address("10.1.2.3")) == "host");
+	CHECK(table.lookup(address("192.168.10.1")) == "192.168/16");
+	CHECK(table.lookup(address("11.0.0.1")) == std::nullopt);
+	CHECK(table.lookup(address("192.169.0.0")) == std::nullopt);
+
+	CHECK(table.lookup(address("2001:db8:2::1")) == "doc");
+	CHECK(table.lookup(address("2001:db8:1:ffff::1")) == "doc:1");
+	CHECK(table.lookup(address("2001:db9::")) == std::nullopt);
+
+	// IPv4 prefixes don't match IPv6 addresses, even ones with the same bits.
+	CHECK(table.lookup(address("a01:203::")) == std::nullopt);
+
+	auto snapshot = table.current();
+	const auto* entry = snapshot->longest_match(address("10.1.9.9"));
+	REQUIRE(entry != nullptr);
+	CHECK(entry->first == prefix("10.1.0.0/16"));
+	CHECK(snapshot->find(prefix("10.1.0.0/16")) != nullptr);
+	CHECK(snapshot->find(prefix("10.1.0.0/17")) == nullptr);
+}
+
+TEST_CASE("zero-length prefixes match every address of their family")
+{
+	ip_prefix_table<int> table{ {
+		{ prefix("0.0.0.0/0"), 4 },
+		{ prefix("::/0"), 6 },
+		{ prefix("128.0.0.0/1"), 1 },
+	} };
+
+	CHECK(table.lookup(address("1.2.3.4")) == 4);
+	CHECK(table.lookup(address("200.2.3.4")) == 1);
+	CHECK(table.lookup(address("::1")) == 6);
+}
+
+TEST_CASE("the last of duplicate prefixes wins")
+{
+	ip_prefix_table<int> table{ {
+		{ prefix("10.0.0.0/8"), 1 },
+		{ prefix("10.1.2.3/8"), 2 },
+		{ prefix("10.0.0.0/8"), 3 },
+	} };
+
+	CHECK(table.current()->size() == 1);
+	CHECK(table.lookup(address("10.0.0.1")) == 3);
+}
+
+TEST_CASE("updates publish a new snapshot")
+{
+	ip_prefix_table<int> table;
+
+	table.insert_or_assign(prefix("10.0.0.0/8"), 1);
+	auto before = table.current();
+
+	table.insert_or_assign(prefix("10.1.0.0/16"), 2);
+	table.insert_or_assign(prefix("10.0.0.0/8"), 3);
+	CHECK(table.lookup(address("10.1.0.1")) == 2);
+	CHECK(table.lookup(address("10.2.0.1")) == 3);
+
+	// An existing snapshot is unaffected by the updates.
+	REQUIRE(before->lookup(address("10.1.0.1")) != nullptr);
+	CHECK(*before->lookup(address("10.1.0.1")) == 1);
+	CHECK(before->size() == 1);
+
+	CHECK(table.erase(prefix("10.1.0.0/16")));
+	CHECK(!table.erase(prefix("10.1.0.0/16")));
+	CHECK(table.lookup(address("10.1.0.1")) == 3);
+
+	table.update([](std::vector<ip_prefix_table<int>::value_type>& entries)
+	{
+		entries.clear();
+		entries.emplace_back(prefix("172.16.0.0/12"), 4);
+		entries.emplace_back(prefix("fc00::/7"), 5);
+	});
+	CHECK(table.lookup(address("10.1.0.1")) == std::nullopt);
+	CHECK(table.lookup(address("172.31.255.255")) == 4);
+	CHECK(table.lookup(address("fd00::1")) == 5);
+
+	table.clear();
+	CHECK(table.current()->empty());
+}
+
+TEST_CASE("lookup matches a linear scan")
+{
+	std::mt19937_64 random{ 1234 };
+
+	// Draw prefixes from a few clusters so that there are plenty of nested
+	// and diverging prefixes, rather than mostly disjoint ones.
+	const std::uint64_t clusters[] = { 0x20010db800000000, 0x20010db8ff000000, 0xfd00000000000000 };
+	auto randomAddress = [&](bool ipv4) -> ip_address
+	{
+		if (ipv4)
+		{
+			return ipv4_address{ static_cast<std::uint32_t>((random() & 0x0303FFFF) | 0x0A000000) };
+		}
+
+		return ipv6_address{ clusters[random() % 3] ^ (random() & 0x00000000FFFFFFFF), random() & 0xFF };
+	};
+
+	std::vector<ip_prefix_table<std::size_t>::value_type> entries;
+	for (std::size_t i = 0; i < 2000; ++i)
+	{
+		const bool ipv4 = (i % 2) == 0;
+		const auto length = static_cast<std::uint8_t>(random() % (ipv4 ? 33 : 129));
+		entries.emplace_back(ip_prefix{ randomAddress(ipv4), length }, i);
+	}
+
+	ip_prefix_table<std::size_t> table{ entries };
+	auto snapshot = table.current();
+
+	for (int i = 0; i < 5000; ++i)
+	{
+		const ip_address a = randomAddress((i % 2) == 0);
+
+		// The last of the longest matching prefixes.
+		const ip_prefix_table<std::size_t>::value_type* expected = nullptr;
+		for (const auto& entry : entries)
+		{
+			if (entry.first.contains(a) &&
+				(expected == nullptr || entry.first.length() >= expected->first.length()))
+			{
+				expected = &entry;
+			}
+		}
+
+		const auto* actual = snapshot->longest_match(a);
+		REQUIRE((actual == nullptr) == (expected == nullptr));
+		if (expected != nullptr)
+		{
+			CHECK(actual->first == expected->first);
+			CHECK(actual->second == expected->second);
+		}
+	}
+}
+
+TEST_CASE("reader only reloads the snapshot after an update")
+{
+	ip_prefix_table<int> table{ { { prefix("10.0.0.0/8"), 1 } } };
+	ip_prefix_table<int>::reader reader{ table };
+
+	const auto* first = &reader.get();
+	CHECK(reader.lookup(address("10.1.2.3")) != nullptr);
+	CHECK(*reader.lookup(address("10.1.2.3")) == 1);
+	CHECK(&reader.get() == first);
+
+	table.insert_or_assign(prefix("10.1.0.0/16"), 2);
+	CHECK(&reader.get() != first);
+	CHECK(*reader.lookup(address("10.1.2.3")) == 2);
+	CHECK(*reader.lookup(address("10.2.0.0")) == 1);
+
+	table.clear();
+	CHECK(reader.lookup(address("10.1.2.3")) == nullptr);
+}
+
+TEST_CASE("lookups run concurrently with updates")
+{
+	ip_prefix_table<int> table{ { { prefix("10.0.0.0/8"), 0 } } };
+
+	std::atomic<bool> done = false;
+	std::thread reader{ [&]
+	{
+		int lastSeen = 0;
+		while (!done.load(std::memory_order_relaxed))
+		{
+			const int value = table.lookup(address("10.1.2.3")).value_or(-1);
+			CHECK(value >= lastSeen);
+			lastSeen = value;
+		}
+	} };
+
+	std::thread cachingReader{ [&]
+	{
+		ip_prefix_table<int>::reader r{ table };
+		int lastSeen = 0;
+		while (!done.load(std::memory_order_relaxed))
+		{
+			const int* value = r.lookup(address("10.1.2.3"));
+			REQUIRE(value != nullptr);
+			CHECK(*value >= lastSeen);
+			lastSeen = *value;
+		}
+	} };
+
+	for (int i = 1; i <= 200; ++i)
+	{
+		table.insert_or_assign(prefix("10.0.0.0/8"), i);
+	}
+
+	done = true;
+	reader.join();
+	cachingReader.join();
+
+	CHECK(table.lookup(address("10.1.2.3")) == 200);
+}
+
+TEST_SUITE_END();
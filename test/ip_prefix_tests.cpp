@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/net/ip_prefix.hpp>
+
+#include "doctest/cppcoro_doctest.h"
+
+TEST_SUITE_BEGIN("ip_prefix");
+
+using cppcoro::net::ip_address;
+using cppcoro::net::ip_prefix;
+using cppcoro::net::ipv4_address;
+using cppcoro::net::ipv6_address;
+
+TEST_CASE("default constructor")
+{
+	ip_prefix x;
+	CHECK(x.is_ipv4());
+	CHECK(x.length() == 0);
+	CHECK(x.contains(ipv4_address{ 1, 2, 3, 4 }));
+	CHECK(!x.contains(ipv6_address::loopback()));
+}
+
+TEST_CASE("host bits are cleared")
+{
+	CHECK(ip_prefix{ ipv4_address{ 10, 1, 2, 3 }, 8 }.address() == ipv4_address(10, 0, 0, 0));
+	CHECK(ip_prefix{ ipv4_address{ 10, 1, 2, 3 }, 12 }.address() == ipv4_address(10, 0, 0, 0));
+	CHECK(ip_prefix{ ipv4_address{ 10, 31, 2, 3 }, 12 }.address() == ipv4_address(10, 16, 0, 0));
+	CHECK(ip_prefix{ ipv4_address{ 10, 1, 2, 3 }, 32 }.address() == ipv4_address(10, 1, 2, 3));
+	CHECK(
+		ip_prefix{ ipv6_address{ 0x20010db8ffffffff, 0xffffffffffffffff }, 65 }.address() ==
+		ipv6_address(0x20010db8ffffffff, 0x8000000000000000));
+	CHECK(ip_prefix{ ipv4_address{ 10, 1, 2, 3 }, 8 } == ip_prefix{ ipv4_address{ 10, 0, 0, 0 }, 8 });
+}
+
+TEST_CASE("contains")
+{
+	const ip_prefix v4{ ipv4_address{ 192, 168, 0, 0 }, 16 };
+	CHECK(v4.contains(ipv4_address{ 192, 168, 0, 0 }));
+	CHECK(v4.contains(ipv4_address{ 192, 168, 255, 255 }));
+	CHECK(!v4.contains(ipv4_address{ 192, 169, 0, 0 }));
+	CHECK(!v4.contains(ipv6_address{}));
+
+	const ip_prefix v6{ ipv6_address{ 0x20010db800000000, 0 }, 32 };
+	CHECK(v6.contains(ipv6_address{ 0x20010db8ffffffff, 1 }));
+	CHECK(!v6.contains(ipv6_address{ 0x20010db900000000, 0 }));
+	CHECK(!v6.contains(ipv4_address{}));
+}
+
+TEST_CASE("to_string")
+{
+	CHECK(ip_prefix{ ipv4_address{ 10, 0, 0, 0 }, 8 }.to_string() == "10.0.0.0/8");
+	CHECK(ip_prefix{ ipv6_address{ 0x20010db800000000, 0 }, 32 }.to_string() == "2001:db8::/32");
+	CHECK(ip_prefix{ ipv6_address{}, 0 }.to_string() == "::/0");
+
+	char buffer[ip_prefix::max_string_length];
+	const ip_prefix longest{ ipv6_address{ 0x1111222233334444, 0x5555666677778888 }, 128 };
+	auto result = longest.to_chars(buffer, buffer + sizeof(buffer));
+	CHECK(result.ec == std::errc{});
+	CHECK(std::string(buffer, result.ptr) == "1111:2222:3333:4444:5555:6666:7777:8888/128");
+
+	result = longest.to_chars(buffer, buffer + sizeof(buffer) - 1);
+	CHECK(result.ec == std::errc::value_too_large);
+}
+
+TEST_CASE("from_string")
+{
+	CHECK(ip_prefix::from_string("") == std::nullopt);
+	CHECK(ip_prefix::from_string("10.0.0.0") == std::nullopt);
+	CHECK(ip_prefix::from_string("10.0.0.0/") == std::nullopt);
+	CHECK(ip_prefix::from_string("/8") == std::nullopt);
+	CHECK(ip_prefix::from_string("10.0.0.0/33") == std::nullopt);
+	CHECK(ip_prefix::from_string("10.0.0.0/08") == std::nullopt);
+	CHECK(ip_prefix::from_string("10.0.0.0/+8") == std::nullopt);
+	CHECK(ip_prefix::from_string("10.0.0.0/8 ") == std::nullopt);
+	CHECK(ip_prefix::from_string("10.0.0.0/8/8") == std::nullopt);
+	CHECK(ip_prefix::from_string("::/129") == std::nullopt);
+
+	CHECK(ip_prefix::from_string("0.0.0.0/0") == ip_prefix{});
+	CHECK(ip_prefix::from_string("10.1.2.3/8") == ip_prefix{ ipv4_address{ 10, 0, 0, 0 }, 8 });
+	CHECK(ip_prefix::from_string("10.1.2.3/32") == ip_prefix{ ipv4_address{ 10, 1, 2, 3 }, 32 });
+	CHECK(
+		ip_prefix::from_string("2001:db8::/32") ==
+		ip_prefix{ ipv6_address{ 0x20010db800000000, 0 }, 32 });
+	CHECK(ip_prefix::from_string("::1/128") == ip_prefix{ ipv6_address::loopback(), 128 });
+}
+
+TEST_CASE("operator<")
+{
+	const ip_prefix a = *ip_prefix::from_string("10.0.0.0/8");
+	const ip_prefix b = *ip_prefix::from_string("10.0.0.0/16");
+	const ip_prefix c = *ip_prefix::from_string("10.1.0.0/16");
+	const ip_prefix d = *ip_prefix::from_string("::/0");
+
+	CHECK(a < b);
+	CHECK(b < c);
+	CHECK(c < d);
+	CHECK(a <= a);
+	CHECK(d > a);
+}
+
+TEST_SUITE_END();
@@ -5,6 +5,8 @@
 
 #include <cppcoro/net/ipv4_address.hpp>
 
+#include <string_view>
+
 #include "doctest/cppcoro_doctest.h"
 
 
@@ -47,6 +49,24 @@ TEST_CASE("to_string()")
 	CHECK(ipv4_address(123, 234, 101, 255).to_string() == "123.234.101.255");
 }
 
+TEST_CASE("to_chars()")
+{
+	char buffer[ipv4_address::max_string_length];
+
+	auto result = ipv4_address(255, 255, 255, 255).to_chars(buffer, buffer + sizeof(buffer));
+	CHECK(result.ec == std::errc{});
+	CHECK(std::string_view(buffer, result.ptr - buffer) == "255.255.255.255");
+
+	// A buffer that is smaller than max_string_length but large enough.
+	result = ipv4_address(10, 0, 0, 1).to_chars(buffer, buffer + 8);
+	CHECK(result.ec == std::errc{});
+	CHECK(std::string_view(buffer, result.ptr - buffer) == "10.0.0.1");
+
+	result = ipv4_address(10, 0, 0, 1).to_chars(buffer, buffer + 7);
+	CHECK(result.ec == std::errc::value_too_large);
+	CHECK(result.ptr == buffer + 7);
+}
+
 TEST_CASE("from_string")
 {
 	// Check for some invalid strings.
@@ -86,5 +106,21 @@ TEST_CASE("from_string")
 	CHECK(ipv4_address::from_string("45.25.67.30") == ipv4_address(45, 25, 67, 30));
 	CHECK(ipv4_address::from_string("0.0.0.0") == ipv4_address(0, 0, 0, 0));
 	CHECK(ipv4_address::from_string("1.2.3.4") == ipv4_address(1, 2, 3, 4));
+	CHECK(ipv4_address::from_string("255.255.255.255") == ipv4_address(255, 255, 255, 255));
+}
+
+TEST_CASE("from_string rejects malformed dotted decimal")
+{
+	CHECK(ipv4_address::from_string("1..2.3") == std::nullopt);
+	CHECK(ipv4_address::from_string(".1.2.3") == std::nullopt);
+	CHECK(ipv4_address::from_string("1.2.3.4.5") == std::nullopt);
+	CHECK(ipv4_address::from_string("1.2.3.a") == std::nullopt);
+	CHECK(ipv4_address::from_string("1.2.3.4/") == std::nullopt);
+	CHECK(ipv4_address::from_string("1.2:3.4") == std::nullopt);
+	CHECK(ipv4_address::from_string("1.2.3.1234") == std::nullopt);
+	CHECK(ipv4_address::from_string("1234.2.3.4") == std::nullopt);
+	CHECK(ipv4_address::from_string("255.255.255.2555") == std::nullopt);
+	CHECK(ipv4_address::from_string(std::string_view("1.2.3.4\0", 8)) == std::nullopt);
+	CHECK(ipv4_address::from_string("1.2.3.\xB4") == std::nullopt);
 }
 TEST_SUITE_END();
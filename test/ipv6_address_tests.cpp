@@ -5,6 +5,8 @@
 
 #include <cppcoro/net/ipv6_address.hpp>
 
+#include <string_view>
+
 #include "doctest/cppcoro_doctest.h"
 
 
@@ -59,6 +61,26 @@ TEST_CASE("to_string")
 		"102:304::90a:b0c:0:0");
 }
 
+TEST_CASE("to_chars")
+{
+	char buffer[ipv6_address::max_string_length];
+
+	const ipv6_address full(0x1111222233334444, 0x5555666677778888);
+	auto result = full.to_chars(buffer, buffer + sizeof(buffer));
+	CHECK(result.ec == std::errc{});
+	CHECK(std::string_view(buffer, result.ptr - buffer) == "1111:2222:3333:4444:5555:6666:7777:8888");
+
+	result = full.to_chars(buffer, buffer + sizeof(buffer) - 1);
+	CHECK(result.ec == std::errc::value_too_large);
+
+	result = ipv6_address::loopback().to_chars(buffer, buffer + 3);
+	CHECK(result.ec == std::errc{});
+	CHECK(std::string_view(buffer, result.ptr - buffer) == "::1");
+
+	result = ipv6_address::loopback().to_chars(buffer, buffer + 2);
+	CHECK(result.ec == std::errc::value_too_large);
+}
+
 TEST_CASE("from_string")
 {
 	CHECK(ipv6_address::from_string("") == std::nullopt);
@@ -107,6 +129,26 @@ TEST_CASE("from_string")
 	CHECK(
 		ipv6_address::from_string("2001:db8:85a3:8d3:1319:8a2e:370:7348") ==
 		ipv6_address(0x20010db885a308d3, 0x13198a2e03707348));
+	CHECK(
+		ipv6_address::from_string("2001:DB8:85A3:8d3:1319:8A2E:370:7348") ==
+		ipv6_address(0x20010db885a308d3, 0x13198a2e03707348));
+}
+
+TEST_CASE("from_string double colon placement")
+{
+	CHECK(ipv6_address::from_string("1:2:3:4:5:6:7::") == ipv6_address(0x0001000200030004, 0x0005000600070000));
+	CHECK(ipv6_address::from_string("::2:3:4:5:6:7:8") == ipv6_address(0x0000000200030004, 0x0005000600070008));
+	CHECK(ipv6_address::from_string("1::8") == ipv6_address(0x0001000000000000, 0x0000000000000008));
+
+	CHECK(ipv6_address::from_string(":") == std::nullopt);
+	CHECK(ipv6_address::from_string(":::") == std::nullopt);
+	CHECK(ipv6_address::from_string("1:::2") == std::nullopt);
+	CHECK(ipv6_address::from_string("1::2::3") == std::nullopt);
+	CHECK(ipv6_address::from_string("1:2:3:4::5:6:7:8") == std::nullopt);
+	CHECK(ipv6_address::from_string("1:2:3:4:5:6:7:8:9") == std::nullopt);
+	CHECK(ipv6_address::from_string("1:2:3:4:5:6:7:8::") == std::nullopt);
+	CHECK(ipv6_address::from_string("1:2:3:4:5:6:7:") == std::nullopt);
+	CHECK(ipv6_address::from_string("1:2:3:4:5:6:7:g") == std::nullopt);
 }
 
 TEST_CASE("from_string IPv4 interop format")
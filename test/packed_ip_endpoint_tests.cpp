@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/net/packed_ip_endpoint.hpp>
+
+#include <cstring>
+#include <unordered_set>
+
+#include "doctest/cppcoro_doctest.h"
+
+TEST_SUITE_BEGIN("packed_ip_endpoint");
+
+using namespace cppcoro::net;
+
+TEST_CASE("round-trips through ip_endpoint")
+{
+	const ip_endpoint endpoints[] = {
+		ip_endpoint{},
+		ipv4_endpoint{ ipv4_address{ 192, 168, 2, 254 }, 80 },
+		ipv4_endpoint{ ipv4_address{ 255, 255, 255, 255 }, 65535 },
+		ipv6_endpoint{ ipv6_address::loopback(), 443 },
+		ipv6_endpoint{ ipv6_address{ 0x20010db885a30000, 0x00008a2e03707334 }, 22 },
+		ipv6_endpoint{ *ipv6_address::from_string("::ffff:192.168.2.254"), 80 },
+	};
+
+	for (const auto& endpoint : endpoints)
+	{
+		const packed_ip_endpoint packed{ endpoint };
+		CHECK(packed.to_ip_endpoint() == endpoint);
+		CHECK(packed.is_ipv4() == endpoint.is_ipv4());
+		CHECK(packed.port() == endpoint.port());
+	}
+
+	CHECK(packed_ip_endpoint{}.to_ip_endpoint() == ip_endpoint{});
+}
+
+TEST_CASE("equality")
+{
+	const packed_ip_endpoint a{ ipv4_endpoint{ ipv4_address{ 10, 0, 0, 1 }, 80 } };
+	const packed_ip_endpoint b{ ipv4_endpoint{ ipv4_address{ 10, 0, 0, 1 }, 81 } };
+	const packed_ip_endpoint c{ ipv4_endpoint{ ipv4_address{ 10, 0, 0, 2 }, 80 } };
+
+	// An IPv4 end-point is distinct from the IPv6 end-point with the
+	// IPv4-mapped address.
+	const packed_ip_endpoint mapped{
+		ipv6_endpoint{ *ipv6_address::from_string("::ffff:10.0.0.1"), 80 } };
+
+	CHECK(a == packed_ip_endpoint{ ipv4_endpoint{ ipv4_address{ 10, 0, 0, 1 }, 80 } });
+	CHECK(a != b);
+	CHECK(a != c);
+	CHECK(a != mapped);
+
+	// There is no padding, so equal end-points have equal bytes.
+	const packed_ip_endpoint aCopy{ ip_endpoint{ ipv4_endpoint{ ipv4_address{ 10, 0, 0, 1 }, 80 } } };
+	CHECK(std::memcmp(&a, &aCopy, sizeof(a)) == 0);
+}
+
+TEST_CASE("hash matches std::hash of the unpacked end-point")
+{
+	const ip_endpoint v4 = ipv4_endpoint{ ipv4_address{ 192, 168, 2, 254 }, 80 };
+	const ip_endpoint v6 = ipv6_endpoint{ ipv6_address{ 0x20010db885a30000, 0x00008a2e03707334 }, 22 };
+
+	CHECK(packed_ip_endpoint{ v4 }.hash() == std::hash<ip_endpoint>{}(v4));
+	CHECK(packed_ip_endpoint{ v4 }.hash() == std::hash<ipv4_endpoint>{}(v4.to_ipv4()));
+	CHECK(packed_ip_endpoint{ v6 }.hash() == std::hash<ip_endpoint>{}(v6));
+	CHECK(packed_ip_endpoint{ v6 }.hash() == std::hash<ipv6_endpoint>{}(v6.to_ipv6()));
+	CHECK(std::hash<packed_ip_endpoint>{}(packed_ip_endpoint{ v6 }) == std::hash<ip_endpoint>{}(v6));
+
+	CHECK(packed_ip_endpoint{ v4 }.hash(12345) != packed_ip_endpoint{ v4 }.hash());
+}
+
+TEST_CASE("hash spreads similar end-points")
+{
+	// End-points that differ in only a few bits, as consecutive addresses and
+	// ports do, should still differ in their low bits, which is what an
+	// open-addressing table with a power-of-two size uses.
+	std::unordered_set<std::size_t> lowBits;
+	std::unordered_set<ip_endpoint> endpoints;
+	for (std::uint32_t i = 0; i < 4096; ++i)
+	{
+		const ip_endpoint endpoint =
+			(i % 2) == 0 ?
+			ip_endpoint{ ipv4_endpoint{ ipv4_address{ 0x0A000000u + (i >> 1) }, 443 } } :
+			ip_endpoint{ ipv6_endpoint{ ipv6_address{ 0x20010db800000000, i }, 443 } };
+		lowBits.insert(std::hash<ip_endpoint>{}(endpoint) & 0xFFFF);
+		endpoints.insert(endpoint);
+	}
+
+	// With 4096 random 16-bit values, about 120 collisions are expected.
+	CHECK(lowBits.size() > 3900);
+	CHECK(endpoints.size() == 4096);
+
+	std::unordered_set<std::size_t> portHashes;
+	for (std::uint32_t port = 0; port < 4096; ++port)
+	{
+		const ipv4_endpoint endpoint{ ipv4_address{ 10, 0, 0, 1 }, static_cast<std::uint16_t>(port) };
+		portHashes.insert(std::hash<ipv4_endpoint>{}(endpoint) & 0xFFFF);
+	}
+
+	CHECK(portHashes.size() > 3900);
+}
+
+TEST_SUITE_END();
@@ -14,10 +14,55 @@
 #include "io_service_fixture.hpp"
 
 #include <ostream>
+#include <thread>
 #include "doctest/cppcoro_doctest.h"
 
 TEST_SUITE_BEGIN("schedule/resume_on");
 
+namespace
+{
+	/// Like io_service_fixture, except that the I/O thread is only started once
+	/// the task returned by start_io_thread() runs.
+	///
+	/// Without symmetric transfer, task<T> attaches its continuation after the
+	/// awaiting coroutine has suspended, so a task that completes on another
+	/// thread before then resumes its continuation inline on the awaiting thread
+	/// instead (cppcoro issue #79). Passing start_io_thread() to when_all_ready()
+	/// after the task under test means nothing can complete on the I/O thread
+	/// until that task has suspended, so tests that check which thread they
+	/// resumed on don't depend on winning that race.
+	class deferred_io_thread_fixture
+	{
+	public:
+
+		~deferred_io_thread_fixture()
+		{
+			m_ioService.stop();
+			if (m_ioThread.joinable())
+			{
+				m_ioThread.join();
+			}
+		}
+
+		cppcoro::io_service& io_service() { return m_ioService; }
+
+		cppcoro::task<> start_io_thread()
+		{
+			if (!m_ioThread.joinable())
+			{
+				m_ioThread = std::thread{ [this] { m_ioService.process_events(); } };
+			}
+			co_return;
+		}
+
+	private:
+
+		cppcoro::io_service m_ioService;
+		std::thread m_ioThread;
+
+	};
+}
+
 TEST_CASE_FIXTURE(io_service_fixture, "schedule_on task<> function")
 {
 	auto mainThreadId = std::this_thread::get_id();
@@ -107,7 +152,7 @@ TEST_CASE_FIXTURE(io_service_fixture, "schedule_on async_generator<> function")
 	}()));
 }
 
-TEST_CASE_FIXTURE(io_service_fixture, "resume_on task<> function")
+TEST_CASE_FIXTURE(deferred_io_thread_fixture, "resume_on task<> function")
 {
 	auto mainThreadId = std::this_thread::get_id();
 
@@ -117,16 +162,16 @@ TEST_CASE_FIXTURE(io_service_fixture, "resume_on task<> function")
 		co_return;
 	};
 
-	cppcoro::sync_wait([&]() -> cppcoro::task<>
+	cppcoro::sync_wait(cppcoro::when_all_ready(
+		[&]() -> cppcoro::task<>
 	{
 		CHECK(std::this_thread::get_id() == mainThreadId);
 
 		co_await resume_on(io_service(), start());
 
-		// NOTE: This check could potentially spuriously fail with the current
-		// implementation of task<T>. See cppcoro issue #79.
 		CHECK(std::this_thread::get_id() != mainThreadId);
-	}());
+	}(),
+		start_io_thread()));
 }
 
 constexpr bool isMsvc15_4X86Optimised =
@@ -203,7 +248,7 @@ TEST_CASE_FIXTURE(io_service_fixture, "resume_on async_generator<> function"
 	}()));
 }
 
-TEST_CASE_FIXTURE(io_service_fixture, "schedule_on task<> pipe syntax")
+TEST_CASE_FIXTURE(deferred_io_thread_fixture, "schedule_on task<> pipe syntax")
 {
 	auto mainThreadId = std::this_thread::get_id();
 
@@ -219,15 +264,21 @@ TEST_CASE_FIXTURE(io_service_fixture, "schedule_on task<> pipe syntax")
 		return x * 3;
 	};
 
+	// When fmap() is applied after schedule_on() this relies on the continuation
+	// resuming on the thread that the task completed on, so run it before the
+	// I/O thread has started. See deferred_io_thread_fixture.
+	CHECK(std::get<0>(cppcoro::sync_wait(cppcoro::when_all_ready(
+		makeTask() | schedule_on(io_service()) | cppcoro::fmap(triple),
+		start_io_thread()))).result() == 369);
+
 	CHECK(cppcoro::sync_wait(makeTask() | schedule_on(io_service())) == 123);
 
 	// Shouldn't matter where in sequence schedule_on() appears since it applies
 	// at the start of the pipeline (ie. before first task starts).
-	CHECK(cppcoro::sync_wait(makeTask() | schedule_on(io_service()) | cppcoro::fmap(triple)) == 369);
 	CHECK(cppcoro::sync_wait(makeTask() | cppcoro::fmap(triple) | schedule_on(io_service())) == 369);
 }
 
-TEST_CASE_FIXTURE(io_service_fixture, "resume_on task<> pipe syntax")
+TEST_CASE_FIXTURE(deferred_io_thread_fixture, "resume_on task<> pipe syntax")
 {
 	auto mainThreadId = std::this_thread::get_id();
 
@@ -237,15 +288,17 @@ TEST_CASE_FIXTURE(io_service_fixture, "resume_on task<> pipe syntax")
 		co_return 123;
 	};
 
-	cppcoro::sync_wait([&]() -> cppcoro::task<>
+	cppcoro::sync_wait(cppcoro::when_all_ready(
+		[&]() -> cppcoro::task<>
 	{
 		cppcoro::task<int> t = makeTask() | cppcoro::resume_on(io_service());
 		CHECK(co_await t == 123);
 		CHECK(std::this_thread::get_id() != mainThreadId);
-	}());
+	}(),
+		start_io_thread()));
 }
 
-TEST_CASE_FIXTURE(io_service_fixture, "resume_on task<> pipe syntax multiple uses")
+TEST_CASE_FIXTURE(deferred_io_thread_fixture, "resume_on task<> pipe syntax multiple uses")
 {
 	auto mainThreadId = std::this_thread::get_id();
 
@@ -280,6 +333,7 @@ TEST_CASE_FIXTURE(io_service_fixture, "resume_on task<> pipe syntax multiple use
 
 		CHECK(std::this_thread::get_id() == mainThreadId);
 	}(),
+		start_io_thread(),
 		[&]() -> cppcoro::task<>
 	{
 		otherIoService.process_events();
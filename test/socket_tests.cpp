@@ -5,6 +5,8 @@
 
 #include <cppcoro/io_service.hpp>
 #include <cppcoro/net/socket.hpp>
+#include <cppcoro/read_only_file.hpp>
+#include <cppcoro/write_only_file.hpp>
 #include <cppcoro/task.hpp>
 #include <cppcoro/when_all.hpp>
 #include <cppcoro/sync_wait.hpp>
@@ -13,6 +15,13 @@
 #include <cppcoro/cancellation_token.hpp>
 #include <cppcoro/async_scope.hpp>
 
+#include <cstring>
+#include <random>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
 #include "doctest/cppcoro_doctest.h"
 
 using namespace cppcoro;
@@ -44,6 +53,59 @@ TEST_CASE("create UDP/IPv6")
 	auto socket = socket::create_udpv6(ioSvc);
 }
 
+TEST_CASE("socket options")
+{
+	io_service ioSvc;
+
+	auto tcpSocket = socket::create_tcpv4(ioSvc);
+
+	tcpSocket.set_tcp_no_delay(true);
+	CHECK(tcpSocket.tcp_no_delay());
+	tcpSocket.set_tcp_no_delay(false);
+	CHECK(!tcpSocket.tcp_no_delay());
+
+	tcpSocket.set_receive_buffer_size(64 * 1024);
+	CHECK(tcpSocket.receive_buffer_size() >= 64 * 1024);
+	tcpSocket.set_send_buffer_size(64 * 1024);
+	CHECK(tcpSocket.send_buffer_size() >= 64 * 1024);
+
+	// Performance hints never fail just because the platform lacks them.
+	tcpSocket.set_tcp_cork(false);
+	CHECK(!tcpSocket.tcp_cork());
+	tcpSocket.set_tcp_quick_ack(true);
+
+#if CPPCORO_OS_LINUX
+	tcpSocket.set_tcp_cork(true);
+	CHECK(tcpSocket.tcp_cork());
+
+	tcpSocket.set_reuse_port(true);
+	CHECK(tcpSocket.reuse_port());
+
+	tcpSocket.set_tcp_fast_open_connect(true);
+	CHECK(tcpSocket.tcp_fast_open_connect());
+
+	tcpSocket.set_incoming_cpu(0);
+
+	auto listeningSocket = socket::create_tcpv4(ioSvc);
+	listeningSocket.bind(ipv4_endpoint{ ipv4_address::loopback(), 0 });
+	listeningSocket.set_tcp_fast_open(16);
+	CHECK(listeningSocket.tcp_fast_open());
+	listeningSocket.set_tcp_fast_open(0);
+	CHECK(!listeningSocket.tcp_fast_open());
+
+	try
+	{
+		tcpSocket.set_busy_poll(std::chrono::microseconds{ 50 });
+		CHECK(tcpSocket.busy_poll() == std::chrono::microseconds{ 50 });
+	}
+	catch (const std::system_error& ex)
+	{
+		// Increasing the busy poll time needs CAP_NET_ADMIN.
+		CHECK(ex.code() == std::errc::operation_not_permitted);
+	}
+#endif
+}
+
 TEST_CASE("TCP/IPv4 connect/disconnect")
 {
 	io_service ioSvc;
@@ -210,6 +272,120 @@ TEST_CASE("send/recv TCP/IPv4")
 // HACK: Don't compile this function under MSVC x86.
 // It results in an ICE under VS 2017.15 and earlier.
 
+TEST_CASE("send_file TCP/IPv4")
+{
+	io_service ioSvc;
+
+	const auto filePath = cppcoro::filesystem::temp_directory_path() /
+		("cppcoro_send_file_" + std::to_string(std::random_device{}()));
+	auto removeOnExit = on_scope_exit([&]
+	{
+		std::error_code ec;
+		cppcoro::filesystem::remove(filePath, ec);
+	});
+
+	const std::size_t fileSize = 256 * 1024 + 123;
+	const std::uint64_t sendOffset = 100;
+
+	auto writeFile = [&]() -> task<int>
+	{
+		std::vector<std::uint8_t> contents(fileSize);
+		for (std::size_t i = 0; i < fileSize; ++i)
+		{
+			contents[i] = static_cast<std::uint8_t>('a' + (i % 26));
+		}
+
+		auto f = write_only_file::open(ioSvc, filePath);
+		f.set_size(fileSize);
+
+		std::size_t bytesWritten = 0;
+		while (bytesWritten < fileSize)
+		{
+			bytesWritten += co_await f.write(
+				bytesWritten, contents.data() + bytesWritten, fileSize - bytesWritten);
+		}
+
+		co_return 0;
+	};
+
+	auto listeningSocket = socket::create_tcpv4(ioSvc);
+
+	listeningSocket.bind(ipv4_endpoint{ ipv4_address::loopback(), 0 });
+	listeningSocket.listen(3);
+
+	auto server = [&]() -> task<int>
+	{
+		auto acceptingSocket = socket::create_tcpv4(ioSvc);
+
+		co_await listeningSocket.accept(acceptingSocket);
+
+		auto f = read_only_file::open(ioSvc, filePath);
+
+		std::uint64_t offset = sendOffset;
+		while (offset < fileSize)
+		{
+			const std::size_t bytesSent = co_await acceptingSocket.send_file(
+				f, offset, static_cast<std::size_t>(fileSize - offset));
+			REQUIRE(bytesSent > 0);
+			offset += bytesSent;
+		}
+
+		// Sending from the end of the file sends nothing.
+		CHECK(co_await acceptingSocket.send_file(f, fileSize, 10) == 0);
+
+		acceptingSocket.close_send();
+
+		co_await acceptingSocket.disconnect();
+
+		co_return 0;
+	};
+
+	auto client = [&]() -> task<int>
+	{
+		auto connectingSocket = socket::create_tcpv4(ioSvc);
+
+		connectingSocket.bind(ipv4_endpoint{});
+
+		co_await connectingSocket.connect(listeningSocket.local_endpoint());
+
+		std::uint8_t buffer[4096];
+		std::uint64_t totalBytesReceived = 0;
+		std::size_t bytesReceived;
+		do
+		{
+			bytesReceived = co_await connectingSocket.recv(buffer, sizeof(buffer));
+			for (std::size_t i = 0; i < bytesReceived; ++i)
+			{
+				std::uint64_t byteIndex = sendOffset + totalBytesReceived + i;
+				std::uint8_t expectedByte = 'a' + (byteIndex % 26);
+				CHECK(buffer[i] == expectedByte);
+			}
+
+			totalBytesReceived += bytesReceived;
+		} while (bytesReceived > 0);
+
+		CHECK(totalBytesReceived == fileSize - sendOffset);
+
+		co_await connectingSocket.disconnect();
+
+		co_return 0;
+	};
+
+	(void)sync_wait(when_all(
+		[&]() -> task<int>
+		{
+			auto stopOnExit = on_scope_exit([&] { ioSvc.stop(); });
+			(void)co_await writeFile();
+			(void)co_await when_all(client(), server());
+			co_return 0;
+		}(),
+		[&]() -> task<int>
+		{
+			ioSvc.process_events();
+			co_return 0;
+		}()));
+}
+
 TEST_CASE("send/recv TCP/IPv4 many connections")
 {
 	io_service ioSvc;
@@ -362,6 +538,214 @@ TEST_CASE("send/recv TCP/IPv4 many connections")
 		}()));
 }
 
+
+TEST_CASE("accept_stream TCP/IPv4")
+{
+	io_service ioSvc;
+
+	auto listeningSocket = socket::create_tcpv4(ioSvc);
+
+	listeningSocket.bind(ipv4_endpoint{ ipv4_address::loopback(), 0 });
+	listeningSocket.listen(20);
+
+	constexpr int connectionCount = 20;
+
+	auto handleConnection = [](socket s) -> task<void>
+	{
+		const std::uint8_t response[1] = { 42 };
+		co_await s.send(response, 1);
+		s.close_send();
+		co_await s.disconnect();
+	};
+
+	auto server = [&]() -> task<>
+	{
+		async_scope connectionScope;
+
+		int acceptedCount = 0;
+
+		{
+			// Stop consuming the stream once we've accepted all of the
+			// connections. Destroying the stream stops accepting.
+			auto connections = listeningSocket.accept_stream(ioSvc);
+			auto it = co_await connections.begin();
+			while (it != connections.end())
+			{
+				CHECK((*it).remote_endpoint().to_ipv4().address() == ipv4_address::loopback());
+				CHECK((*it).local_endpoint() == listeningSocket.local_endpoint());
+
+				connectionScope.spawn(handleConnection(std::move(*it)));
+				if (++acceptedCount == connectionCount)
+				{
+					break;
+				}
+
+				(void)co_await ++it;
+			}
+		}
+
+		co_await connectionScope.join();
+
+		CHECK(acceptedCount == connectionCount);
+	};
+
+	auto client = [&]() -> task<>
+	{
+		auto connectingSocket = socket::create_tcpv4(ioSvc);
+		connectingSocket.bind(ipv4_endpoint{});
+		co_await connectingSocket.connect(listeningSocket.local_endpoint());
+
+		std::uint8_t buffer[1] = { 0 };
+		CHECK(co_await connectingSocket.recv(buffer, 1) == 1);
+		CHECK(buffer[0] == 42);
+
+		co_await connectingSocket.disconnect();
+	};
+
+	auto clients = [&]() -> task<>
+	{
+		std::vector<task<>> clientTasks;
+		clientTasks.reserve(connectionCount);
+		for (int i = 0; i < connectionCount; ++i)
+		{
+			clientTasks.emplace_back(client());
+		}
+
+		co_await when_all(std::move(clientTasks));
+	};
+
+	(void)sync_wait(when_all(
+		[&]() -> task<>
+		{
+			auto stopOnExit = on_scope_exit([&] { ioSvc.stop(); });
+			(void)co_await when_all(server(), clients());
+		}(),
+		[&]() -> task<>
+		{
+			ioSvc.process_events();
+			co_return;
+		}()));
+}
+
+TEST_CASE("accept_stream with more connections than it queues")
+{
+	io_service ioSvc;
+
+	auto listeningSocket = socket::create_tcpv4(ioSvc);
+
+	listeningSocket.bind(ipv4_endpoint{ ipv4_address::loopback(), 0 });
+	listeningSocket.listen(128);
+
+	// More than accept_stream() queues, so that it has to stop accepting and
+	// start again once the consumer has caught up.
+	constexpr int backlogCount = 100;
+	constexpr int laterCount = 10;
+
+	std::vector<socket> clients;
+
+	auto connect = [&]() -> task<>
+	{
+		auto connectingSocket = socket::create_tcpv4(ioSvc);
+		connectingSocket.bind(ipv4_endpoint{});
+		co_await connectingSocket.connect(listeningSocket.local_endpoint());
+		clients.push_back(std::move(connectingSocket));
+	};
+
+	auto run = [&]() -> task<>
+	{
+		std::vector<socket> accepted;
+
+		co_await connect();
+
+		auto connections = listeningSocket.accept_stream(ioSvc);
+		auto it = co_await connections.begin();
+
+		// Make the rest of the connections without consuming any of them,
+		// so that they are accepted faster than they are consumed.
+		for (int i = 1; i < backlogCount; ++i)
+		{
+			co_await connect();
+		}
+
+		while (it != connections.end())
+		{
+			CHECK((*it).remote_endpoint().to_ipv4().address() == ipv4_address::loopback());
+			accepted.push_back(std::move(*it));
+			if (accepted.size() == backlogCount)
+			{
+				break;
+			}
+
+			(void)co_await ++it;
+		}
+
+		CHECK(accepted.size() == backlogCount);
+
+		// Connections made after the queue was drained are still accepted.
+		for (int i = 0; i < laterCount; ++i)
+		{
+			co_await connect();
+			(void)co_await ++it;
+			if (it == connections.end())
+			{
+				break;
+			}
+
+			accepted.push_back(std::move(*it));
+		}
+
+		CHECK(accepted.size() == backlogCount + laterCount);
+	};
+
+	(void)sync_wait(when_all(
+		[&]() -> task<>
+		{
+			auto stopOnExit = on_scope_exit([&] { ioSvc.stop(); });
+			co_await run();
+		}(),
+		[&]() -> task<>
+		{
+			ioSvc.process_events();
+			co_return;
+		}()));
+}
+
+TEST_CASE("accept_stream cancellation")
+{
+	io_service ioSvc;
+
+	auto listeningSocket = socket::create_tcpv4(ioSvc);
+
+	listeningSocket.bind(ipv4_endpoint{ ipv4_address::loopback(), 0 });
+	listeningSocket.listen();
+
+	cancellation_source canceller;
+
+	auto server = [&]() -> task<>
+	{
+		auto connections = listeningSocket.accept_stream(ioSvc, canceller.token());
+		CHECK_THROWS_AS(co_await connections.begin(), const operation_cancelled&);
+	};
+
+	auto cancelLater = [&]() -> task<>
+	{
+		co_await ioSvc.schedule();
+		canceller.request_cancellation();
+	};
+
+	(void)sync_wait(when_all(
+		[&]() -> task<>
+		{
+			auto stopOnExit = on_scope_exit([&] { ioSvc.stop(); });
+			(void)co_await when_all(server(), cancelLater());
+		}(),
+		[&]() -> task<>
+		{
+			ioSvc.process_events();
+			co_return;
+		}()));
+}
+
 #endif
 
 TEST_CASE("udp send_to/recv_from")
@@ -471,4 +855,455 @@ TEST_CASE("udp send_to/recv_from")
 		}()));
 }
 
+TEST_CASE("vectored send/recv TCP/IPv4")
+{
+	io_service ioSvc;
+
+	auto listeningSocket = socket::create_tcpv4(ioSvc);
+	listeningSocket.bind(ipv4_endpoint{ ipv4_address::loopback(), 0 });
+	listeningSocket.listen(3);
+
+	const char header[] = "HDR:";
+	const std::string body(1000, 'b');
+	const char trailer[] = ":END";
+
+	// Remove the first 'byteCount' bytes from a sequence of buffers.
+	auto consume = [](auto& buffers, std::size_t byteCount)
+	{
+		while (byteCount > 0 && byteCount >= buffers.front().size)
+		{
+			byteCount -= buffers.front().size;
+			buffers.erase(buffers.begin());
+		}
+
+		if (byteCount > 0)
+		{
+			using byte_pointer = std::conditional_t<
+				std::is_const_v<std::remove_pointer_t<decltype(buffers.front().buffer)>>,
+				const char*,
+				char*>;
+			buffers.front().buffer = static_cast<byte_pointer>(buffers.front().buffer) + byteCount;
+			buffers.front().size -= byteCount;
+		}
+	};
+
+	auto server = [&]() -> task<>
+	{
+		auto acceptingSocket = socket::create_tcpv4(ioSvc);
+		co_await listeningSocket.accept(acceptingSocket);
+
+		char receivedHeader[4];
+		std::string receivedBody(body.size(), '\0');
+		char receivedTrailer[4];
+		std::vector<mutable_buffer> buffers = {
+			{ receivedHeader, sizeof(receivedHeader) },
+			{ receivedBody.data(), receivedBody.size() },
+			{ receivedTrailer, sizeof(receivedTrailer) },
+		};
+
+		while (!buffers.empty())
+		{
+			const std::size_t bytesReceived = co_await acceptingSocket.recv(buffers);
+			REQUIRE(bytesReceived > 0);
+			consume(buffers, bytesReceived);
+		}
+
+		CHECK(std::memcmp(receivedHeader, header, 4) == 0);
+		CHECK(receivedBody == body);
+		CHECK(std::memcmp(receivedTrailer, trailer, 4) == 0);
+
+		char extra;
+		CHECK(co_await acceptingSocket.recv(&extra, 1) == 0);
+
+		acceptingSocket.close_send();
+		co_await acceptingSocket.disconnect();
+	};
+
+	auto client = [&]() -> task<>
+	{
+		auto connectingSocket = socket::create_tcpv4(ioSvc);
+		connectingSocket.bind(ipv4_endpoint{});
+		co_await connectingSocket.connect(listeningSocket.local_endpoint());
+
+		std::vector<const_buffer> buffers = {
+			{ header, 4 },
+			{ body.data(), body.size() },
+			{ trailer, 4 },
+		};
+
+		while (!buffers.empty())
+		{
+			const std::size_t bytesSent = co_await connectingSocket.send(buffers);
+			REQUIRE(bytesSent > 0);
+			consume(buffers, bytesSent);
+		}
+
+		connectingSocket.close_send();
+		co_await connectingSocket.disconnect();
+	};
+
+	(void)sync_wait(when_all(
+		[&]() -> task<>
+		{
+			auto stopOnExit = on_scope_exit([&] { ioSvc.stop(); });
+			(void)co_await when_all(client(), server());
+		}(),
+		[&]() -> task<>
+		{
+			ioSvc.process_events();
+			co_return;
+		}()));
+}
+
+#if CPPCORO_OS_LINUX
+TEST_CASE("udp send_to_many/recv_from_many")
+{
+	io_service ioSvc;
+
+	// More than the operations hold inline so that the first batches need to
+	// allocate their headers.
+	constexpr std::size_t datagramCount = 20;
+
+	auto serverSocket = socket::create_udpv4(ioSvc);
+	serverSocket.bind(ipv4_endpoint{ ipv4_address::loopback(), 0 });
+
+	auto clientSocket = socket::create_udpv4(ioSvc);
+	clientSocket.bind(ipv4_endpoint{ ipv4_address::loopback(), 0 });
+
+	auto server = [&]() -> task<>
+	{
+		std::uint8_t storage[datagramCount * 2][100];
+		datagram_buffer buffers[datagramCount * 2];
+		for (std::size_t i = 0; i < std::size(buffers); ++i)
+		{
+			buffers[i].buffer = storage[i];
+			buffers[i].size = sizeof(storage[i]);
+		}
+
+		// The datagrams may not all have arrived by the time the first
+		// batch is received.
+		std::size_t receivedCount = 0;
+		while (receivedCount < datagramCount)
+		{
+			auto remaining = std::span{ buffers }.subspan(receivedCount);
+			receivedCount += co_await serverSocket.recv_from_many(remaining);
+		}
+
+		CHECK(receivedCount == datagramCount);
+
+		for (std::size_t i = 0; i < datagramCount; ++i)
+		{
+			CHECK(buffers[i].source == clientSocket.local_endpoint());
+
+			// The last datagram is larger than the buffer.
+			const bool isLast = i == datagramCount - 1;
+			CHECK(buffers[i].truncated == isLast);
+			CHECK(buffers[i].bytesReceived == (isLast ? 100 : i + 1));
+			CHECK(storage[i][0] == i);
+		}
+
+		// Acknowledge the whole batch in one go.
+		const std::uint8_t ack[1] = { 0xAC };
+		datagram acks[2] = {
+			{ clientSocket.local_endpoint(), ack, 1 },
+			{ clientSocket.local_endpoint(), ack, 1 },
+		};
+		CHECK(co_await serverSocket.send_to_many(acks) == 2);
+	};
+
+	auto client = [&]() -> task<>
+	{
+		std::uint8_t storage[datagramCount][200];
+		datagram datagrams[datagramCount];
+		for (std::size_t i = 0; i < datagramCount; ++i)
+		{
+			std::memset(storage[i], static_cast<int>(i), sizeof(storage[i]));
+			datagrams[i].destination = serverSocket.local_endpoint();
+			datagrams[i].buffer = storage[i];
+			datagrams[i].size = i == datagramCount - 1 ? 200 : i + 1;
+		}
+
+		std::size_t sentCount = 0;
+		while (sentCount < datagramCount)
+		{
+			auto remaining = std::span<const datagram>{ datagrams }.subspan(sentCount);
+			sentCount += co_await clientSocket.send_to_many(remaining);
+		}
+
+		std::uint8_t ackStorage[2][1];
+		datagram_buffer ackBuffers[2];
+		for (std::size_t i = 0; i < std::size(ackBuffers); ++i)
+		{
+			ackBuffers[i].buffer = ackStorage[i];
+			ackBuffers[i].size = sizeof(ackStorage[i]);
+		}
+
+		std::size_t ackCount = 0;
+		while (ackCount < 2)
+		{
+			ackCount += co_await clientSocket.recv_from_many(std::span{ ackBuffers }.subspan(ackCount));
+		}
+
+		CHECK(ackStorage[0][0] == 0xAC);
+		CHECK(ackStorage[1][0] == 0xAC);
+		CHECK(ackBuffers[1].source == serverSocket.local_endpoint());
+
+		// An empty batch completes immediately.
+		CHECK(co_await clientSocket.recv_from_many(std::span<datagram_buffer>{}) == 0);
+	};
+
+	(void)sync_wait(when_all(
+		[&]() -> task<>
+		{
+			auto stopOnExit = on_scope_exit([&] { ioSvc.stop(); });
+			(void)co_await when_all(server(), client());
+		}(),
+		[&]() -> task<>
+		{
+			ioSvc.process_events();
+			co_return;
+		}()));
+}
+
+TEST_CASE("udp send_to_segmented/recv_from_segmented")
+{
+	io_service ioSvc;
+
+	constexpr std::uint16_t segmentSize = 1000;
+	constexpr std::size_t segmentCount = 3;
+
+	auto receiverSocket = socket::create_udpv4(ioSvc);
+	receiverSocket.bind(ipv4_endpoint{ ipv4_address::loopback(), 0 });
+
+	auto senderSocket = socket::create_udpv4(ioSvc);
+	senderSocket.bind(ipv4_endpoint{ ipv4_address::loopback(), 0 });
+
+	std::vector<std::uint8_t> data(segmentSize * segmentCount);
+	for (std::size_t i = 0; i < data.size(); ++i)
+	{
+		data[i] = static_cast<std::uint8_t>(i / segmentSize);
+	}
+
+	auto receiveAll = [&]() -> task<>
+	{
+		std::vector<std::uint8_t> received;
+		std::uint8_t buffer[segmentSize * segmentCount];
+		while (received.size() < data.size())
+		{
+			auto [bytesReceived, source, receivedSegmentSize] =
+				co_await receiverSocket.recv_from_segmented(buffer, sizeof(buffer));
+			CHECK(source == senderSocket.local_endpoint());
+			CHECK(receivedSegmentSize == segmentSize);
+			CHECK(bytesReceived % segmentSize == 0);
+			received.insert(received.end(), buffer, buffer + bytesReceived);
+		}
+
+		CHECK(received == data);
+	};
+
+	auto run = [&]() -> task<>
+	{
+		// Without GRO each segment is received as a separate datagram.
+		const std::size_t bytesSent = co_await senderSocket.send_to_segmented(
+			receiverSocket.local_endpoint(), data.data(), data.size(), segmentSize);
+		CHECK(bytesSent == data.size());
+
+		for (std::size_t i = 0; i < segmentCount; ++i)
+		{
+			std::uint8_t buffer[segmentSize * segmentCount];
+			auto [bytesReceived, source] = co_await receiverSocket.recv_from(buffer, sizeof(buffer));
+			CHECK(bytesReceived == segmentSize);
+			CHECK(buffer[0] == i);
+		}
+
+		// With GRO the segments may be received together.
+		receiverSocket.set_udp_gro(true);
+
+		(void)co_await senderSocket.send_to_segmented(
+			receiverSocket.local_endpoint(), data.data(), data.size(), segmentSize);
+		co_await receiveAll();
+	};
+
+	(void)sync_wait(when_all(
+		[&]() -> task<>
+		{
+			auto stopOnExit = on_scope_exit([&] { ioSvc.stop(); });
+			co_await run();
+		}(),
+		[&]() -> task<>
+		{
+			ioSvc.process_events();
+			co_return;
+		}()));
+}
+
+TEST_CASE("udp recv_from_many cancellation")
+{
+	io_service ioSvc;
+
+	auto udpSocket = socket::create_udpv4(ioSvc);
+	udpSocket.bind(ipv4_endpoint{ ipv4_address::loopback(), 0 });
+
+	cancellation_source canceller;
+
+	auto receive = [&]() -> task<>
+	{
+		std::uint8_t storage[100];
+		datagram_buffer buffers[1];
+		buffers[0].buffer = storage;
+		buffers[0].size = sizeof(storage);
+		CHECK_THROWS_AS(
+			co_await udpSocket.recv_from_many(buffers, canceller.token()),
+			const operation_cancelled&);
+	};
+
+	auto cancelLater = [&]() -> task<>
+	{
+		co_await ioSvc.schedule();
+		canceller.request_cancellation();
+	};
+
+	(void)sync_wait(when_all(
+		[&]() -> task<>
+		{
+			auto stopOnExit = on_scope_exit([&] { ioSvc.stop(); });
+			(void)co_await when_all(receive(), cancelLater());
+		}(),
+		[&]() -> task<>
+		{
+			ioSvc.process_events();
+			co_return;
+		}()));
+}
+
+TEST_CASE("udp recv into recv_buffer_pool")
+{
+	io_service ioSvc;
+
+	recv_buffer_pool pool{ ioSvc, 2, 64 };
+
+	auto receiverSocket = socket::create_udpv4(ioSvc);
+	receiverSocket.bind(ipv4_endpoint{ ipv4_address::loopback(), 0 });
+
+	auto senderSocket = socket::create_udpv4(ioSvc);
+	senderSocket.bind(ipv4_endpoint{ ipv4_address::loopback(), 0 });
+
+	auto run = [&]() -> task<>
+	{
+		const std::string messages[] = { "one", "two", "three" };
+		for (const auto& message : messages)
+		{
+			(void)co_await senderSocket.send_to(
+				receiverSocket.local_endpoint(), message.data(), message.size());
+		}
+
+		auto first = co_await receiverSocket.recv(pool);
+		REQUIRE(first.size() == 3);
+		CHECK(std::memcmp(first.data(), "one", 3) == 0);
+
+		auto second = co_await receiverSocket.recv(pool);
+		REQUIRE(second.size() == 3);
+		CHECK(std::memcmp(second.data(), "two", 3) == 0);
+		CHECK(second.data() != first.data());
+
+		// Both buffers are leased so there's nowhere to put the last datagram.
+		try
+		{
+			(void)co_await receiverSocket.recv(pool);
+			FAIL("recv() should have failed");
+		}
+		catch (const std::system_error& ex)
+		{
+			CHECK(ex.code() == std::errc::no_buffer_space);
+		}
+
+		const std::byte* firstBuffer = first.data();
+		first.release();
+		CHECK(first.data() == nullptr);
+		CHECK(first.size() == 0);
+
+		auto third = co_await receiverSocket.recv(pool);
+		REQUIRE(third.size() == 5);
+		CHECK(third.data() == firstBuffer);
+		CHECK(std::memcmp(third.data(), "three", 5) == 0);
+	};
+
+	(void)sync_wait(when_all(
+		[&]() -> task<>
+		{
+			auto stopOnExit = on_scope_exit([&] { ioSvc.stop(); });
+			co_await run();
+		}(),
+		[&]() -> task<>
+		{
+			ioSvc.process_events();
+			co_return;
+		}()));
+}
+
+TEST_CASE("send_zero_copy TCP/IPv4")
+{
+	io_service ioSvc;
+
+	auto listeningSocket = socket::create_tcpv4(ioSvc);
+	listeningSocket.bind(ipv4_endpoint{ ipv4_address::loopback(), 0 });
+	listeningSocket.listen(3);
+
+	std::vector<std::uint8_t> data(1024 * 1024);
+	for (std::size_t i = 0; i < data.size(); ++i)
+	{
+		data[i] = static_cast<std::uint8_t>(i * 7);
+	}
+
+	auto server = [&]() -> task<>
+	{
+		auto acceptingSocket = socket::create_tcpv4(ioSvc);
+		co_await listeningSocket.accept(acceptingSocket);
+
+		std::vector<std::uint8_t> received;
+		std::uint8_t buffer[16384];
+		std::size_t bytesReceived;
+		do
+		{
+			bytesReceived = co_await acceptingSocket.recv(buffer, sizeof(buffer));
+			received.insert(received.end(), buffer, buffer + bytesReceived);
+		} while (bytesReceived > 0);
+
+		CHECK(received == data);
+
+		acceptingSocket.close_send();
+		co_await acceptingSocket.disconnect();
+	};
+
+	auto client = [&]() -> task<>
+	{
+		auto connectingSocket = socket::create_tcpv4(ioSvc);
+		connectingSocket.bind(ipv4_endpoint{});
+		co_await connectingSocket.connect(listeningSocket.local_endpoint());
+
+		std::size_t bytesSent = 0;
+		while (bytesSent < data.size())
+		{
+			bytesSent += co_await connectingSocket.send_zero_copy(
+				data.data() + bytesSent, data.size() - bytesSent);
+		}
+
+		connectingSocket.close_send();
+		co_await connectingSocket.disconnect();
+	};
+
+	(void)sync_wait(when_all(
+		[&]() -> task<>
+		{
+			auto stopOnExit = on_scope_exit([&] { ioSvc.stop(); });
+			(void)co_await when_all(client(), server());
+		}(),
+		[&]() -> task<>
+		{
+			ioSvc.process_events();
+			co_return;
+		}()));
+}
+#endif
+
 TEST_SUITE_END();
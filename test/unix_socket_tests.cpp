@@ -0,0 +1,265 @@
+///////////////////////////////////////////////////////////////////////////////
+// Copyright (c) Lewis Baker
+// Licenced under MIT license. See LICENSE.txt for details.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cppcoro/io_service.hpp>
+#include <cppcoro/net/socket.hpp>
+#include <cppcoro/net/unix_endpoint.hpp>
+#include <cppcoro/on_scope_exit.hpp>
+#include <cppcoro/sync_wait.hpp>
+#include <cppcoro/task.hpp>
+#include <cppcoro/when_all.hpp>
+
+#include <cstring>
+#include <functional>
+#include <string>
+#include <system_error>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <ostream>
+#include "doctest/cppcoro_doctest.h"
+
+using namespace cppcoro;
+using namespace cppcoro::net;
+
+TEST_SUITE_BEGIN("unix_socket");
+
+namespace
+{
+	/// A name in the abstract namespace that is unique to this process, so
+	/// that tests running concurrently don't collide.
+	unix_endpoint unique_endpoint(const char* name)
+	{
+		return unix_endpoint::abstract(
+			std::string("cppcoro-test-") + std::to_string(::getpid()) + "-" + name);
+	}
+
+	/// Run \a body while another task processes events on \a ioSvc.
+	void run(io_service& ioSvc, std::function<task<>()> body)
+	{
+		(void)sync_wait(when_all(
+			[&]() -> task<>
+			{
+				auto stopOnExit = on_scope_exit([&] { ioSvc.stop(); });
+				co_await body();
+			}(),
+			[&]() -> task<>
+			{
+				ioSvc.process_events();
+				co_return;
+			}()));
+	}
+}
+
+TEST_CASE("unix_endpoint")
+{
+	unix_endpoint unnamed;
+	CHECK(unnamed.is_unnamed());
+	CHECK(!unnamed.is_abstract());
+
+	unix_endpoint path{ "/tmp/cppcoro.sock" };
+	CHECK(!path.is_unnamed());
+	CHECK(!path.is_abstract());
+	CHECK(path.to_string() == "/tmp/cppcoro.sock");
+
+	auto abstract = unix_endpoint::abstract("cppcoro");
+	CHECK(abstract.is_abstract());
+	CHECK(abstract.path() == std::string("\0cppcoro", 8));
+	CHECK(abstract.to_string() == "@cppcoro");
+
+	CHECK(abstract != path);
+	CHECK(abstract == unix_endpoint::abstract("cppcoro"));
+}
+
+TEST_CASE("Unix stream socket connect/send/recv")
+{
+	io_service ioSvc;
+
+	const auto endPoint = unique_endpoint("stream");
+
+	auto listeningSocket = socket::create_unix_stream(ioSvc);
+	listeningSocket.bind(endPoint);
+	listeningSocket.listen(1);
+	CHECK(listeningSocket.local_unix_endpoint() == endPoint);
+
+	run(ioSvc, [&]() -> task<>
+	{
+		auto server = [&]() -> task<>
+		{
+			auto s = socket::create_unix_stream(ioSvc);
+			co_await listeningSocket.accept(s);
+
+			char buffer[16];
+			const std::size_t bytesReceived = co_await s.recv(buffer, sizeof(buffer));
+			co_await s.send(buffer, bytesReceived);
+			s.close_send();
+		};
+
+		auto client = [&]() -> task<>
+		{
+			auto s = socket::create_unix_stream(ioSvc);
+			co_await s.connect(endPoint);
+			CHECK(s.remote_unix_endpoint() == endPoint);
+			CHECK(s.local_unix_endpoint().is_unnamed());
+
+			co_await s.send("hello", 5);
+			s.close_send();
+
+			std::string received;
+			char buffer[16];
+			while (std::size_t bytesReceived = co_await s.recv(buffer, sizeof(buffer)))
+			{
+				received.append(buffer, bytesReceived);
+			}
+			CHECK(received == "hello");
+		};
+
+		(void)co_await when_all(server(), client());
+	});
+}
+
+TEST_CASE("Unix seqpacket socket preserves message boundaries")
+{
+	io_service ioSvc;
+
+	const auto endPoint = unique_endpoint("seqpacket");
+
+	auto listeningSocket = socket::create_unix_seqpacket(ioSvc);
+	listeningSocket.bind(endPoint);
+	listeningSocket.listen(1);
+
+	run(ioSvc, [&]() -> task<>
+	{
+		auto server = [&]() -> task<>
+		{
+			auto s = socket::create_unix_seqpacket(ioSvc);
+			co_await listeningSocket.accept(s);
+			co_await s.send("ab", 2);
+			co_await s.send("cde", 3);
+		};
+
+		auto client = [&]() -> task<>
+		{
+			auto s = socket::create_unix_seqpacket(ioSvc);
+			co_await s.connect(endPoint);
+
+			char buffer[16];
+			CHECK(co_await s.recv(buffer, sizeof(buffer)) == 2);
+			CHECK(co_await s.recv(buffer, sizeof(buffer)) == 3);
+			CHECK(std::memcmp(buffer, "cde", 3) == 0);
+		};
+
+		(void)co_await when_all(server(), client());
+	});
+}
+
+TEST_CASE("Unix datagram socket send/recv")
+{
+	io_service ioSvc;
+
+	const auto receiverEndPoint = unique_endpoint("datagram");
+
+	auto receiver = socket::create_unix_datagram(ioSvc);
+	receiver.bind(receiverEndPoint);
+
+	// Binding to an unnamed end-point picks a unique abstract name.
+	auto sender = socket::create_unix_datagram(ioSvc);
+	sender.bind(unix_endpoint{});
+	CHECK(sender.local_unix_endpoint().is_abstract());
+
+	run(ioSvc, [&]() -> task<>
+	{
+		co_await sender.connect(receiverEndPoint);
+		CHECK(co_await sender.send("ping", 4) == 4);
+
+		char buffer[16];
+		CHECK(co_await receiver.recv(buffer, sizeof(buffer)) == 4);
+		CHECK(std::memcmp(buffer, "ping", 4) == 0);
+	});
+}
+
+TEST_CASE("bind to a path that is too long fails")
+{
+	io_service ioSvc;
+	auto s = socket::create_unix_stream(ioSvc);
+
+	try
+	{
+		s.bind(unix_endpoint{ "/tmp/" + std::string(unix_endpoint::max_path_length, 'x') });
+		FAIL("expected bind() to throw");
+	}
+	catch (const std::system_error& ex)
+	{
+		CHECK(ex.code() == std::errc::filename_too_long);
+	}
+}
+
+TEST_CASE("send_fds/recv_fds pass a memfd between sockets")
+{
+	io_service ioSvc;
+
+	const auto endPoint = unique_endpoint("fds");
+
+	auto listeningSocket = socket::create_unix_stream(ioSvc);
+	listeningSocket.bind(endPoint);
+	listeningSocket.listen(1);
+
+	const int memfd = ::memfd_create("cppcoro-test", MFD_CLOEXEC);
+	REQUIRE(memfd != -1);
+	auto closeOnExit = on_scope_exit([&] { ::close(memfd); });
+
+	const std::string contents = "shared memory contents";
+	REQUIRE(::write(memfd, contents.data(), contents.size()) == (ssize_t)contents.size());
+
+	run(ioSvc, [&]() -> task<>
+	{
+		auto server = [&]() -> task<>
+		{
+			auto s = socket::create_unix_stream(ioSvc);
+			co_await listeningSocket.accept(s);
+
+			const int fds[] = { memfd };
+			CHECK(co_await s.send_fds("m", 1, fds) == 1);
+
+			const int twoFds[] = { memfd, memfd };
+			CHECK(co_await s.send_fds("n", 1, twoFds) == 1);
+		};
+
+		auto client = [&]() -> task<>
+		{
+			auto s = socket::create_unix_stream(ioSvc);
+			co_await s.connect(endPoint);
+
+			char buffer[16];
+			int fds[4];
+			auto [bytesReceived, fdCount] = co_await s.recv_fds(buffer, sizeof(buffer), fds);
+			CHECK(bytesReceived == 1);
+			CHECK(buffer[0] == 'm');
+			REQUIRE(fdCount == 1);
+			CHECK(fds[0] != memfd);
+
+			std::string received(contents.size(), '\0');
+			CHECK(::pread(fds[0], received.data(), received.size(), 0) == (ssize_t)contents.size());
+			CHECK(received == contents);
+			::close(fds[0]);
+
+			// More descriptors sent than there is room for.
+			try
+			{
+				(void)co_await s.recv_fds(buffer, sizeof(buffer), std::span<int>{ fds, 1 });
+				FAIL("expected recv_fds() to throw");
+			}
+			catch (const std::system_error& ex)
+			{
+				CHECK(ex.code() == std::errc::message_size);
+			}
+		};
+
+		(void)co_await when_all(server(), client());
+	});
+}
+
+TEST_SUITE_END();